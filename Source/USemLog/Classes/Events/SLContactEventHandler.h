@@ -58,11 +58,11 @@ private:
 	// Parent semantic overlap area
 	class ISLContactMonitorInterface* Parent = nullptr;
 
-	// Array of started contact events
-	TArray<TSharedPtr<FSLContactEvent>> StartedContactEvents;
+	// Started contact events, keyed by the unique id of the other individual (the parent is the same for all)
+	TMap<uint64, TSharedPtr<FSLContactEvent>> StartedContactEvents;
 
-	// Array of started supported by events
-	TArray<TSharedPtr<FSLSupportedByEvent>> StartedSupportedByEvents;
+	// Started supported by events, keyed by their pair id
+	TMap<uint64, TSharedPtr<FSLSupportedByEvent>> StartedSupportedByEvents;
 	
 	/* Constant values */
 	constexpr static float ContactEventMin = 0.3f;
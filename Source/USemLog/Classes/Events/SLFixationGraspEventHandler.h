@@ -49,6 +49,6 @@ private:
 	USLBaseIndividual* Parent;
 #endif // SL_WITH_MC_GRASP
 
-	// Array of started events
-	TArray<TSharedPtr<FSLGraspEvent>> StartedEvents;
+	// Started events, keyed by the unique id of the other individual (the parent is the same for all)
+	TMap<uint64, TSharedPtr<FSLGraspEvent>> StartedEvents;
 };
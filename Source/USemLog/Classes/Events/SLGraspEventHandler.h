@@ -41,8 +41,8 @@ private:
 	// Parent
 	class USLManipulatorMonitor* Parent;
 
-	// Array of started events
-	TArray<TSharedPtr<FSLGraspEvent>> StartedEvents;
+	// Started events, keyed by the unique id of the other individual (the parent is the same for all)
+	TMap<uint64, TSharedPtr<FSLGraspEvent>> StartedEvents;
 	
 	/* Constant values */
 	constexpr static float GraspEventMin = 0.25f;
@@ -47,6 +47,6 @@ private:
 	// Parent semantic overlap area
 	class USLManipulatorMonitor* Parent = nullptr;
 
-	// Array of started contact events
-	TArray<TSharedPtr<FSLContactEvent>> StartedEvents;
+	// Started events, keyed by the unique id of the other individual (the parent is the same for all)
+	TMap<uint64, TSharedPtr<FSLContactEvent>> StartedEvents;
 };
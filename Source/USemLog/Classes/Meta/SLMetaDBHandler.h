@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "Meta/SLMetaScannerStructs.h"
+#include "Mongo/SLGridFsUploader.h"
 
 #if SL_WITH_LIBMONGO_C
 class ASLVisionPoseableMeshActor;
@@ -31,8 +32,12 @@ public:
 	// Connect to the database
 	bool Connect(const FString& DBName, const FString& ServerIp, uint16 ServerPort, bool bRemovePrevEntries, bool bScanItems);
 
-	// Disconnect and clean db connection
-	void Disconnect() const;
+	// Disconnect and clean db connection (pending image uploads are finished first)
+	void Disconnect();
+
+	// Block until all the queued image uploads are written and write the scan entries referencing them,
+	// return false on timeout (the entries stay pending) or if entries were skipped because of failed uploads
+	bool FlushUploads();
 
 	// Create indexes on the inserted data
 	void CreateIndexes() const;
@@ -51,8 +56,14 @@ public:
 
 private:
 #if SL_WITH_LIBMONGO_C
-	// Add image to gridfs, output the oid
-	void AddToGridFs(const TArray<uint8>& CompressedBitmap, bson_oid_t* out_oid);
+	// Add image to gridfs (queued if the uploader is running), output the oid,
+	// the optional entry counter is decremented once the queued image is processed
+	void AddToGridFs(const TArray<uint8>& CompressedBitmap, bson_oid_t* out_oid,
+		const TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe>& NumEntryPendingFiles = nullptr);
+
+	// Write the scan entries waiting for their image uploads (only the ones with all images processed if only uploaded),
+	// skip the ones referencing failed uploads, return false if any entry was skipped
+	bool WritePendingScanEntries(bool bOnlyUploaded);
 
 	// Write the task description
 	void AddTaskDescription(const FString& InTaskDescription, bson_t* doc);
@@ -74,6 +85,9 @@ private:
 	// Total number of pixels in the current image
 	int64 TotalNumPixels;
 
+	// Uploads the scan images in the background
+	FSLGridFsUploader Uploader;
+
 #if SL_WITH_LIBMONGO_C
 	// Server uri
 	mongoc_uri_t* uri;
@@ -101,5 +115,14 @@ private:
 
 	// Image scan array doc index
 	uint32_t scan_pose_arr_idx;
+
+	// Ids of the image files referenced by the current scan entry
+	TArray<bson_oid_t> ScanFileOids;
+
+	// Number of not yet uploaded images of the current scan entry
+	TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe> ScanNumPendingFiles;
+
+	// Scan entries written once their images are uploaded
+	TArray<FSLGridFsPendingDoc> PendingScanEntryDocs;
 #endif //SL_WITH_LIBMONGO_C
 };
@@ -112,7 +112,7 @@ private:
 	void QuitEditor();
 
 	// Save the compressed screenshot image locally
-	void SaveImageLocally(const TArray<uint8>& CompressedBitmap);
+	void SaveImageLocally(const TArray<uint8>& CompressedBitmap, ESLImageCodec Codec);
 
 	// Print progress
 	void PrintProgress() const;
@@ -181,6 +181,9 @@ private:
 	
 	// View modes (lit/unlit/mask etc.)
 	TArray<ESLMetaScannerViewMode> ViewModes;
+
+	// Image encoding per view mode (PNG if not set)
+	TMap<ESLMetaScannerViewMode, ESLImageCodec> ViewModeCodecs;
 	
 	// Currently active view mode
 	int32 CurrViewModeIdx;
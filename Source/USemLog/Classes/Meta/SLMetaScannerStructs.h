@@ -4,6 +4,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Utils/SLImageCodec.h"
 
 /**
 * View modes
@@ -43,6 +44,9 @@ struct FSLMetaScannerParams
 	// Save the scanned images locally
 	bool bIncludeScansLocally;
 
+	// Image encoding per view mode (PNG if not set)
+	TMap<ESLMetaScannerViewMode, ESLImageCodec> ViewModeCodecs;
+
 	// Default constructor
 	FSLMetaScannerParams() {};
 
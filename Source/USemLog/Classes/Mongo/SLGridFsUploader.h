@@ -0,0 +1,206 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+#if SL_WITH_LIBMONGO_C
+THIRD_PARTY_INCLUDES_START
+#if PLATFORM_WINDOWS
+	#include "Windows/AllowWindowsPlatformTypes.h"
+	#include <mongoc/mongoc.h>
+	#include "Windows/HideWindowsPlatformTypes.h"
+#else
+	#include <mongoc/mongoc.h>
+#endif // #if PLATFORM_WINDOWS
+THIRD_PARTY_INCLUDES_END
+#endif //SL_WITH_LIBMONGO_C
+
+// Forward declarations
+class FRunnableThread;
+class FSLGridFsUploadWorker;
+
+/**
+* Binary waiting to be uploaded, the file id is generated before the upload
+*/
+struct FSLGridFsUploadJob
+{
+#if SL_WITH_LIBMONGO_C
+	// Id of the gridfs file
+	bson_oid_t Oid;
+#endif //SL_WITH_LIBMONGO_C
+
+	// File content
+	TArray<uint8> Data;
+
+	// Number of not yet uploaded files of the document referencing this file (optional)
+	TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe> NumDocPendingFiles;
+};
+
+#if SL_WITH_LIBMONGO_C
+/**
+* Document referencing queued gridfs files, written only after all its files are uploaded
+*/
+struct FSLGridFsPendingDoc
+{
+	// Document to write
+	bson_t* Doc;
+
+	// Ids of the referenced gridfs files
+	TArray<bson_oid_t> FileOids;
+
+	// Number of referenced files which are not yet uploaded (decremented by the upload workers)
+	TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe> NumPendingFiles;
+
+	// Check if all the referenced files are processed by the upload workers (uploaded or failed)
+	bool IsUploaded() const { return !NumPendingFiles.IsValid() || NumPendingFiles->GetValue() == 0; };
+};
+#endif //SL_WITH_LIBMONGO_C
+
+/**
+ * Uploads binaries to gridfs in the background using a pool of connections,
+ * small files are inserted in batches directly as gridfs files and chunks documents
+ */
+class FSLGridFsUploader
+{
+	friend class FSLGridFsUploadWorker;
+
+public:
+	// Ctor
+	FSLGridFsUploader();
+
+	// Dtor
+	~FSLGridFsUploader();
+
+	// Start the upload workers, each with its own connection from the pool,
+	// enqueueing blocks while the pending uploads exceed the max number of files or bytes
+	bool Start(const FString& Uri, const FString& DBName, const FString& Prefix,
+		int32 NumWorkers = 4, int32 MaxBatchSize = 16, bool bBatchSmallFiles = true,
+		int32 MaxNumPending = DefaultMaxNumPending, int64 MaxPendingBytes = DefaultMaxPendingBytes);
+
+	// Check if the workers are running
+	bool IsRunning() const { return Workers.Num() > 0; };
+
+#if SL_WITH_LIBMONGO_C
+	// Queue the binary for upload, the file id is set right away (can be referenced before the upload finished),
+	// the optional document counter is incremented until the file is processed,
+	// blocks until the workers catch up if the pending uploads budget is exceeded
+	void Enqueue(const TArray<uint8>& Data, bson_oid_t* out_oid,
+		const TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe>& NumDocPendingFiles = nullptr);
+#endif //SL_WITH_LIBMONGO_C
+
+	// Block until all queued binaries are uploaded, return false on timeout
+	bool Flush(float Timeout = DefaultFlushTimeout);
+
+	// Flush and stop the workers
+	void Stop();
+
+	// Get the number of binaries which are not yet uploaded
+	int32 GetNumPending() const { return NumPending.GetValue(); };
+
+#if SL_WITH_LIBMONGO_C
+	// Check if the upload of any of the files failed
+	bool HasFailed(const TArray<bson_oid_t>& Oids);
+#endif //SL_WITH_LIBMONGO_C
+
+private:
+	// Get the next batch of jobs, returns false if the queue is empty
+	bool DequeueBatch(TArray<FSLGridFsUploadJob>& OutBatch);
+
+#if SL_WITH_LIBMONGO_C
+	// Upload the batch with the given connection handles (a null gridfs handle fails the whole batch)
+	void UploadBatch(TArray<FSLGridFsUploadJob>& Batch, mongoc_gridfs_t* gridfs,
+		mongoc_collection_t* files_coll, mongoc_collection_t* chunks_coll);
+
+	// Remember the ids of the files which could not be uploaded
+	void AddFailed(const TArray<const FSLGridFsUploadJob*>& Jobs);
+
+	// Upload the file through the gridfs api (used for files larger than one chunk)
+	bool UploadFile(FSLGridFsUploadJob& Job, mongoc_gridfs_t* gridfs) const;
+
+	// Insert the files and chunks documents of the single chunk files in one batch, output the jobs which could not be uploaded
+	void UploadSmallFiles(const TArray<FSLGridFsUploadJob*>& Jobs, mongoc_collection_t* files_coll,
+		mongoc_collection_t* chunks_coll, TArray<const FSLGridFsUploadJob*>& OutFailedJobs) const;
+
+	// Insert the documents unordered, flag the ones which could not be inserted (all of them if the server did not report the failed indexes)
+	void InsertDocs(mongoc_collection_t* coll, const TArray<bson_t*>& Docs, TArray<bool>& OutFailed) const;
+#endif //SL_WITH_LIBMONGO_C
+
+private:
+	// Database name
+	FString DBName;
+
+	// Gridfs collections prefix
+	FString Prefix;
+
+	// Max number of files uploaded in one batch
+	int32 MaxBatchSize;
+
+	// Insert small files directly as documents in batches
+	bool bBatchSmallFiles;
+
+	// Max number of queued or in progress uploads before enqueueing blocks
+	int32 MaxNumPending;
+
+	// Max size of the queued or in progress uploads before enqueueing blocks
+	int64 MaxPendingBytes;
+
+	// Pending uploads (multiple producers, consumers synchronized with the dequeue lock)
+	TQueue<FSLGridFsUploadJob, EQueueMode::Mpsc> Queue;
+
+	// Synchronizes the workers consuming the queue
+	FCriticalSection DequeueLock;
+
+	// Number of queued or in progress uploads
+	FThreadSafeCounter NumPending;
+
+	// Size of the queued or in progress uploads
+	FThreadSafeCounter64 NumPendingBytes;
+
+	// Signals the workers that new jobs are available
+	FEvent* WorkEvent;
+
+	// Signaled by the workers when all queued jobs are processed
+	FEvent* IdleEvent;
+
+	// Signaled by the workers after every processed batch (wakes up a blocked enqueue)
+	FEvent* SpaceEvent;
+
+	// Set when the workers should exit
+	FThreadSafeBool bStopRequested;
+
+	// Upload workers
+	TArray<FSLGridFsUploadWorker*> Workers;
+
+	// Threads running the workers
+	TArray<FRunnableThread*> WorkerThreads;
+
+#if SL_WITH_LIBMONGO_C
+	// Server uri
+	mongoc_uri_t* uri;
+
+	// Thread safe connection pool, one client per worker
+	mongoc_client_pool_t* client_pool;
+
+	// Ids of the files which could not be uploaded
+	TArray<bson_oid_t> FailedOids;
+
+	// Synchronizes the access to the failed ids
+	FCriticalSection FailedLock;
+#endif //SL_WITH_LIBMONGO_C
+
+	/* Constants */
+	// Max time to wait for the queued uploads [s]
+	constexpr static float DefaultFlushTimeout = 60.f;
+
+	// Default max number of pending uploads
+	constexpr static int32 DefaultMaxNumPending = 256;
+
+	// Default max size of the pending uploads [bytes]
+	constexpr static int64 DefaultMaxPendingBytes = 256 * 1024 * 1024;
+};
@@ -5,6 +5,7 @@
 
 #include "USemLog.h"
 #include "Components/SphereComponent.h"
+#include "Monitors/SLMonitorStructs.h"
 #include "SLBoneContactMonitor.generated.h"
 
 // Forward declarations
@@ -247,15 +248,15 @@ private:
 	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
 	FTimerHandle GraspDelayTimerHandle;
 
-	// Array of recently ended events
-	TArray<FSLBoneContactEndEvent> RecentlyEndedGraspOverlapEvents;
+	// Recently ended events, keyed by the other individual
+	TSLRecentlyEndedEvents<FSLBoneContactEndEvent> RecentlyEndedGraspOverlapEvents;
 	
 	
 	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
 	FTimerHandle ContactDelayTimerHandle;
 
-	// Array of recently ended events
-	TArray<FSLBoneContactEndEvent> RecentlyEndedContactOverlapEvents;
+	// Recently ended events, keyed by the other individual
+	TSLRecentlyEndedEvents<FSLBoneContactEndEvent> RecentlyEndedContactOverlapEvents;
 	
 
 	/* Constants */
@@ -107,9 +107,12 @@ protected:
 	// Publish currently overlapping components
 	void TriggerInitialOverlaps();
 
-	// Start checking for supported by events
+	// Start checking for supported by events (updated by the world monitor scheduler)
 	void StartSupportedByUpdateCheck();
 
+	// Enable the supported by update check if there are candidates
+	void ResumeSupportedByUpdateCheck();
+
 	// Check for supported by events
 	void SupportedByUpdateCheckBegin();
 
@@ -187,11 +190,8 @@ protected:
 	// SupportedBy contact candidates
 	TArray<FSLContactResult> SupportedByCandidates;
 	
-	// Supported by event update timer handle
-	FTimerHandle SupportedByTimerHandle;
-
-	// Allow binding against non-UObject functions
-	FTimerDelegate SupportedByTimerDelegate;
+	// Id of the supported by update task in the world monitor scheduler
+	int32 SupportedByUpdateId;
 
 	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
 	FTimerHandle DelayTimerHandle;
@@ -199,8 +199,8 @@ protected:
 	// Can only bind the timer handle to UObjects or FTimerDelegates
 	FTimerDelegate DelayTimerDelegate;
 
-	// Array of recently ended overlaps
-	TArray<FSLOverlapEndEvent> RecentlyEndedOverlapEvents;
+	// Recently ended overlaps, keyed by the other individual
+	TSLRecentlyEndedEvents<FSLOverlapEndEvent> RecentlyEndedOverlapEvents;
 
 	/* Constants */
 	static constexpr auto TagTypeName = TEXT("SemLogColl");
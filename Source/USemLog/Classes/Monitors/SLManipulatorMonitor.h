@@ -319,8 +319,8 @@ private:
 	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
 	FTimerHandle GraspDelayTimerHandle;
 
-	// Array of recently ended events
-	TArray<FSLGraspEndEvent> RecentlyEndedGraspEvents;
+	// Recently ended events, keyed by the other individual
+	TSLRecentlyEndedEvents<FSLGraspEndEvent> RecentlyEndedGraspEvents;
 
 	/* Contact related */
 	// Objects currently in contact and the number of shapes in contact with. Used of semantic contact detection
@@ -329,8 +329,8 @@ private:
 	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
 	FTimerHandle ContactDelayTimerHandle;
 
-	// Array of recently ended events
-	TArray<FSLContactEndEvent> RecentlyEndedContactEvents;
+	// Recently ended events, keyed by the other individual
+	TSLRecentlyEndedEvents<FSLContactEndEvent> RecentlyEndedContactEvents;
 
 	/* Constants */
 	//static constexpr float MaxGraspEventTimeGap = 0.55f;
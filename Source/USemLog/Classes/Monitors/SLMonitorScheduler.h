@@ -0,0 +1,159 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SLMonitorScheduler.generated.h"
+
+/**
+* Scheduled monitor update, called with the time passed since its previous update
+*/
+struct FSLMonitorTask
+{
+	// Unique id of the task
+	int32 Id = INDEX_NONE;
+
+	// Update callback
+	TFunction<void(float)> Update;
+
+	// Time between two updates (every frame if 0)
+	float UpdateRate = 0.f;
+
+	// World time of the previous update
+	float LastUpdateTime = 0.f;
+
+	// World time of the next update
+	float NextUpdateTime = 0.f;
+
+	// Update is only called if enabled
+	bool bEnabled = false;
+
+	// Task is removed after the current group update
+	bool bPendingRemoval = false;
+};
+
+/**
+* Aggregated update cost of a monitor group
+*/
+struct FSLMonitorGroupStats
+{
+	// Number of update calls
+	int64 NumUpdates = 0;
+
+	// Number of frames where the time budget was exceeded and the remaining updates were postponed
+	int64 NumBudgetExceeded = 0;
+
+	// Total time spent in the updates (seconds)
+	double TotalTime = 0.0;
+
+	// Most time spent in the updates in a single frame (seconds)
+	double MaxFrameTime = 0.0;
+};
+
+/**
+* Monitors of the same type, updated in one contiguous batch
+*/
+struct FSLMonitorGroup
+{
+	// Tasks of the group
+	TArray<FSLMonitorTask> Tasks;
+
+	// Max time spent per frame updating the group in seconds (unlimited if 0)
+	float TimeBudget = 0.f;
+
+	// Index of the next task to check, the updates continue from here if the budget was exceeded
+	int32 NextTaskIdx = 0;
+
+	// True if tasks were removed during the update
+	bool bHasPendingRemovals = false;
+
+	// Update cost
+	FSLMonitorGroupStats Stats;
+};
+
+/**
+ * Owns the periodic updates of the monitors in the world,
+ * replaces the individual component ticks and timers with batched updates per monitor type
+ */
+UCLASS()
+class USEMLOG_API USLMonitorScheduler : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	// Ctor
+	USLMonitorScheduler();
+
+	/** Begin USubsystem interface */
+	// Clear the groups and log their update cost
+	virtual void Deinitialize() override;
+	/** End USubsystem interface */
+
+	/** Begin FTickableGameObject interface */
+	// Update the due tasks of every group
+	virtual void Tick(float DeltaTime) override;
+
+	// Only tick in game worlds
+	virtual bool IsTickable() const override;
+
+	// Return the stat id to use for this tickable
+	virtual TStatId GetStatId() const override;
+	/** End FTickableGameObject interface */
+
+	// Get the scheduler of the world
+	static USLMonitorScheduler* Get(UWorld* World);
+
+	// Add an update callback to the group (every frame if the update rate is 0), returns the task id
+	int32 Register(FName GroupName, TFunction<void(float)> Update, float UpdateRate = 0.f, bool bStartEnabled = false);
+
+	// Remove the task, safe to call from inside the updates
+	void Unregister(int32 TaskId);
+
+	// Enable or disable the task updates, enabling restarts the update interval
+	void SetEnabled(int32 TaskId, bool bEnabled);
+
+	// Check if the task updates are enabled
+	bool IsEnabled(int32 TaskId) const;
+
+	// Set the update rate of the task
+	void SetUpdateRate(int32 TaskId, float UpdateRate);
+
+	// Set the max time spent per frame updating the group in milliseconds (unlimited if 0)
+	void SetTimeBudget(FName GroupName, float TimeBudgetMs);
+
+	// Get the update cost of the group
+	const FSLMonitorGroupStats* GetStats(FName GroupName) const;
+
+	// Log the update cost of every group
+	void LogStats() const;
+
+private:
+	// Update the due tasks of the group until the budget is exceeded
+	void UpdateGroup(FSLMonitorGroup& Group, float CurrTime);
+
+	// Remove the tasks marked for removal and update the index map
+	void RemovePendingTasks(FName GroupName, FSLMonitorGroup& Group);
+
+	// Get the task from its id
+	FSLMonitorTask* FindTask(int32 TaskId);
+	const FSLMonitorTask* FindTask(int32 TaskId) const;
+
+private:
+	// Monitor groups (per monitor type)
+	TMap<FName, FSLMonitorGroup> Groups;
+
+	// Task id to group name and index in the tasks array
+	TMap<int32, TPair<FName, int32>> TaskLocations;
+
+	// Tasks registered during an update, added to their groups afterwards
+	TArray<TPair<FName, FSLMonitorTask>> PendingTasks;
+
+	// Id of the next registered task
+	int32 NextTaskId;
+
+	// True while the tasks are updated
+	bool bIsUpdating;
+};
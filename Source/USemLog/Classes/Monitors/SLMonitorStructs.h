@@ -115,3 +115,109 @@ struct FSLMonEntityPair
 };
 
 
+
+/**
+ * Recently ended events waiting for a possible concatenation with a following start (jitter),
+ * keyed by the other individual for the jitter checks, and ordered in a min-heap by their end time for publishing
+ */
+template<typename EventType>
+class TSLRecentlyEndedEvents
+{
+public:
+	// Add the ended event with the other individual
+	void Add(USLBaseIndividual* Other, float Time, const EventType& Event)
+	{
+		const int32 Id = NextId++;
+		Events.Add(Id, FEntry(Other, Time, Event));
+		LatestIds.Add(Other, Id);
+		ExpiryHeap.HeapPush(FExpiry(Time, Id), FExpiryPredicate());
+	}
+
+	// Remove the latest ended event with the other individual if it ended less than MaxGap before the start time
+	bool RemoveIfJitter(USLBaseIndividual* Other, float StartTime, float MaxGap)
+	{
+		const int32* Id = LatestIds.Find(Other);
+		if (Id && StartTime - Events.FindChecked(*Id).Time < MaxGap)
+		{
+			// The heap entry is skipped when popped
+			Events.Remove(*Id);
+			LatestIds.Remove(Other);
+			return true;
+		}
+		return false;
+	}
+
+	// Remove the events older than MinAge (all if the current time is negative) in their end order, and pass them to the function
+	template<typename FuncType>
+	void PopExpired(float CurrTime, float MinAge, FuncType Func)
+	{
+		while (ExpiryHeap.Num() > 0)
+		{
+			const FExpiry Top = ExpiryHeap.HeapTop();
+			const FEntry* Entry = Events.Find(Top.Value);
+			if (Entry && CurrTime >= 0.f && CurrTime - Entry->Time <= MinAge)
+			{
+				break;
+			}
+
+			ExpiryHeap.HeapPopDiscard(FExpiryPredicate(), false);
+			if (Entry)
+			{
+				// Copy before removing, the function might add new events
+				const FEntry Expired = *Entry;
+				Events.Remove(Top.Value);
+				const int32* LatestId = LatestIds.Find(Expired.Other);
+				if (LatestId && *LatestId == Top.Value)
+				{
+					LatestIds.Remove(Expired.Other);
+				}
+				Func(Expired.Event);
+			}
+		}
+	}
+
+	// Number of events waiting to be published
+	int32 Num() const { return Events.Num(); }
+
+	// Remove all events
+	void Empty()
+	{
+		Events.Empty();
+		LatestIds.Empty();
+		ExpiryHeap.Empty();
+	}
+
+private:
+	// Event with its key and end time
+	struct FEntry
+	{
+		FEntry(USLBaseIndividual* InOther, float InTime, const EventType& InEvent) : Other(InOther), Time(InTime), Event(InEvent) {};
+		USLBaseIndividual* Other;
+		float Time;
+		EventType Event;
+	};
+
+	// End time and event id
+	typedef TPair<float, int32> FExpiry;
+
+	// Order by the end time, then by the insertion order
+	struct FExpiryPredicate
+	{
+		bool operator()(const FExpiry& A, const FExpiry& B) const
+		{
+			return A.Key < B.Key || (A.Key == B.Key && A.Value < B.Value);
+		}
+	};
+
+	// Events waiting to be published
+	TMap<int32, FEntry> Events;
+
+	// Id of the latest ended event of every individual (only the latest can be concatenated)
+	TMap<USLBaseIndividual*, int32> LatestIds;
+
+	// Min-heap of the end times, removed events are skipped lazily
+	TArray<FExpiry> ExpiryHeap;
+
+	// Id of the next added event
+	int32 NextId = 0;
+};
@@ -0,0 +1,87 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Recent movement sample of the grasped object
+ */
+struct FSLPaPMovementSample
+{
+	// Time of the sample
+	float Time;
+
+	// Location of the object
+	FVector Location;
+
+	// Travelled path length since the first sample of the buffer
+	float PathLength;
+};
+
+/**
+ * Fixed capacity circular buffer of the recent movements (the oldest sample is overwritten when full),
+ * keeps the descending height maxima and the cumulative path lengths to answer the backtracking queries without full scans
+ */
+class USEMLOG_API FSLPaPMovementBuffer
+{
+public:
+	// Allocate the buffer (the capacity is rounded up to a power of two)
+	explicit FSLPaPMovementBuffer(int32 InCapacity = 512);
+
+	// Add a new sample
+	void Add(float Time, const FVector& Location);
+
+	// Remove the samples older than the duration relative to the newest sample
+	void RemoveOlderThan(float Duration);
+
+	// Remove all samples (keeps the allocation)
+	void Reset();
+
+	// Number of samples
+	int32 Num() const { return static_cast<int32>(NextSeq - FirstSeq); };
+
+	// Sample at the index (0 is the oldest)
+	const FSLPaPMovementSample& operator[](int32 Idx) const { return Samples[(FirstSeq + Idx) & Mask]; };
+
+	// Newest sample
+	const FSLPaPMovementSample& Last() const { return Samples[(NextSeq - 1) & Mask]; };
+
+	// Index of the newest sample higher than the given value, INDEX_NONE if none
+	int32 FindLastHigherThan(float Z) const;
+
+	// Index of the newest sample in [MinIdx, MaxIdx] further than the distance from the location, INDEX_NONE if none
+	int32 FindLastFurtherThan(const FVector& Location, float Dist, int32 MaxIdx, int32 MinIdx = 0) const;
+
+private:
+	// Index of the newest sample in [0, MaxIdx] with a path length smaller than the value, INDEX_NONE if none
+	int32 FindLastPathLengthBelow(float Value, int32 MaxIdx) const;
+
+	// Remove the oldest sample
+	void RemoveFirst();
+
+private:
+	// Samples storage, indexed by the sequence number of the sample
+	TArray<FSLPaPMovementSample> Samples;
+
+	// Sequence numbers of the samples higher than all the newer ones (heights strictly descending)
+	TArray<uint32> HeightMaxima;
+
+	// Sequence number of the oldest sample
+	uint32 FirstSeq;
+
+	// Sequence number of the next sample
+	uint32 NextSeq;
+
+	// First and past the last used height maxima positions
+	uint32 MaximaFirst;
+	uint32 MaximaNext;
+
+	// Capacity minus one
+	uint32 Mask;
+
+	/* Constants */
+	// Tolerance for the accumulated path length rounding errors
+	static constexpr float PathLengthTolerance = 0.01f;
+};
@@ -7,6 +7,7 @@
 #include "USemLog.h"
 #include "Components/ActorComponent.h"
 #include "SLContactMonitorInterface.h"
+#include "Monitors/SLPaPMovementBuffer.h"
 #include "SLPickAndPlaceMonitor.generated.h"
 
 // Forward declaration
@@ -65,9 +66,6 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
-	// Called every frame, used for timeline visualizations, activated and deactivated on request
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
 public:
 	// Check if owner is valid and semantically annotated
 	void Init();
@@ -101,7 +99,7 @@ private:
 	void FinishActiveEvent(float CurrTime);
 
 	// Backtrace and check if a put-down event happened
-	bool HasPutDownEventHappened(const float CurrTime,const FVector& CurrObjLocation,  uint32& OutPutDownEndIdx);
+	bool HasPutDownEventHappened(const float CurrTime, const FVector& CurrObjLocation, int32& OutPutDownEndIdx);
 
 	// State update functions
 	void Update_NONE();
@@ -112,6 +110,18 @@ private:
 	// Get grasped objects contact shape component
 	ISLContactMonitorInterface* GetContactMonitorComponent(AActor* Actor) const;
 
+	// Register the update with the world monitor scheduler (replaces the component tick)
+	void RegisterScheduledUpdate();
+
+	// Remove the update from the world monitor scheduler
+	void UnregisterScheduledUpdate();
+
+	// Enable or disable the scheduled update
+	void SetScheduledUpdateEnabled(bool bEnabled);
+
+	// Check if the scheduled update is enabled
+	bool IsScheduledUpdateEnabled() const;
+
 public:
 	// PaP events delegates
 	FSLPaPSubEventSignature OnManipulatorSlideEvent;
@@ -193,6 +203,9 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
 	float UpdateRate;
 
+	// Id of the update task in the world monitor scheduler
+	int32 ScheduledUpdateId;
+
 	// Semantic data component of the owner
 	USLIndividualComponent* OwnerIndividualComponent;
 
@@ -230,7 +243,7 @@ private:
 
 	/* PutDown related */
 	// Past locations and time during transport in order to backtrace and detect put-down events
-	TArray<TPair<float, FVector>> RecentMovementBuffer;
+	FSLPaPMovementBuffer RecentMovementBuffer;
 
 	/* Constants */
 	//constexpr static float UpdateRate = 0.035f;
@@ -5,6 +5,7 @@
 
 #include "USemLog.h"
 #include "Components/SphereComponent.h"
+#include "Monitors/SLMonitorStructs.h"
 #include "SLReachAndPreGraspMonitor.generated.h"
 
 // Forward declarations
@@ -44,6 +45,57 @@ enum ESLTimeAndDist
 //using FSLTimeAndDistance = TPair<float, float>;
 using FSLTimeAndDist = TTuple<float, float>; // <Time, Distance>
 
+/**
+ * Reach candidates stored in flat arrays for the batched distance updates
+ */
+struct FSLReachCandidates
+{
+	// Add the candidate (or reset its values if it already exists), returns its index
+	int32 Add(USLBaseIndividual* Individual, USceneComponent* Root, const FVector& Location, float StartTime, float Dist);
+
+	// Remove the candidate at the index, the last candidate takes its place
+	void RemoveAtSwap(int32 Idx);
+
+	// Remove all candidates
+	void Empty();
+
+	// Get the index of the candidate, INDEX_NONE if not found
+	int32 Find(USLBaseIndividual* Individual) const { const int32* Idx = Indexes.Find(Individual); return Idx ? *Idx : INDEX_NONE; };
+
+	// Check if the individual is a candidate
+	bool Contains(USLBaseIndividual* Individual) const { return Indexes.Contains(Individual); };
+
+	// Number of candidates
+	int32 Num() const { return Individuals.Num(); };
+
+	// Candidate individuals
+	TArray<USLBaseIndividual*> Individuals;
+
+	// Root components of the candidates
+	TArray<TWeakObjectPtr<USceneComponent>> Roots;
+
+	// Latest known locations of the candidates
+	TArray<FVector> Locations;
+
+	// Possible reaching start times
+	TArray<float> StartTimes;
+
+	// Distances to the manipulator at the last relevant change
+	TArray<float> Dists;
+
+	// Candidates which moved since the last distance update
+	TArray<bool> Moved;
+
+	// Transform update bindings of the candidates (event driven updates)
+	TArray<FDelegateHandle> TransformUpdatedHandles;
+
+	// Individual to candidate index
+	TMap<USLBaseIndividual*, int32> Indexes;
+
+	// Current distances, reused between the updates
+	TArray<float> CurrDists;
+};
+
 /** Notify when a reaching event happened*/
 DECLARE_MULTICAST_DELEGATE_FiveParams(FSLReachAndPreGraspEventSignature, USLBaseIndividual* /*Self*/, USLBaseIndividual* /*Other*/, float /*ReachStartTime*/, float /*ReachEndTime*/, float /*PreGraspEndTime*/);
 
@@ -62,10 +114,6 @@ public:
 	// Dtor
 	~USLReachAndPreGraspMonitor();
 
-protected:
-	// Called every frame, used for timeline visualizations, activated and deactivated on request
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
 public:
 	// Initialize trigger areas for runtime, check if owner is valid and semantically annotated
 	void Init();
@@ -110,6 +158,31 @@ private:
 	// Update callback, checks distance to hand, if it increases it resets the start time
 	void UpdateCandidatesData(float DeltaTime);
 
+	// Add the individual as a reach candidate, listen to its transform updates if event driven
+	void AddCandidate(USLBaseIndividual* Individual, AActor* Actor);
+
+	// Remove the reach candidate, returns false if it was not a candidate
+	bool RemoveCandidate(USLBaseIndividual* Individual);
+
+	// Remove all reach candidates
+	void EmptyCandidates();
+
+	// Called when a candidate moved (event driven updates)
+	void OnCandidateTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+		ETeleportType Teleport, USLBaseIndividual* Individual);
+
+	// Register the update with the world monitor scheduler (replaces the component tick)
+	void RegisterScheduledUpdate();
+
+	// Remove the update from the world monitor scheduler
+	void UnregisterScheduledUpdate();
+
+	// Enable or disable the scheduled update
+	void SetScheduledUpdateEnabled(bool bEnabled);
+
+	// Check if the scheduled update is enabled
+	bool IsScheduledUpdateEnabled() const;
+
 	// Publish currently overlapping components
 	void TriggerInitialOverlaps();
 
@@ -180,6 +253,13 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
 	float UpdateRate;
 
+	// Id of the update task in the world monitor scheduler
+	int32 ScheduledUpdateId;
+
+	// Only update the distances of the moved candidates (listens to their transform updates instead of sampling all of them)
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
+	uint8 bEventDrivenCandidateUpdates : 1;
+
 	// Candidate check update rate
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
 	float ConcatenateIfSmaller;
@@ -191,7 +271,10 @@ private:
 	USLBaseIndividual* OwnerIndividualObject;
 
 	// Individual candidates with information about the possible reaching time and distance form reaching actor
-	TMap<USLBaseIndividual*, FSLTimeAndDist> CandidatesData;
+	FSLReachCandidates CandidatesData;
+
+	// Location of the manipulator at the previous update
+	FVector PrevManipulatorLocation;
 
 	// Individuals and the start timestamp in contact with the manipulator (hand)
 	TMap<USLBaseIndividual*, float> ManipulatorContactData;
@@ -202,8 +285,8 @@ private:
 	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
 	FTimerHandle DelayTimerHandle;
 
-	// Array of recently ended events
-	TArray<FSLPreGraspEndEvent> RecentlyEndedEvents;
+	// Recently ended events, keyed by the other individual
+	TSLRecentlyEndedEvents<FSLPreGraspEndEvent> RecentlyEndedEvents;
 	
 	/* Constants */
 	constexpr static float IgnoreMovementsSmallerThanValue = 2.5f;
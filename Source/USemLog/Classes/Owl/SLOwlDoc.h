@@ -4,6 +4,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
 #include "Owl/SLOwlNode.h"
 
 /**
@@ -180,25 +182,126 @@ public:
 		Individuals.Add(InChildNode);
 	}
 
+	// Add individual node to the document (moved)
+	void AddIndividual(FSLOwlNode&& InChildNode)
+	{
+		Individuals.Add(MoveTemp(InChildNode));
+	}
+
 	// Add individuals to the document
 	void AddIndividuals(const TArray<FSLOwlNode>& InChildNodes)
 	{
 		Individuals.Append(InChildNodes);
 	}
 
+	// Add individuals to the document (moved)
+	void AddIndividuals(TArray<FSLOwlNode>&& InChildNodes)
+	{
+		Individuals.Append(MoveTemp(InChildNodes));
+	}
+
+	// Return the document start as string (declarations, root tag, definitions and the current individuals),
+	// the following individuals can be streamed after it
+	FString StartToString() const
+	{
+		FString DocStr;
+		WriteHeader(DocStr);
+		for (const auto& Node : Individuals)
+		{
+			Node.WriteTo(DocStr, FString(), 1);
+		}
+		return DocStr;
+	}
+
+	// Return the document end as string (closes the root tag)
+	static FString EndToString()
+	{
+		return TEXT("</rdf:RDF>\n");
+	}
+
 	// Return document as string
 	FString ToString() const
 	{
-		FString Indent = "";
-		FString DocStr = TEXT("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n\n");
-		DocStr += EntityDefinitions.ToString();
-		FSLOwlNode Root(FSLOwlPrefixName("rdf", "RDF"), Namespaces);
-		Root.AddChildNode(OntologyImports);
-		Root.AddChildNodes(PropertyDefinitions);
-		Root.AddChildNodes(DatatypeDefinitions);
-		Root.AddChildNodes(ClassDefinitions);
-		Root.AddChildNodes(Individuals);
-		DocStr += Root.ToString(Indent);
+		FString DocStr = StartToString();
+		DocStr += EndToString();
 		return DocStr;
 	}
+
+	// Write the document to file in chunks without building the whole string,
+	// the output is identical to saving ToString() with FFileHelper::SaveStringToFile
+	bool SaveToFile(const FString& FilePath) const
+	{
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!FileWriter)
+		{
+			return false;
+		}
+
+		// Flushes the chunk as ansi, returns false if the chunk contains wider characters
+		auto FlushChunk = [&FileWriter](FString& Chunk) -> bool
+		{
+			if (!FCString::IsPureAnsi(*Chunk))
+			{
+				return false;
+			}
+			FTCHARToANSI AnsiChunk(*Chunk);
+			FileWriter->Serialize(const_cast<ANSICHAR*>(AnsiChunk.Get()), AnsiChunk.Length());
+			Chunk.Reset();
+			return true;
+		};
+
+		FString Chunk;
+		Chunk.Reserve(SaveChunkSize * 2);
+		WriteHeader(Chunk);
+		bool bIsPureAnsi = FlushChunk(Chunk);
+		for (int32 Idx = 0; Idx < Individuals.Num() && bIsPureAnsi; ++Idx)
+		{
+			Individuals[Idx].WriteTo(Chunk, FString(), 1);
+			if (Chunk.Len() > SaveChunkSize)
+			{
+				bIsPureAnsi = FlushChunk(Chunk);
+			}
+		}
+		if (bIsPureAnsi)
+		{
+			Chunk += EndToString();
+			bIsPureAnsi = FlushChunk(Chunk);
+		}
+		const bool bSuccess = FileWriter->Close() && !FileWriter->IsError();
+		FileWriter.Reset();
+
+		// Non-ansi documents are saved as a whole to keep the auto detected (utf-16) encoding
+		if (!bIsPureAnsi)
+		{
+			return FFileHelper::SaveStringToFile(ToString(), *FilePath);
+		}
+		return bSuccess;
+	}
+
+private:
+	// Write the declarations, the root start tag and the definitions (everything before the individuals)
+	void WriteHeader(FString& Out) const
+	{
+		Out += TEXT("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n\n");
+		Out += EntityDefinitions.ToString();
+		FSLOwlNode(FSLOwlPrefixName("rdf", "RDF"), Namespaces).WriteStartTag(Out, FString(), 0);
+		Out += TEXT(">\n");
+		OntologyImports.WriteTo(Out, FString(), 1);
+		for (const auto& Node : PropertyDefinitions)
+		{
+			Node.WriteTo(Out, FString(), 1);
+		}
+		for (const auto& Node : DatatypeDefinitions)
+		{
+			Node.WriteTo(Out, FString(), 1);
+		}
+		for (const auto& Node : ClassDefinitions)
+		{
+			Node.WriteTo(Out, FString(), 1);
+		}
+	}
+
+	/* Constants */
+	// Number of characters buffered before writing to file
+	static constexpr int32 SaveChunkSize = 64 * 1024;
 };
@@ -65,6 +65,25 @@ public:
 		return false;
 	}
 
+	// Add timepoint individual (moved)
+	bool AddTimepointIndividual(const float Timepoint, FSLOwlNode&& InOwlNode)
+	{
+		// Avoid logging the same individual multiple times
+		if (!RegisteredTimepoints.Contains(Timepoint))
+		{
+			RegisteredTimepoints.Add(Timepoint);
+			TimepointIndividuals.Emplace(MoveTemp(InOwlNode));
+			return true;
+		}
+		return false;
+	}
+
+	// Check if the timepoint individual is already added
+	bool HasTimepointIndividual(const float Timepoint) const
+	{
+		return RegisteredTimepoints.Contains(Timepoint);
+	}
+
 	// Add object individual
 	bool AddObjectIndividual(UObject* Object, const FSLOwlNode& InOwlNode)
 	{
@@ -78,6 +97,25 @@ public:
 		return false;
 	}
 
+	// Add object individual (moved)
+	bool AddObjectIndividual(UObject* Object, FSLOwlNode&& InOwlNode)
+	{
+		// Avoid logging the same individual multiple times
+		if (!RegisteredObjects.Contains(Object))
+		{
+			RegisteredObjects.Add(Object);
+			ObjectIndividuals.Emplace(MoveTemp(InOwlNode));
+			return true;
+		}
+		return false;
+	}
+
+	// Check if the object individual is already added
+	bool HasObjectIndividual(UObject* Object) const
+	{
+		return RegisteredObjects.Contains(Object);
+	}
+
 	// Create and add experiment node individual
 	void AddExperimentIndividual()
 	{
@@ -104,7 +142,8 @@ public:
 		if (TimepointIndividuals.Num() > 0)
 		{
 			TimepointIndividuals[0].Comment = "Timepoint Individuals";
-			AddIndividuals(TimepointIndividuals);
+			AddIndividuals(MoveTemp(TimepointIndividuals));
+			TimepointIndividuals.Empty();
 		}
 
 	}
@@ -115,7 +154,8 @@ public:
 		if (ObjectIndividuals.Num() > 0)
 		{
 			ObjectIndividuals[0].Comment = "Object Individuals";
-			AddIndividuals(ObjectIndividuals);
+			AddIndividuals(MoveTemp(ObjectIndividuals));
+			ObjectIndividuals.Empty();
 		}
 	}
 };
@@ -6,6 +6,9 @@
 #include "EngineMinimal.h"
 #include "Owl/SLOwlExperiment.h"
 
+// Forward declarations
+class USLBaseIndividual;
+
 /**
 * Helper functions for generating owl experiment documents
 */
@@ -43,6 +46,18 @@ struct USEMLOG_API FSLOwlExperimentStatics
 		const FString& InId,
 		const FString& InClass);
 
+	// Create and add the timepoint individual to the experiment (the node is only created for new timepoints)
+	static bool AddTimepointIndividual(
+		FSLOwlExperiment* Experiment,
+		const FString& InDocPrefix,
+		const float Timepoint);
+
+	// Create and add the object individual to the experiment (the node is only created for new objects)
+	static bool AddObjectIndividual(
+		FSLOwlExperiment* Experiment,
+		const FString& InDocPrefix,
+		USLBaseIndividual* Individual);
+
 
 	/* Owl properties creation */
 	// Create class property
@@ -57,6 +57,14 @@ public:
 		Attributes.Add(InAttribute);
 	}
 
+	// Init constructor, NO Value and Children, one moved attribute
+	FSLOwlNode(const FSLOwlPrefixName& InName,
+		FSLOwlAttribute&& InAttribute) :
+		Name(InName)
+	{
+		Attributes.Add(MoveTemp(InAttribute));
+	}
+
 	// Init constructor, NO Value
 	FSLOwlNode(const FSLOwlPrefixName& InName,
 		const TArray<FSLOwlAttribute>& InAttributes,
@@ -101,18 +109,36 @@ public:
 		ChildNodes.Add(InChildNode);
 	}
 
+	// Add child node (moved)
+	void AddChildNode(FSLOwlNode&& InChildNode)
+	{
+		ChildNodes.Add(MoveTemp(InChildNode));
+	}
+
 	// Add child nodes
 	void AddChildNodes(const TArray<FSLOwlNode>& InChildNodes)
 	{
 		ChildNodes.Append(InChildNodes);
 	}
 
+	// Add child nodes (moved)
+	void AddChildNodes(TArray<FSLOwlNode>&& InChildNodes)
+	{
+		ChildNodes.Append(MoveTemp(InChildNodes));
+	}
+
 	// Add attribute
 	void AddAttribute(const FSLOwlAttribute& InAttribute)
 	{
 		Attributes.Add(InAttribute);
 	}
 
+	// Add attribute (moved)
+	void AddAttribute(FSLOwlAttribute&& InAttribute)
+	{
+		Attributes.Add(MoveTemp(InAttribute));
+	}
+
 	// Add attributes
 	void AddAttributes(const TArray<FSLOwlAttribute>& InAttributes)
 	{
@@ -148,82 +174,117 @@ public:
 	// Destructor
 	~FSLOwlNode() {}
 
+	// Return the opening tag of the node without the closing bracket (name and attributes) as string
+	FString StartTagToString(const FString& Indent) const
+	{
+		FString NodeStr;
+		WriteStartTag(NodeStr, Indent, 0);
+		return NodeStr;
+	}
+
 	// Return node as string
 	FString ToString(FString& Indent) const
 	{
 		FString NodeStr;
+		WriteTo(NodeStr, Indent, 0);
+		return NodeStr;
+	}
+
+	// Append the node to the output (indented with the base indent followed by depth indent steps)
+	void WriteTo(FString& Out, const FString& BaseIndent, int32 Depth) const
+	{
 		// Add comment
 		if (!Comment.IsEmpty())
 		{
-			NodeStr += TEXT("\n") + Indent + TEXT("<!-- ") + Comment + TEXT(" -->\n");
+			Out += TEXT("\n");
+			AppendIndent(Out, BaseIndent, Depth);
+			Out += TEXT("<!-- ");
+			Out += Comment;
+			Out += TEXT(" -->\n");
 		}
 
 		// Comment only OR empty node
-		if (Name.ToString().IsEmpty())
+		if (Name.IsEmpty())
 		{
-			return NodeStr;
+			return;
 		}
 
-		// Add node name
-		NodeStr += Indent + TEXT("<") + Name.ToString();
+		// Add node name and attributes
+		WriteStartTag(Out, BaseIndent, Depth);
 
-		// Add attributes to tag
-		for (int32 i = 0; i < Attributes.Num(); ++i)
-		{
-			if (Attributes.Num() == 1)
-			{
-				NodeStr += TEXT(" ") + Attributes[i].ToString();
-			}
-			else
-			{
-				if (i < (Attributes.Num() - 1))
-				{
-					NodeStr += TEXT(" ") + Attributes[i].ToString() + TEXT("\n") + Indent + INDENT_STEP;
-				}
-				else
-				{
-					// Last attribute does not have new line
-					NodeStr += TEXT(" ") + Attributes[i].ToString();
-				}
-			}
-		}
-
-		// Check node data (children/value)
-		bool bHasChildren = ChildNodes.Num() != 0;
-		bool bHasValue = !Value.IsEmpty();
-			
 		// Node cannot have value and children
-		if (!bHasChildren && !bHasValue)
+		if (ChildNodes.Num() == 0 && Value.IsEmpty())
 		{
 			// No children nor value, close tag
-			NodeStr += TEXT("/>\n");
+			Out += TEXT("/>\n");
 		}
-		else if (bHasValue)
+		else if (!Value.IsEmpty())
 		{
 			// Node has a value, add value
-			NodeStr += TEXT(">") + Value + TEXT("</") + Name.ToString() + TEXT(">\n");
+			Out += TEXT(">");
+			Out += Value;
+			Out += TEXT("</");
+			Name.AppendTo(Out);
+			Out += TEXT(">\n");
 		}
-		else if(bHasChildren)
+		else
 		{
-			// Node has children, add children
-			NodeStr += TEXT(">\n");
-			
-			// Increase indentation
-			Indent += INDENT_STEP;
-			
-			// Iterate children and add nodes
-			for (auto& ChildItr : ChildNodes)
+			// Node has children, add them one indent step deeper
+			Out += TEXT(">\n");
+			for (const auto& ChildItr : ChildNodes)
 			{
-				NodeStr += ChildItr.ToString(Indent);
+				ChildItr.WriteTo(Out, BaseIndent, Depth + 1);
 			}
-			
-			// Decrease indentation
-			Indent.RemoveFromEnd(INDENT_STEP);
-			
+
 			// Close tag
-			NodeStr += Indent + Value + TEXT("</") + Name.ToString() + TEXT(">\n");
+			AppendIndent(Out, BaseIndent, Depth);
+			Out += TEXT("</");
+			Name.AppendTo(Out);
+			Out += TEXT(">\n");
+		}
+	}
+
+	// Append the opening tag of the node without the closing bracket (name and attributes)
+	void WriteStartTag(FString& Out, const FString& BaseIndent, int32 Depth) const
+	{
+		AppendIndent(Out, BaseIndent, Depth);
+		Out += TEXT("<");
+		Name.AppendTo(Out);
+
+		// Multiple attributes are written on separate lines, one indent step deeper
+		for (int32 i = 0; i < Attributes.Num(); ++i)
+		{
+			Out += TEXT(" ");
+			Attributes[i].AppendTo(Out);
+			if (i < (Attributes.Num() - 1))
+			{
+				Out += TEXT("\n");
+				AppendIndent(Out, BaseIndent, Depth + 1);
+			}
+		}
+	}
+
+	// Append the base indent followed by depth indent steps (copied from a precomputed string)
+	static void AppendIndent(FString& Out, const FString& BaseIndent, int32 Depth)
+	{
+		static const int32 MaxSteps = 32;
+		static const FString Steps = []()
+		{
+			FString Str;
+			for (int32 i = 0; i < MaxSteps; ++i)
+			{
+				Str += INDENT_STEP;
+			}
+			return Str;
+		}();
+
+		Out += BaseIndent;
+		while (Depth > 0)
+		{
+			const int32 NumSteps = FMath::Min(Depth, MaxSteps);
+			Out.AppendChars(*Steps, NumSteps * INDENT_STEP.Len());
+			Depth -= NumSteps;
 		}
-		return NodeStr;
 	}
 };
 
@@ -0,0 +1,77 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Owl/SLOwlNode.h"
+
+// Forward declarations
+class FArchive;
+class FRunnableThread;
+class FSLOwlStreamWorker;
+
+/**
+* Text or nodes waiting to be written
+*/
+struct FSLOwlStreamJob
+{
+	// Raw text (written first)
+	FString Text;
+
+	// Nodes written as children of the document root
+	TArray<FSLOwlNode> Nodes;
+};
+
+/**
+ * Appends owl document parts to a file from a background thread,
+ * the document start and end are written at Start and Finish, the individuals in between as they are added
+ */
+class FSLOwlStreamWriter
+{
+	friend class FSLOwlStreamWorker;
+
+public:
+	// Ctor
+	FSLOwlStreamWriter();
+
+	// Dtor
+	~FSLOwlStreamWriter();
+
+	// Create the file, write the document start, and start the writer thread
+	bool Start(const FString& FilePath, const FString& DocStart);
+
+	// Check if the writer thread is running
+	bool IsRunning() const { return Thread != nullptr; };
+
+	// Queue the nodes to be written as children of the document root
+	void Write(TArray<FSLOwlNode>&& Nodes);
+
+	// Queue the document end, wait for the pending writes and close the file
+	void Finish(const FString& DocEnd);
+
+private:
+	// Write the queued jobs, returns false if the queue is empty
+	bool WritePending();
+
+private:
+	// Pending writes (produced by the game thread)
+	TQueue<FSLOwlStreamJob, EQueueMode::Spsc> Queue;
+
+	// Signals the worker that new jobs are available
+	FEvent* WorkEvent;
+
+	// Set when the worker should exit
+	FThreadSafeBool bStopRequested;
+
+	// Output file
+	FArchive* FileWriter;
+
+	// Writes the queue to file
+	FSLOwlStreamWorker* Worker;
+
+	// Thread running the worker
+	FRunnableThread* Thread;
+};
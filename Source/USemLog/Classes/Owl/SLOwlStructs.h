@@ -42,6 +42,17 @@ public:
 		return LocalName.IsEmpty() ? Prefix : FString(Prefix + TEXT(":") + LocalName);
 	}
 
+	// Append the name to the output
+	void AppendTo(FString& Out) const
+	{
+		Out += Prefix;
+		if (!LocalName.IsEmpty())
+		{
+			Out += TEXT(":");
+			Out += LocalName;
+		}
+	}
+
 	// True if all data is empty
 	bool IsEmpty() const
 	{
@@ -88,6 +99,23 @@ public:
 			: FString(TEXT("\"&") + Ns + TEXT(";") + LocalValue + TEXT("\""));
 	}
 
+	// Append the quoted value to the output
+	void AppendTo(FString& Out) const
+	{
+		if (Ns.IsEmpty())
+		{
+			Out += TEXT("\"");
+		}
+		else
+		{
+			Out += TEXT("\"&");
+			Out += Ns;
+			Out += TEXT(";");
+		}
+		Out += LocalValue;
+		Out += TEXT("\"");
+	}
+
 	// True if all data is empty
 	bool IsEmpty() const
 	{
@@ -124,12 +152,24 @@ public:
 	FSLOwlAttribute(const FSLOwlPrefixName& InKey, const FSLOwlAttributeValue& InValue) :
 		Key(InKey), Value(InValue) {}
 
+	// Init constr, moves the value
+	FSLOwlAttribute(const FSLOwlPrefixName& InKey, FSLOwlAttributeValue&& InValue) :
+		Key(InKey), Value(MoveTemp(InValue)) {}
+
 	// Get attribute as string
 	FString ToString() const 
 	{
 		return Key.ToString() + TEXT("=") + Value.ToString();
 	}
 
+	// Append the attribute to the output
+	void AppendTo(FString& Out) const
+	{
+		Key.AppendTo(Out);
+		Out += TEXT("=");
+		Value.AppendTo(Out);
+	}
+
 	// True if all data is empty
 	bool IsEmpty() const
 	{
@@ -20,6 +20,18 @@
 #include "Events/ISLEventHandler.h"
 #include "SLPrologClient.generated.h"
 
+/**
+ * Tells sent together as a single prolog query
+ */
+struct FSLPrologTellBatch
+{
+	// Ids of the tells (event or object ids)
+	TArray<FString> Ids;
+
+	// Tell queries
+	TArray<FString> Queries;
+};
+
 /**
  * ROS Prolog Client to log and query into Knowrob
  */
@@ -37,7 +49,7 @@ public:
 	~USLPrologClient();
 
 #if SL_WITH_ROSBRIDGE
-	// Disconnect from ROSBridge
+	// Send the remaining queries and disconnect from ROSBridge once their responses are processed
 	void Disconnect();
 
 	// Init socket connection
@@ -52,6 +64,12 @@ public:
 	// Add an add object query
 	void AddObjectQuery(USLBaseIndividual *Entity);
 
+	// Add a tell query to the batch (sent together with the other tells of the batch window)
+	void AddBatchedTellQuery(const FString& Id, const FString& Query);
+
+	// Combine the batched tells into a single query and add it to the buffer
+	void FlushBatchedTellQueries();
+
 	// Send query <Id>
 	void SendPrologQuery(FString Id);
 
@@ -66,6 +84,13 @@ public:
 #endif // SL_WITH_ROSBRIDGE
 
 protected:
+#if SL_WITH_ROSBRIDGE
+	// True if queries are buffered or waiting for their responses
+	bool HasPendingCommands() const;
+
+	// Close the ROSBridge connection
+	void FinishDisconnect();
+#endif // SL_WITH_ROSBRIDGE
 
 	/** Begin FTickableGameObject interface */
 	// Called after ticking all actors, DeltaTime is the time passed since the last call.
@@ -106,4 +131,32 @@ private:
 	TArray<FString> NextSolutionCommandsBuffer;
 	TArray<FString> FinishCommandsBuffer;
 
+	// Tells of the current batch
+	FSLPrologTellBatch BatchedTells;
+
+	// Combined query of the batched tells (reused between batches)
+	FString BatchedTellQuery;
+
+	// Tells of the sent batches (by query id), resent one by one if the combined query fails
+	TMap<FString, FSLPrologTellBatch> SentTellBatches;
+
+	// Time since the first tell of the current batch was added
+	float BatchedTellElapsedTime;
+
+	// Set when disconnecting, the connection is closed once the pending queries are done
+	bool bDisconnectRequested;
+
+	// Time of the disconnect request
+	double DisconnectRequestTime;
+
+	/* Constants */
+	// Maximal time a tell waits in the batch before being sent
+	constexpr static float BatchedTellWindow = 0.5f;
+
+	// Maximal number of tells combined in one query
+	constexpr static int32 BatchedTellMaxNum = 64;
+
+	// Maximal time to wait for the pending queries before disconnecting
+	constexpr static float DisconnectTimeout = 5.f;
+
 };
@@ -167,6 +167,11 @@ struct FSLSymbolicLoggerParams
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Events", meta = (editcondition = "bWriteTimelines"))
 	FLSymbolicEventsSelection TimelineEventsSelection;
 
+	/* Owl */
+	// Append the finished events to the owl file as they happen instead of writing the whole document at finish
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
+	bool bStreamOwlEvents = false;
+
 	/* ROS */
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
 	bool bPublishToROS = false;
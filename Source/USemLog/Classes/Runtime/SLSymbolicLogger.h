@@ -13,6 +13,7 @@
 
 // Forward declarations
 class ASLIndividualManager;
+class FSLOwlStreamWriter;
 
 /**
  * Subsymbolic data logger
@@ -82,6 +83,12 @@ protected:
 	// Write data to file
 	void WriteToFile();
 
+	// Get the path of the owl experiment file
+	FString GetExperimentDocFilePath() const;
+
+	// Write the document start and stream the following events to the owl file
+	void StartOwlStreaming();
+
 	// Create events doc template
 	TSharedPtr<FSLOwlExperiment> CreateEventsDocTemplate(
 		ESLOwlExperimentTemplate TemplateType, const FString& InDocId);
@@ -162,6 +169,9 @@ private:
 	// Owl document of the finished events
 	TSharedPtr<FSLOwlExperiment> ExperimentDoc;
 
+	// Appends the finished events to the owl file (if streaming)
+	TSharedPtr<FSLOwlStreamWriter> OwlStreamWriter;
+
 	// Semantic event handlers (takes input raw events, outputs finished semantic events)
 	TArray<TSharedPtr<ISLEventHandler>> EventHandlers;
 
@@ -7,6 +7,7 @@
 #include "UObject/NoExportTypes.h"
 #include "Engine/StaticMeshActor.h"
 #include "Animation/SkeletalMeshActor.h"
+#include "Async/Future.h"
 
 #include "Vision/SLVisionStructs.h"
 #include "Vision/SLVisionPoseableMeshActor.h"
@@ -20,6 +21,41 @@
 class UGameViewportClient;
 class ASLVirtualCameraView;
 class USLSkeletalDataComponent;
+class ASLIndividualManager;
+
+/**
+* Image compressed (and saved locally) in the background
+*/
+struct FSLVisionPendingImage
+{
+	// Default ctor
+	FSLVisionPendingImage() {};
+
+	// Init ctor
+	FSLVisionPendingImage(int32 InViewIdx, int32 InImageIdx, TFuture<TArray<uint8>>&& InCompressedBitmap) :
+		ViewIdx(InViewIdx), ImageIdx(InImageIdx), CompressedBitmap(MoveTemp(InCompressedBitmap)) {};
+
+	// Index of the view in the frame data
+	int32 ViewIdx;
+
+	// Index of the image in the view data
+	int32 ImageIdx;
+
+	// Result of the background compression
+	TFuture<TArray<uint8>> CompressedBitmap;
+};
+
+/**
+* Frame data waiting for its images to be compressed before being written to the database
+*/
+struct FSLVisionPendingFrame
+{
+	// Frame data with placeholder image binaries
+	FSLVisionFrameData FrameData;
+
+	// Images compressed in the background
+	TArray<FSLVisionPendingImage> Images;
+};
 
 /**
  * Replays episodes from different perspectives and view modes,
@@ -39,7 +75,7 @@ public:
 
 	// Init Logger
 	void Init(const FString& InTaskId, const FString& InEpisodeId, const FString& InServerIp, uint16 InServerPort,
-		bool bOverwriteVisionData, const FSLVisionLoggerParams& Params);
+		bool bOverwriteVisionData, const FSLVisionLoggerParams& InParams);
 
 	// Can be called if init
 	void Start(const FString& EpisodeId);
@@ -68,6 +104,9 @@ public:
 	// Get access to the poseable skeletal mesh clone from the id
 	ASLVisionPoseableMeshActor* GetPoseableSkeletalMaskCloneFromId(const FString& Id, USLSkeletalDataComponent** OutSkelDataAsset = nullptr);
 
+	// Get the number of images currently compressed and saved in the background
+	int32 GetNumPendingImages() const { return NumPendingImages; };
+
 protected:
 	// Trigger the screenshot on the game thread
 	void RequestScreenshot();
@@ -112,6 +151,9 @@ private:
 	// Create clones of the items with mask material on top, set them to hidden by default
 	bool CreateMaskClones();
 
+	// Get the individual manager from the world (or spawn a new one), provides the mask colors
+	bool SetIndividualManager();
+
 	// Init hi-res screenshot resolution
 	void InitScreenshotResolution(FIntPoint InResolution);
 
@@ -121,6 +163,15 @@ private:
 	// Apply view mode
 	void ApplyViewMode(ESLVisionViewMode Mode);
 
+	// Set the screenshot resolution and the capture region of the view mode
+	void ApplyViewModeCapture(ESLVisionViewMode Mode);
+
+	// Reset the screenshot capture region to the whole image
+	void ResetCaptureRegion();
+
+	// Convert the mask data of the (downscaled or cropped) image to full resolution bounding boxes and percentages
+	void RescaleMaskViewData(FSLVisionViewData& ViewData, int32 SizeX, int32 SizeY) const;
+
 	// Apply mask materials 
 	void ApplyMaskMaterials();
 
@@ -130,8 +181,29 @@ private:
 	// Clean exit, all the Finish() methods will be triggered
 	void QuitEditor();
 	
-	// Save the compressed screenshot image locally
-	void SaveImageLocally(const TArray<uint8>& CompressedBitmap);
+	// Compress (and save locally) the image in the background, a placeholder is added to the current view data
+	void CompressImageAsync(int32 SizeX, int32 SizeY, TArray<FColor>&& Bitmap);
+
+	// Write the frames with all their images compressed to the database (in order), wait for the pending ones if requested
+	void WriteCompletedFrames(bool bWaitForPending);
+
+	// Wait for the oldest pending images until the queue depth is within the limit
+	void WaitForPendingImagesLimit();
+
+	// Get the local path of the current screenshot image without the file extension (added after encoding)
+	FString GetLocalImagePathNoExtension() const;
+
+	// Get the mask color cache file of the level and its mask configuration (masked actors and level save time)
+	FString GetMaskColorCachePath() const;
+
+	// Overwrite the processed episode part with the command line values (multiple headless instances)
+	void ParseShardCommandLineArgs(FSLVisionLoggerParams& OutParams) const;
+
+	// Save the last frame up to which all the frames are written as the resume point (does not wait for the pending uploads)
+	void WriteProgressCheckpoint();
+
+	// Queue a copy of the last rendered frame data for the current (unchanged) frame, its images are reused
+	void QueueReferenceFrame();
 	
 	// Output progress to terminal
 	void PrintProgress() const;
@@ -163,6 +235,10 @@ private:
 	UPROPERTY() // Avoid GC
 	USLVisionOverlapCalc* OverlapCalc;
 
+	// Individuals (and their mask colors) of the world
+	UPROPERTY() // Avoid GC
+	ASLIndividualManager* IndividualManager;
+
 	// Current frame timestamp
 	float CurrTimestamp;
 
@@ -222,4 +298,70 @@ private:
 
 	// Image resolution 
 	FIntPoint Resolution;
+
+	// Images of the current frame being compressed in the background
+	TArray<FSLVisionPendingImage> CurrPendingImages;
+
+	// Finished frames waiting for their images to be compressed (in order)
+	TArray<FSLVisionPendingFrame> PendingFrames;
+
+	// Number of images currently compressed in the background (queue depth)
+	int32 NumPendingImages;
+
+	// Max number of images compressed in the background before the next screenshot waits
+	int32 MaxNumPendingImages;
+
+	// Image encoding per view mode (PNG if not set)
+	TMap<ESLVisionViewMode, ESLImageCodec> ViewModeCodecs;
+
+	// Image resolution scale per view mode (full resolution if not set)
+	TMap<ESLVisionViewMode, float> ViewModeResolutionScales;
+
+	// Region of interest of the mask images in full resolution pixels (whole image if empty)
+	FIntRect MaskROI;
+
+	// Resolution scale of the current view mode
+	float CurrResolutionScale;
+
+	// Resolution of the current view mode images
+	FIntPoint CurrScaledResolution;
+
+	// Capture region of the current view mode in scaled pixels (whole image if empty)
+	FIntRect CurrCaptureRegion;
+
+	// Tags the written frames and the progress checkpoint of the processed episode part
+	FString ShardKey;
+
+	// First frame to process (after the checkpoint if resumed)
+	int32 StartFrameIdx;
+
+	// Last frame to process
+	int32 LastFrameIdx;
+
+	// Process every n-th frame
+	int32 FrameStride;
+
+	// Number of written frames between the progress checkpoints
+	int32 CheckpointInterval;
+
+	// Number of frames written since the last checkpoint
+	int32 NumFramesSinceCheckpoint;
+
+	// Save the progress checkpoints (only used by the sharded or resumed runs)
+	bool bCheckpointProgress;
+
+	// Frame of the last saved checkpoint
+	int32 LastCheckpointFrameIdx;
+
+	// Frames without any movement reference the previous frame data instead of being rendered again
+	bool bSkipUnchangedFrames;
+
+	// Transform tolerance below which a pose is considered unchanged
+	float UnchangedFrameTolerance;
+
+	// Data of the last rendered frame (without the image binaries)
+	FSLVisionFrameData PrevRenderedFrameData;
+
+	// Number of frames referencing a previous frame instead of being rendered
+	int32 NumSkippedFrames;
 };
@@ -0,0 +1,68 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SLImageCodec.generated.h"
+
+/**
+* Image encodings
+*/
+UENUM()
+enum class ESLImageCodec : uint8
+{
+	PNG						UMETA(DisplayName = "PNG"),
+	RawLZ4					UMETA(DisplayName = "Raw LZ4"),
+	RawZlib					UMETA(DisplayName = "Raw Zlib"),
+	MaskRLE					UMETA(DisplayName = "Mask RLE"),
+	MaskIndexed				UMETA(DisplayName = "Mask Indexed"),
+};
+
+/*
+* Encodes and decodes screenshot images, all non-PNG encodings are prefixed with a small header (codec, size)
+*/
+USTRUCT()
+struct USEMLOG_API FSLImageCodec
+{
+	GENERATED_BODY();
+
+	// Encode the bitmap with the given codec, outputs the codec actually used (e.g. PNG fallback for too many mask colors)
+	static bool Encode(ESLImageCodec Codec, int32 SizeX, int32 SizeY, const TArray<FColor>& Bitmap, TArray<uint8>& OutData, ESLImageCodec& OutUsedCodec);
+
+	// Decode the (non-PNG) image data into a bitmap
+	static bool Decode(const TArray<uint8>& Data, int32& OutSizeX, int32& OutSizeY, TArray<FColor>& OutBitmap);
+
+	// Get the codec of the encoded data (PNG if no header is found)
+	static ESLImageCodec GetCodec(const TArray<uint8>& Data);
+
+	// Get the file extension used when saving the images locally
+	static FString GetFileExtension(ESLImageCodec Codec);
+
+private:
+	// Append the header to the data
+	static void WriteHeader(ESLImageCodec Codec, int32 SizeX, int32 SizeY, int32 RawPayloadSize, TArray<uint8>& OutData);
+
+	// Read the header from the data, returns false if the header is not valid
+	static bool ReadHeader(const TArray<uint8>& Data, ESLImageCodec& OutCodec, int32& OutSizeX, int32& OutSizeY, int32& OutRawPayloadSize);
+
+	// Append the compressed buffer to the data
+	static bool CompressPayload(FName FormatName, const uint8* RawPayload, int32 RawPayloadSize, TArray<uint8>& OutData);
+
+	// Decompress the payload following the header
+	static bool UncompressPayload(FName FormatName, const TArray<uint8>& Data, int32 RawPayloadSize, TArray<uint8>& OutRawPayload);
+
+	/* Encodings */
+	// Run length encoding of the pixels (run length and color pairs)
+	static void EncodeMaskRLE(const TArray<FColor>& Bitmap, TArray<uint8>& OutRawPayload);
+
+	// Palette of the colors followed by the per pixel palette indexes
+	static bool EncodeMaskIndexed(const TArray<FColor>& Bitmap, TArray<uint8>& OutRawPayload);
+
+	/* Decodings */
+	// Decode the run length encoded pixels
+	static bool DecodeMaskRLE(const uint8* RawPayload, int32 RawPayloadSize, int32 NumPixels, TArray<FColor>& OutBitmap);
+
+	// Decode the palette indexed pixels
+	static bool DecodeMaskIndexed(const uint8* RawPayload, int32 RawPayloadSize, int32 NumPixels, TArray<FColor>& OutBitmap);
+};
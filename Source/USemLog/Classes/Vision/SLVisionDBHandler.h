@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "Vision/SLVisionStructs.h"
 #include "Animation/SkeletalMeshActor.h"
+#include "Mongo/SLGridFsUploader.h"
 
 #if SL_WITH_LIBMONGO_C
 class ASLVisionPoseableMeshActor;
@@ -18,6 +19,21 @@ THIRD_PARTY_INCLUDES_START
 	#include <mongoc/mongoc.h>
 	#endif // #if PLATFORM_WINDOWS
 THIRD_PARTY_INCLUDES_END
+
+/**
+* Frame document waiting for its image uploads
+*/
+struct FSLVisionPendingFrameDoc
+{
+	// Frame document and its image files (no document if the frame was skipped)
+	FSLGridFsPendingDoc PendingDoc;
+
+	// Episode frame index
+	int32 FrameIdx;
+
+	// Frame timestamp
+	float Timestamp;
+};
 #endif //SL_WITH_LIBMONGO_C
 
 /**
@@ -29,12 +45,16 @@ public:
 	// Ctor
 	FSLVisionDBHandler();
 
-	// Connect to the database
+	// Connect to the database (keep the previous entries if the collection is shared between multiple instances or resumed)
 	bool Connect(const FString& DBName, const FString& CollName, const FString& ServerIp,
-		uint16 ServerPort, bool bRemovePrevEntries);
+		uint16 ServerPort, bool bRemovePrevEntries, bool bKeepPrevEntries = false);
+
+	// Disconnect and clean db connection (pending image uploads are finished first)
+	void Disconnect();
 
-	// Disconnect and clean db connection
-	void Disconnect() const;
+	// Block until all the queued image uploads are written and write the frames referencing them,
+	// return false on timeout (the frames stay pending) or if frames were skipped because of failed uploads
+	bool FlushUploads();
 
 	// Create indexes on the inserted data
 	void CreateIndexes() const;
@@ -44,8 +64,27 @@ public:
 		ASLVisionPoseableMeshActor*>& InSkelToPoseableMap,
 		FSLVisionEpisode& OutEpisode);
 
-	// Write current frame
-	void WriteFrame(const FSLVisionFrameData& Frame) const;
+	// Write current frame (the images are uploaded in the background), tagged with the shard key if not empty,
+	// frames referencing a previous frame reuse the image files of the last written frame, return false if the frame was skipped
+	bool WriteFrame(const FSLVisionFrameData& Frame, const FString& ShardKey = FString());
+
+	// Get the last checkpointed frame of the shard, return false if no checkpoint exists
+	bool GetCheckpoint(const FString& ShardKey, int32& OutFrameIdx) const;
+
+	// Save the last completely written frame of the shard
+	bool WriteCheckpoint(const FString& ShardKey, int32 FrameIdx, float Timestamp) const;
+
+	// Get the last frame up to which all the frames are written, return false if there is none
+	bool GetLastContiguousWrittenFrame(int32& OutFrameIdx, float& OutTimestamp) const;
+
+	// Remove the frames of the shard written after the given frame (all of them and the checkpoint if INDEX_NONE)
+	void RemoveShardEntries(const FString& ShardKey, int32 AfterFrameIdx) const;
+
+	// Write the frames with the compact schema (dictionary indexed entities, packed binary entity data)
+	void SetCompactFrames(bool bValue) { bCompactFrames = bValue; };
+
+	// Get the written vision frames (of the shard if not empty) in both schemas, the image binaries are not downloaded
+	bool GetVisionFrames(TArray<FSLVisionFrameData>& OutFrames, const FString& ShardKey = FString()) const;
 
 private:
 	// Remove any previously added vision data from the database
@@ -65,8 +104,9 @@ private:
 		const TMap<ASkeletalMeshActor*, ASLVisionPoseableMeshActor*>& InSkelToPoseableMap,
 		TMap<ASLVisionPoseableMeshActor*, TMap<FName, FTransform>>& OutSkeletalPoses) const;
 
-	// Save image to gridfs, get the file oid and return true if succeeded
-	bool AddToGridFs(const TArray<uint8>& InData, bson_oid_t* out_oid) const;
+	// Save image to gridfs (queued if the uploader is running, counted in the frame pending files), get the file oid and return true if succeeded
+	bool AddToGridFs(const TArray<uint8>& InData, bson_oid_t* out_oid,
+		const TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe>& NumFramePendingFiles);
 
 	// Write the bson doc containing the vision data to the entry corresponding to the timestamp
 	bool WriteToWorldColl_Legacy(bson_t* doc, float Timestamp) const;
@@ -74,11 +114,72 @@ private:
 	// Write the bson doc containing the vision data to the entry corresponding to the timestamp
 	bool WriteToVisionColl(bson_t* doc) const;
 
+	// Write the frames waiting for their image uploads in order, stop at the first frame with unfinished uploads (if only the uploaded are written),
+	// skip the ones referencing failed uploads, return false if any frame was skipped
+	bool WritePendingFrames(bool bOnlyUploaded);
+
+	// Track the last frame up to which all the frames are written, a missing frame stops the tracking
+	void OnFrameWritten(int32 FrameIdx, float Timestamp, bool bWritten);
+
+	// Add the entities, skeletal entities and bones of the view as packed binaries with dictionary indexes
+	void AddCompactEntitiesData(const FSLVisionViewData& ViewData, bson_t* doc);
+
+	// Get the dictionary index of the entity (bones have an empty id), new entries are appended
+	int32 GetEntityDictIdx(const FString& Id, const FString& Class);
+
+	// Load the entity dictionary entries (id, class)
+	bool LoadEntityDict(const FString& DictId, TArray<TPair<FString, FString>>& OutEntries) const;
+
+	// Save the entity dictionary if new entries were added
+	bool WriteEntityDict();
+
+	// Decode the frame document (verbose or compact schema)
+	bool GetFrameData(const bson_t* doc, TMap<FString, TArray<TPair<FString, FString>>>& InOutDicts, FSLVisionFrameData& OutFrame) const;
+
+	// Decode the packed entities of the view
+	void GetCompactEntitiesData(bson_iter_t* view_iter, const TArray<TPair<FString, FString>>& Dict, FSLVisionViewData& OutViewData) const;
+
+	// Decode the verbose entities of the view
+	void GetVerboseEntitiesData(bson_iter_t* view_iter, FSLVisionViewData& OutViewData) const;
+
+	// Get the bounding box from the document
+	void GetBBObj(bson_iter_t* iter, FIntPoint& OutMin, FIntPoint& OutMax) const;
+
+	// Add the image size and region to the document if they differ from the frame resolution
+	void AddImageSizeObj(const FSLVisionImageData& Img, bson_t* doc) const;
+
 	// Add image bounding box to document
 	void AddBBObj(const FIntPoint& Min, const FIntPoint& Max, bson_t* doc) const;
 #endif //SL_WITH_LIBMONGO_C
 
 private:
+	// Uploads the images in the background
+	FSLGridFsUploader Uploader;
+
+	// Write the frames with the compact schema
+	bool bCompactFrames;
+
+	// Dictionary of the compact frames entities (id, class)
+	TArray<TPair<FString, FString>> EntityDict;
+
+	// Entity key to dictionary index
+	TMap<FString, int32> EntityDictIndexes;
+
+	// Number of dictionary entries already in the database
+	int32 NumSavedEntityDictEntries;
+
+	// Id of the dictionary document (one per shard)
+	FString EntityDictId;
+
+	// Last frame up to which all the frames are written
+	int32 LastContiguousFrameIdx;
+
+	// Timestamp of the last frame up to which all the frames are written
+	float LastContiguousTimestamp;
+
+	// Set if a frame could not be written
+	bool bFrameMissing;
+
 #if SL_WITH_LIBMONGO_C
 	// Server uri
 	mongoc_uri_t* uri;
@@ -95,7 +196,19 @@ private:
 	// Vision collection
 	mongoc_collection_t* vis_collection;
 
+	// Progress checkpoints of the (sharded) vision logging
+	mongoc_collection_t* progress_collection;
+
+	// Entity dictionaries of the compact frames
+	mongoc_collection_t* dict_collection;
+
 	// Store image binaries
 	mongoc_gridfs_t* gridfs;
+
+	// Image types and file ids of every view of the last written frame (reused by the unchanged frames)
+	TArray<TArray<TPair<FString, bson_oid_t>>> PrevImageFiles;
+
+	// Frames written once their images are uploaded (in the order of the frames)
+	TArray<FSLVisionPendingFrameDoc> PendingFrameDocs;
 #endif //SL_WITH_LIBMONGO_C	
 };
@@ -7,6 +7,9 @@
 #include "Engine/StaticMeshActor.h"
 #include "SLVisionStructs.h"
 
+// Forward declarations
+class ASLIndividualManager;
+
 /**
 * Image pixel color related data, convenient mapping of mask colors to their semantic data
 */
@@ -88,8 +91,8 @@ public:
 	// Ctor
 	FSLVisionMaskImageHandler();
 
-	// Load the color to entities mapping
-	bool Init();
+	// Load the color to entities mapping, reuse the mapping cached in the file if its checksum is valid (rebuilt from the individuals and saved otherwise)
+	bool Init(ASLIndividualManager* IndividualManager, const FString& CacheFilePath = FString());
 
 	// Clear init flag and mappings
 	void Reset();
@@ -98,6 +101,35 @@ public:
 	void GetDataAndRestoreImage(TArray<FColor>& MaskBitmap, int32 ImgWidth, int32 ImgHeight, FSLVisionViewData& OutViewData) const;
 
 private:
+	// Build the rendered (calibrated) color to individual and bone mappings from the visible individuals
+	void BuildColorMappings(ASLIndividualManager* IndividualManager);
+
+	// Load the rendered color mappings from the cache file, returns false if missing, outdated or corrupt
+	bool LoadColorMappings(const FString& CacheFilePath);
+
+	// Save the rendered color mappings to the cache file
+	bool SaveColorMappings(const FString& CacheFilePath) const;
+
+	// Build the flat color lookup table from the rendered color mappings
+	void BuildColorLUT();
+
+	// Get the index of the rendered color in the lookup table (INDEX_NONE if the color is not mapped)
+	FORCEINLINE int32 FindColorLUTIndex(const FColor& RenderedColor) const
+	{
+		int32 Idx = ColorLUT[GetQuantizedColorKey(RenderedColor)];
+		while (Idx != INDEX_NONE && LUTRenderedColors[Idx] != RenderedColor)
+		{
+			Idx = LUTNextInBucket[Idx];
+		}
+		return Idx;
+	}
+
+	// Quantize the color to a 16 bit (5-6-5) lookup table key
+	FORCEINLINE static int32 GetQuantizedColorKey(const FColor& C)
+	{
+		return ((C.R >> 3) << 11) | ((C.G >> 2) << 5) | (C.B >> 3);
+	}
+
 	/* Helper functions */
 	// Restore the color of the pixel to its original mask value (offseted by screenshot rendering artifacts), returns true if restoration happened
 	bool RestoreColorValueFromArray(FColor& PixelColor, const TArray<FColor>& InOriginalMaskColors, uint8 Tolerance = 13) const;
@@ -117,4 +149,26 @@ private:
 
 	// Rendered color to skeletal entity data
 	TMap<FColor, FSLVisionMaskSkelInfo> RenderedColorToSkelInfo;
+
+	/* Flat lookup table, built once at init */
+	// Number of quantized color buckets
+	static constexpr int32 ColorLUTSize = 1 << 16;
+
+	// Quantized color key to the first color index in the bucket
+	TArray<int32> ColorLUT;
+
+	// Next color index with the same quantized key (INDEX_NONE terminated)
+	TArray<int32> LUTNextInBucket;
+
+	// Rendered colors (exact match check for the quantized keys)
+	TArray<FColor> LUTRenderedColors;
+
+	// Original mask colors used for restoring the image
+	TArray<FColor> LUTOriginalColors;
+
+	// Entity data of the color indexes [0, LUTEntityInfos.Num())
+	TArray<FSLVisionMaskEntityInfo> LUTEntityInfos;
+
+	// Skeletal data of the color indexes [LUTEntityInfos.Num(), LUTRenderedColors.Num())
+	TArray<FSLVisionMaskSkelInfo> LUTSkelInfos;
 };
@@ -14,8 +14,68 @@ class USLVisionLogger;
 class AStaticMeshActor;
 class UMaterialInterface;
 class UMaterial;
+class UStaticMesh;
+class UPoseableMeshComponent;
+class FSkeletalMeshLODRenderData;
 //class USLSkeletalDataComponent;
 
+/**
+* Mesh vertex positions and triangle indexes used for the CPU silhouette rasterization
+*/
+struct FSLVisionMeshGeometry
+{
+	// Vertex positions (component space)
+	TArray<FVector> Positions;
+
+	// Triangle list indexes
+	TArray<uint32> Indices;
+};
+
+/**
+* Mesh item rasterized by one of the parallel analytic overlap tasks
+*/
+struct FSLVisionRasterItem
+{
+	// Geometry of the mesh
+	const FSLVisionMeshGeometry* Geometry;
+
+	// Component to clip space transform
+	FMatrix LocalToClip;
+
+	// Static entity data to write the results to (if static)
+	FSLVisionViewEntityData* Entity;
+
+	// Skeletal entity data to write the results to (if skeletal)
+	FSLVisionViewSkelData* SkelEntity;
+
+	// Render sections of the skeletal mesh (bone lookup)
+	const FSkeletalMeshLODRenderData* LODData;
+
+	// Material index of every bone of the skeletal entity (INDEX_NONE if unknown)
+	TArray<int32> BoneMaterialIndexes;
+
+	// Default ctor
+	FSLVisionRasterItem() : Geometry(nullptr), Entity(nullptr), SkelEntity(nullptr), LODData(nullptr) {};
+};
+
+/**
+* Per task buffers of the analytic rasterization
+*/
+struct FSLVisionRasterBuffer
+{
+	// Clip space positions of the currently rasterized mesh
+	TArray<FVector4> ClipVertices;
+
+	// Per pixel stamp of the last silhouette covering it (avoids clearing the buffer between silhouettes)
+	TArray<int32> CoverageStamps;
+
+	// Stamp of the currently rasterized silhouette
+	int32 CurrCoverageStamp;
+
+	// Default ctor
+	FSLVisionRasterBuffer() : CurrCoverageStamp(0) {};
+};
+
 /**
  * Calculates overlap percentages for entities in an image
  */
@@ -31,10 +91,13 @@ public:
 	// Destructor
 	~USLVisionOverlapCalc();
 
-	// Give control to the overlap calc to pause and start its parent (vision logger)
-	void Init(USLVisionLogger* InParent, FIntPoint InResolution, const FString& InSaveLocallyPath = FString());
+	// Give control to the overlap calc to pause and start its parent (vision logger),
+	// if analytic, the non-occluded silhouettes are rasterized on the CPU instead of rendering an extra screenshot per item,
+	// if compare, both methods run on the same frame and the per item difference is logged (screenshot results are kept)
+	void Init(USLVisionLogger* InParent, FIntPoint InResolution, const FString& InSaveLocallyPath = FString(),
+		bool bInAnalytic = false, bool bInCompare = false);
 
-	// Calculate overlaps for the given scene
+	// Calculate overlaps for the given scene (analytic overlaps are calculated right away, without pausing the parent)
 	void Start(struct FSLVisionViewData* CurrViewData, float Timestamp, int32 FrameIdx);
 
 	// Reset all flags and temporaries, called when the scene overlaps are calculated, this un-pauses the parent as well
@@ -93,6 +156,41 @@ private:
 	// Calculate overlap
 	void CalculateOverlap(const TArray<FColor>& NonOccludedImage, int32 ImgWidth, int32 ImgHeight);
 
+	/* Overlaps comparison */
+	// Store the analytic overlaps of the view before they are overwritten by the screenshot ones
+	void StoreAnalyticOverlaps(const FSLVisionViewData* CurrViewData);
+
+	// Log the difference between the screenshot and the analytic occlusion percentage of the item
+	void CompareWithAnalyticOverlap(const FString& ItemKey, float OcclusionPercentage);
+
+	/* Analytic overlaps */
+	// Calculate the overlaps of all the items in the view from their rasterized silhouettes (no extra renders)
+	void CalculateOverlapsAnalytic(FSLVisionViewData* CurrViewData);
+
+	// Get the view projection matrix of the scene view rendered by the viewport
+	bool GetViewProjectionMatrix(FMatrix& OutViewProjectionMatrix) const;
+
+	// Get the (cached) LOD0 geometry of the static mesh
+	const FSLVisionMeshGeometry* GetStaticMeshGeometry(UStaticMesh* StaticMesh);
+
+	// Get the currently skinned LOD0 geometry of the poseable mesh, returns the render data for the section lookup
+	const FSkeletalMeshLODRenderData* GetSkinnedGeometry(UPoseableMeshComponent* PMC, FSLVisionMeshGeometry& OutGeometry);
+
+	// Rasterize the item and write its overlap results (thread safe, the buffer is owned by the calling task)
+	void RasterizeItem(const FSLVisionRasterItem& Item, FSLVisionRasterBuffer& Buffer) const;
+
+	// Project the vertex positions to clip space into the projection buffer
+	static void ProjectVertices(const TArray<FVector>& Positions, const FMatrix& LocalToClip, FSLVisionRasterBuffer& Buffer);
+
+	// Rasterize the triangles of the projected vertices with the current coverage stamp, returns the number of newly covered pixels
+	int64 RasterizeTriangles(const TArray<uint32>& Indices, int32 FirstIndex, int32 NumIndices, FSLVisionRasterBuffer& Buffer, bool& bOutIsClipped) const;
+
+	// Rasterize the screen space triangle with the current coverage stamp, returns the number of newly covered pixels
+	int64 RasterizeTriangle(const FVector2D& A, const FVector2D& B, const FVector2D& C, FSLVisionRasterBuffer& Buffer, bool& bOutIsClipped) const;
+
+	// Occlusion percentage from the non occluded and the visible image percentages
+	static float GetOcclusionPercentage(float NonOccImgPerc, float ImgPerc);
+
 	// Print out the progress in the terminal
 	void PrintProgress() const;
 
@@ -183,4 +281,38 @@ private:
 
 	// Current frame index from the vision logger
 	int32 CurrFrameIdx;
+
+	// Rasterize the silhouettes on the CPU instead of rendering an extra screenshot per item
+	bool bAnalytic;
+
+	// Run both overlap methods on the same frame and log the per item difference
+	bool bCompare;
+
+	// Cached LOD0 geometry of the static meshes
+	TMap<UStaticMesh*, FSLVisionMeshGeometry> StaticMeshGeometryCache;
+
+	// Skinned geometry of the skeletal meshes in the current view
+	TArray<FSLVisionMeshGeometry> SkinnedGeometries;
+
+	// Cached ref to local matrices used for skinning
+	TArray<FMatrix> CachedRefToLocals;
+
+	// Items rasterized in parallel
+	TArray<FSLVisionRasterItem> RasterItems;
+
+	// Rasterization buffers, one per parallel task
+	TArray<FSLVisionRasterBuffer> RasterBuffers;
+
+	// Analytic occlusion percentages of the current view items (compare mode)
+	TMap<FString, float> AnalyticOcclusionPercentages;
+
+	// Sum of the absolute occlusion percentage differences of the compared items
+	float SumComparedDeltas;
+
+	// Number of the compared items
+	int32 NumComparedItems;
+
+	/* Constants */
+	// Max number of parallel rasterization tasks
+	static constexpr int32 MaxNumRasterTasks = 8;
 };
@@ -4,7 +4,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Utils/SLImageCodec.h"
 #include "Engine/StaticMeshActor.h"
+#include "Components/PoseableMeshComponent.h"
 #include "Vision/SLVisionPoseableMeshActor.h"
 #include "Vision/SLVirtualCameraView.h"
 
@@ -43,8 +45,59 @@ struct FSLVisionLoggerParams
 	// Make screenshots for calculating overlaps smaller for faster logging
 	uint8 OverlapResolutionDivisor;
 
+	// Max number of images compressed and saved in the background before the next screenshot request waits
+	int32 MaxNumPendingImages;
+
+	// Calculate the overlaps from CPU rasterized silhouettes instead of rendering an extra screenshot per item
+	bool bAnalyticOverlaps;
+
+	// Calculate the overlaps with both methods on the same frame and log the per item difference (validation of the analytic overlaps)
+	bool bCompareOverlaps;
+
+	// Image encoding per view mode (PNG if not set)
+	TMap<ESLVisionViewMode, ESLImageCodec> ViewModeCodecs;
+
+	// First episode frame to process (shard start)
+	int32 FirstFrameIdx;
+
+	// Last episode frame to process (INDEX_NONE means until the end of the episode)
+	int32 LastFrameIdx;
+
+	// Process every n-th frame starting from the first one (e.g. N instances with FirstFrameIdx=0..N-1 and FrameStride=N)
+	int32 FrameStride;
+
+	// Ids of the virtual cameras to process (all if empty)
+	TArray<FString> CameraIds;
+
+	// Continue after the last checkpointed frame of the same shard
+	bool bResume;
+
+	// Number of written frames between the progress checkpoints
+	int32 CheckpointInterval;
+
+	// Frames without any entity, bone or camera movement reference the previous frame data instead of being rendered again
+	bool bSkipUnchangedFrames;
+
+	// Transform tolerance below which a pose is considered unchanged
+	float UnchangedFrameTolerance;
+
+	// Reuse the rendered mask color to entity and bone mappings cached on disk (per level and mask configuration)
+	bool bCacheMaskColors;
+
+	// Image resolution scale per view mode (full resolution if not set)
+	TMap<ESLVisionViewMode, float> ViewModeResolutionScales;
+
+	// Region of interest of the mask images in full resolution pixels (whole image if empty)
+	FIntRect MaskROI;
+
+	// Write the entities as packed binaries referencing a per shard id/class dictionary instead of verbose sub documents
+	bool bCompactFrames;
+
 	// Default ctor
-	FSLVisionLoggerParams() {};
+	FSLVisionLoggerParams() : MaxNumPendingImages(8), bAnalyticOverlaps(false), bCompareOverlaps(false),
+		FirstFrameIdx(0), LastFrameIdx(INDEX_NONE), FrameStride(1), bResume(false), CheckpointInterval(10),
+		bSkipUnchangedFrames(false), UnchangedFrameTolerance(KINDA_SMALL_NUMBER), bCacheMaskColors(false),
+		bCompactFrames(false) {};
 
 	// Init ctor
 	FSLVisionLoggerParams(
@@ -52,13 +105,37 @@ struct FSLVisionLoggerParams
 		FIntPoint InResolution,
 		bool bInIncludeLocally,
 		bool InCalculateOverlaps,
-		uint8 InOverlapResolutionDivisor) :
+		uint8 InOverlapResolutionDivisor,
+		int32 InMaxNumPendingImages = 8,
+		bool bInAnalyticOverlaps = false) :
 		UpdateRate(InUpdateRate),
 		Resolution(InResolution),
 		bIncludeLocally(bInIncludeLocally),
 		bCalculateOverlaps(InCalculateOverlaps),
-		OverlapResolutionDivisor(InOverlapResolutionDivisor)
+		OverlapResolutionDivisor(InOverlapResolutionDivisor),
+		MaxNumPendingImages(InMaxNumPendingImages),
+		bAnalyticOverlaps(bInAnalyticOverlaps),
+		bCompareOverlaps(false),
+		FirstFrameIdx(0),
+		LastFrameIdx(INDEX_NONE),
+		FrameStride(1),
+		bResume(false),
+		CheckpointInterval(10),
+		bSkipUnchangedFrames(false),
+		UnchangedFrameTolerance(KINDA_SMALL_NUMBER),
+		bCacheMaskColors(false),
+		bCompactFrames(false)
 	{};
+
+	// Check if only a part of the episode is processed (multiple instances write to the same collection)
+	bool IsSharded() const { return FirstFrameIdx > 0 || LastFrameIdx != INDEX_NONE || FrameStride > 1 || CameraIds.Num() > 0; };
+
+	// Unique key of the processed episode part, used to tag the written frames and the progress checkpoint
+	FString GetShardKey() const
+	{
+		FString CamerasKey = CameraIds.Num() > 0 ? FString::Join(CameraIds, TEXT(",")) : TEXT("all");
+		return FString::Printf(TEXT("f%d-%d_s%d_c%s"), FirstFrameIdx, LastFrameIdx, FrameStride, *CamerasKey);
+	}
 };
 
 /**
@@ -118,6 +195,51 @@ struct FSLVisionFrame
 		return Timestamp;
 	}
 
+	// Check if applying the transformations would move anything (within the tolerance)
+	bool HasChanges(float Tolerance) const
+	{
+		for (const auto& Pair : ActorPoses)
+		{
+			if (!Pair.Value.Equals(Pair.Key->GetActorTransform(), Tolerance))
+			{
+				return true;
+			}
+		}
+
+		for (const auto& Pair : SkeletalPoses)
+		{
+			UPoseableMeshComponent* PMC = Pair.Key->GetPoseableMeshComponent();
+			for (const auto& BonePair : Pair.Value)
+			{
+				if (!BonePair.Value.Equals(PMC->GetBoneTransformByName(BonePair.Key, EBoneSpaces::WorldSpace), Tolerance))
+				{
+					return true;
+				}
+			}
+		}
+
+		for (const auto& Pair : VisionCameraPoses)
+		{
+			if (!Pair.Value.Equals(Pair.Key->GetActorTransform(), Tolerance))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Add the poses of the given (later) frame, overwriting the existing ones
+	void Append(const FSLVisionFrame& Other)
+	{
+		Timestamp = Other.Timestamp;
+		ActorPoses.Append(Other.ActorPoses);
+		VisionCameraPoses.Append(Other.VisionCameraPoses);
+		for (const auto& Pair : Other.SkeletalPoses)
+		{
+			SkeletalPoses.FindOrAdd(Pair.Key).Append(Pair.Value);
+		}
+	}
+
 	// Clear time and poses
 	void Clear() { Timestamp = -1.f; ActorPoses.Empty(); SkeletalPoses.Empty(); VisionCameraPoses.Empty(); };
 };
@@ -155,6 +277,51 @@ public:
 		return false;
 	}
 
+	// Move actors to the given frame, the frames only store the changes, so all the frames in between are applied as well
+	bool SetupFrame(int32 InFrameIdx,
+		float& OutTimestamp,
+		bool bIncludeMasks,
+		TMap<AStaticMeshActor*, AStaticMeshActor*>& MaskClones,
+		TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones)
+	{
+		if (!Frames.IsValidIndex(InFrameIdx))
+		{
+			FrameIdx = INDEX_NONE;
+			return false;
+		}
+
+		// Seek from the active frame if possible, otherwise replay from the beginning
+		int32 Idx = (FrameIdx == INDEX_NONE || FrameIdx > InFrameIdx) ? 0 : FMath::Min(FrameIdx + 1, InFrameIdx);
+		for (; Idx <= InFrameIdx; ++Idx)
+		{
+			OutTimestamp = Frames[Idx].ApplyTransformations(bIncludeMasks, MaskClones, SkelMaskClones);
+		}
+		FrameIdx = InFrameIdx;
+		return true;
+	}
+
+	// Check if moving from the active frame to the given one changes any pose (within the tolerance)
+	bool HasChanges(int32 InFrameIdx, float Tolerance) const
+	{
+		if (FrameIdx == INDEX_NONE || InFrameIdx <= FrameIdx || !Frames.IsValidIndex(InFrameIdx))
+		{
+			return true;
+		}
+
+		if (InFrameIdx == FrameIdx + 1)
+		{
+			return Frames[InFrameIdx].HasChanges(Tolerance);
+		}
+
+		// Only the latest poses of the frames in between are relevant
+		FSLVisionFrame MergedFrame;
+		for (int32 Idx = FrameIdx + 1; Idx <= InFrameIdx; ++Idx)
+		{
+			MergedFrame.Append(Frames[Idx]);
+		}
+		return MergedFrame.HasChanges(Tolerance);
+	}
+
 	// Move actors to the next frame transformations, return false if no more frames are available
 	bool SetupNextFrame(float& OutTimestamp,
 		bool bIncludeMasks,
@@ -341,6 +508,12 @@ struct FSLVisionImageData
 
 	// Data
 	TArray<uint8> Data;
+
+	// Image size if it differs from the frame resolution (downscaled or cropped)
+	FIntPoint Size = FIntPoint::ZeroValue;
+
+	// Region of the frame covered by the image in full resolution pixels (empty if the whole frame)
+	FIntRect Region;
 };
 
 /**
@@ -393,6 +566,12 @@ struct FSLVisionFrameData
 	// Timestamp of the frame
 	float Timestamp = 0.f;
 
+	// Index of the frame in the episode
+	int32 FrameIdx = INDEX_NONE;
+
+	// Index of the frame whose images are reused (nothing changed since), INDEX_NONE if rendered
+	int32 RefFrameIdx = INDEX_NONE;
+
 	// Resolution of the images
 	FIntPoint Resolution;
 
@@ -400,10 +579,12 @@ struct FSLVisionFrameData
 	TArray<FSLVisionViewData> Views;
 
 	// Set the initial values
-	void Init(float InTimestamp, const FIntPoint& InResolution)
+	void Init(float InTimestamp, const FIntPoint& InResolution, int32 InFrameIdx = INDEX_NONE)
 	{
 		Timestamp = InTimestamp;
 		Resolution = InResolution;
+		FrameIdx = InFrameIdx;
+		RefFrameIdx = INDEX_NONE;
 	}
 
 	// Clear data
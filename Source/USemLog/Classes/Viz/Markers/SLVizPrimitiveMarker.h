@@ -51,6 +51,12 @@ protected:
 	// Virtual add instances function
 	virtual void AddInstancesChecked(const TArray<FTransform>& Poses) override;
 
+	// Virtual batch update instances transforms
+	virtual bool BatchUpdateInstancesTransformsChecked(int32 StartIndex, const TArray<FTransform>& Poses, bool bMarkRenderStateDirty = true) override;
+
+	// Copy the poses with the marker scale into the scaled poses buffer
+	void SetScaledPoses(const TArray<FTransform>& Poses);
+
 	// Get the static mesh of the primitive type
 	UStaticMesh* GetPrimitiveStaticMesh(ESLVizPrimitiveMarkerType InType) const;
 
@@ -60,4 +66,7 @@ protected:
 
 	// Current visual type
 	ESLVizPrimitiveMarkerType PrimitiveType;
+
+	// Poses with the marker scale applied (avoids reallocations on every batch)
+	TArray<FTransform> ScaledPoses;
 };
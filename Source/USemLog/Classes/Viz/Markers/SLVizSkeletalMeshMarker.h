@@ -12,6 +12,32 @@
 class USkeletalMesh;
 class UPoseableMeshComponent;
 
+/*
+* Skeletal pose with the bone poses sorted by their index (parents are always before their children)
+*/
+struct FSLVizResolvedSkeletalPose
+{
+	// World pose of the mesh
+	FTransform Pose;
+
+	// World poses of the bones, sorted by bone index
+	TArray<TPair<int32, FTransform>> BonePoses;
+
+	// Default ctor
+	FSLVizResolvedSkeletalPose() {};
+
+	// Init ctor
+	FSLVizResolvedSkeletalPose(const TPair<FTransform, TMap<int32, FTransform>>& SkeletalPose) : Pose(SkeletalPose.Key)
+	{
+		BonePoses.Reserve(SkeletalPose.Value.Num());
+		for (const auto& BonePosePair : SkeletalPose.Value)
+		{
+			BonePoses.Emplace(BonePosePair.Key, BonePosePair.Value);
+		}
+		BonePoses.Sort([](const TPair<int32, FTransform>& A, const TPair<int32, FTransform>& B) { return A.Key < B.Key; });
+	};
+};
+
 /**
  * Class capable of visualizing skeletal meshes as arrays of poseable meshes
  */
@@ -58,6 +84,11 @@ public:
 	// Reset visuals and poses
 	virtual void Reset() override;
 
+	// Convert the world bone poses to local poses in a single pass over the bone hierarchy (parents are sorted before their children),
+	// bones without a world pose keep their local pose, the component space poses are written to the scratch buffer
+	static void ApplyWorldBonePoses(UPoseableMeshComponent* PMC, TFunctionRef<bool(int32 BoneIdx, FTransform& OutWorldPose)> GetWorldBonePose,
+		TArray<FTransform>& ComponentSpaceBonePosesScratch);
+
 protected:
 	// Reset visual related data
 	virtual void ResetVisuals() override;
@@ -84,6 +115,12 @@ protected:
 	// Update timeline with max number of instances
 	void UpdateTimelineWithMaxNumInstances(int32 NumNewInstances);
 
+	// Update timeline by recycling the pooled instances (at most max number of instances are created)
+	void UpdatePooledTimeline(int32 NumNewInstances);
+
+	// Apply the resolved pose in a single pass over the bone hierarchy
+	void ApplyResolvedPose(UPoseableMeshComponent* PMC, const FSLVizResolvedSkeletalPose& ResolvedPose);
+
 	// Set visual without the materials (avoid boilerplate code)
 	void SetPoseableMeshComponentVisual(USkeletalMesh* SkelMesh);
 
@@ -99,6 +136,25 @@ protected:
 	UPROPERTY()
 	TArray<UPoseableMeshComponent*> PMCInstances;
 
+	// Unused instances kept for recycling (pooled mode)
+	UPROPERTY()
+	TArray<UPoseableMeshComponent*> PMCPool;
+
 	// Timeline poses
 	TArray<TPair<FTransform, TMap<int32, FTransform>>> TimelinePoses;
+
+	// Timeline poses with resolved bone order (pooled mode)
+	TArray<FSLVizResolvedSkeletalPose> ResolvedTimelinePoses;
+
+	// Recycle the instances instead of creating new ones
+	bool bUseInstancePool;
+
+	// Max number of instance updates per tick (negative values ignored)
+	int32 TimelineMaxNumUpdatesPerTick;
+
+	// Number of instance updates deferred from the previous ticks
+	int32 TimelineNumPendingUpdates;
+
+	// Component space bone poses scratch buffer (avoids reallocations when applying poses)
+	TArray<FTransform> ComponentSpaceBonePoses;
 };
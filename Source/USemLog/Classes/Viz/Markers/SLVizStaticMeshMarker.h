@@ -45,6 +45,9 @@ public:
 	// Add instances with timeline update
 	void AddInstances(const TArray<FTransform>& Poses, const FSLVizTimelineParams& TimelineParams);
 
+	// Update the transforms of the consecutive instances starting from the given index (one render state update)
+	bool BatchUpdateInstancesTransforms(int32 StartIndex, const TArray<FTransform>& Poses);
+
 	//~ Begin ActorComponent Interface
 	// Unregister the component, remove it from its outer Actor's Components array and mark for pending kill
 	virtual void DestroyComponent(bool bPromoteChildren = false) override;
@@ -71,6 +74,9 @@ protected:
 	// Virtual add instances function
 	virtual void AddInstancesChecked(const TArray<FTransform>& Poses);
 
+	// Virtual batch update instances transforms
+	virtual bool BatchUpdateInstancesTransformsChecked(int32 StartIndex, const TArray<FTransform>& Poses, bool bMarkRenderStateDirty = true);
+
 	// Clear the timeline and the related members
 	void ClearAndStopTimeline();
 
@@ -87,4 +93,7 @@ protected:
 
 	// Timeline poses
 	TArray<FTransform> TimelinePoses;
+
+	// Poses of the current timeline update (avoids reallocations every tick)
+	TArray<FTransform> TimelineBatchPoses;
 };
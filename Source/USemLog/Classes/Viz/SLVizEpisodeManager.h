@@ -107,7 +107,7 @@ public:
 	// Set visual world as in the given frame 
 	bool GotoFrame(int32 FrameIndex);
 
-	// Set visual world as in the given timestamp (binary search for nearest index)
+	// Set visual world as in the given timestamp (searches from the active frame, binary search for large jumps)
 	bool GotoFrame(float Timestamp);
 
 	// Play episode
@@ -122,8 +122,8 @@ public:
 	// Play the episode timeline
 	bool PlayTimeline(float StartTime, float EndTime);
 
-	// Set replay parameters (loop replay, frame update rate, number of steps per frame)
-	void SetReplayParams(bool bLoop, float UpdateRate = -1.f, int32 StepSize = 1);
+	// Set replay parameters (loop replay, frame update rate, number of steps per frame, interpolate between frames)
+	void SetReplayParams(bool bLoop, float UpdateRate = -1.f, int32 StepSize = 1, bool bInterpolate = false);
 
 	// Set replay to pause or play
 	void SetPauseReplay(bool bPause);
@@ -138,9 +138,24 @@ private:
 	// Apply frame poses
 	void ApplyPoses(const FSLVizEpisodeFrameData& Frame);
 
+	// Apply only the poses which changed between the two frames (works in both directions)
+	void ApplyFrameChanges(int32 FromFrameIndex, int32 ToFrameIndex);
+
+	// Apply the bone poses of the poseable mesh component
+	void ApplyBonePoses(UPoseableMeshComponent* PMC, const TMap<int32, FTransform>& BonePoses);
+
+	// Find the frame index of the timestamp by stepping from the active frame (binary search for large jumps)
+	int32 FindFrameIndexFromActiveFrame(float Timestamp) const;
+
 	// Apply next frame changes (return false if there are no more frames)
 	bool ApplyNextFrameChanges();
 
+	// Advance the replay time and apply the interpolated poses (return false if there are no more frames)
+	bool ApplyInterpolatedFrameChanges(float DeltaTime);
+
+	// Apply the blended poses between the two frames (Alpha=0 -> FrameA, Alpha=1 -> FrameB)
+	void ApplyInterpolatedPoses(const FSLVizEpisodeFrameData& FrameA, const FSLVizEpisodeFrameData& FrameB, float Alpha);
+
 	// Calculate an approximation of the update rate value to coincide with realtime
 	void CalcRealtimeAproxUpdateRateValue(int32 MaxNumSteps);
 
@@ -157,6 +172,12 @@ protected:
 	// True if it currently in an active replay
 	uint8 bReplayRunning : 1;
 
+	// True if the replay should interpolate between the frames every tick
+	uint8 bInterpolateReplay : 1;
+
+	// True if the applied poses are blended between the active and the next frame
+	uint8 bActiveFrameBlended : 1;
+
 	// Episode data
 	FSLVizEpisodeData EpisodeData;
 
@@ -174,6 +195,23 @@ protected:
 
 	// Default replay update rate
 	float EpisodeDefaultUpdateRate;
+
+	// Replay update rate set by the replay params (the episode default is used if not positive)
+	float ReplayUpdateRate;
+
+	// Current episode time of the interpolated replay
+	float ReplayTime;
+
+	// Actors and poseable meshes changed between two frames (avoids reallocations on every seek)
+	TSet<AActor*> ChangedActors;
+	TSet<UPoseableMeshComponent*> ChangedPMCs;
+
+	// Component space bone poses scratch buffer of the interpolated replay (avoids reallocations every tick)
+	TArray<FTransform> ComponentSpaceBonePoses;
+
+	/* Constants */
+	// Jumps larger than this apply the full frame instead of the accumulated changes
+	static constexpr int32 MaxIncrementalSeekNumFrames = 64;
 };
 
 
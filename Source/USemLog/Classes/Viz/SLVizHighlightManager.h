@@ -12,6 +12,7 @@
 class USLVizAssets;
 class UMeshComponent;
 class UMaterialInterface;
+class UMaterialInstanceDynamic;
 
 /**
  * Stores the original materials for re-applying them
@@ -30,15 +31,65 @@ struct USEMLOG_API FSLVizHighlightData
 	UPROPERTY()
 	TArray<int32> MaterialSlots;
 
+	// Pooled highlight material currently applied (released when the highlight is cleared)
+	UPROPERTY()
+	UMaterialInstanceDynamic* MID;
+
 	// Default ctor
-	FSLVizHighlightData() {};
+	FSLVizHighlightData() : MID(nullptr) {};
+
+	// Init ctor
+	FSLVizHighlightData(const TArray<UMaterialInterface*>& InMaterials) : OriginalMaterials(InMaterials), MID(nullptr) {};
+
+	// Init ctor
+	FSLVizHighlightData(const TArray<UMaterialInterface*>& InMaterials, const TArray<int32>& InMaterialSlots,
+		UMaterialInstanceDynamic* InMID = nullptr)
+		: OriginalMaterials(InMaterials), MaterialSlots(InMaterialSlots), MID(InMID) {};
+};
+
+
+/**
+ * Key of the pooled highlight materials (base material and color)
+ */
+struct FSLVizHighlightMIDKey
+{
+	// Base material of the dynamic instance (given by the material type)
+	UMaterialInterface* BaseMaterial;
+
+	// Color parameter value
+	FLinearColor Color;
 
 	// Init ctor
-	FSLVizHighlightData(const TArray<UMaterialInterface*>& InMaterials) : OriginalMaterials(InMaterials) {};
+	FSLVizHighlightMIDKey(UMaterialInterface* InBaseMaterial, const FLinearColor& InColor)
+		: BaseMaterial(InBaseMaterial), Color(InColor) {};
+
+	// Equality operator
+	bool operator==(const FSLVizHighlightMIDKey& Other) const
+	{
+		return BaseMaterial == Other.BaseMaterial && Color == Other.Color;
+	}
+
+	// Hash function
+	friend uint32 GetTypeHash(const FSLVizHighlightMIDKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.BaseMaterial), GetTypeHash(Key.Color));
+	}
+};
+
+
+/**
+ * Pooled highlight material with the number of highlights using it
+ */
+struct FSLVizPooledMID
+{
+	// Shared dynamic material instance
+	UMaterialInstanceDynamic* MID;
+
+	// Number of highlighted meshes using the instance, removed from the pool when it reaches zero
+	int32 NumUsers;
 
 	// Init ctor
-	FSLVizHighlightData(const TArray<UMaterialInterface*>& InMaterials, const TArray<int32>& InMaterialSlots) 
-		: OriginalMaterials(InMaterials), MaterialSlots(InMaterialSlots){};
+	FSLVizPooledMID(UMaterialInstanceDynamic* InMID) : MID(InMID), NumUsers(0) {};
 };
 
 
@@ -81,6 +132,9 @@ public:
 	// Highlight the given mesh component
 	void Highlight(UMeshComponent* MC, const FSLVizVisualParams& VisualParams = FSLVizVisualParams());
 
+	// Highlight the given mesh components with the same visual parameters
+	void Highlight(const TArray<UMeshComponent*>& MCs, const FSLVizVisualParams& VisualParams = FSLVizVisualParams());
+
 	// Update the visual of the given mesh component
 	void UpdateHighlight(UMeshComponent* MC, const FSLVizVisualParams& VisualParams);
 
@@ -97,8 +151,20 @@ private:
 	// Remove any bound delegates
 	void RemoveDelegates();
 
-	// Create a dynamic material instance
-	UMaterialInstanceDynamic* CreateTransientMID(ESLVizMaterialType InMaterialType);
+	// Get the base material of the given material type
+	UMaterialInterface* GetBaseMaterial(ESLVizMaterialType InMaterialType) const;
+
+	// Get a pooled dynamic material instance with the given type and color (create it if not available), adds the users to it
+	UMaterialInstanceDynamic* AcquirePooledMID(ESLVizMaterialType InMaterialType, const FLinearColor& InColor, int32 NumUsers = 1);
+
+	// Remove a user from the pooled dynamic material instance, the instance leaves the pool once it has no users
+	void ReleasePooledMID(UMaterialInstanceDynamic* MID);
+
+	// Apply the material to the given slots of the mesh (if empty, apply to all slots)
+	void ApplyMaterial(UMeshComponent* MC, UMaterialInterface* Material, const TArray<int32>& MaterialSlots);
+
+	// Remove the pooled dynamic materials
+	void ClearMIDPool();
 
 
 protected:
@@ -106,6 +172,13 @@ protected:
 	//UPROPERTY()
 	TMap<UMeshComponent*, FSLVizHighlightData> HighlightedStaticMeshes;
 
+	// Dynamic highlight materials shared between the meshes, keyed by base material and color (only the ones in use)
+	TMap<FSLVizHighlightMIDKey, FSLVizPooledMID> MIDPool;
+
+	// Keeps the pooled dynamic materials from being garbage collected
+	UPROPERTY()
+	TArray<UMaterialInstanceDynamic*> PooledMIDs;
+
 private:
 	// Viz assets container
 	USLVizAssets* VizAssetsContainer;
@@ -53,6 +53,10 @@ public:
 	bool HighlightIndividual(const FString& Id,
 		const FLinearColor& Color = FLinearColor::Green, ESLVizMaterialType MaterialType = ESLVizMaterialType::Translucent);
 
+	// Highlight the individuals in one batch (returns false if any of the individuals could not be highlighted)
+	bool HighlightIndividuals(const TArray<FString>& Ids,
+		const FLinearColor& Color = FLinearColor::Green, ESLVizMaterialType MaterialType = ESLVizMaterialType::Translucent);
+
 	// Change the visual values of the highligted individual
 	bool UpdateIndividualHighlight(const FString& Id,
 		const FLinearColor& Color, ESLVizMaterialType MaterialType = ESLVizMaterialType::Translucent);
@@ -60,6 +64,9 @@ public:
 	// Remove highlight from individual (returns false if the individual not found or it is not highlighted)
 	bool RemoveIndividualHighlight(const FString& Id);
 
+	// Remove highlights from the individuals (returns false if any of the individuals is not highlighted)
+	bool RemoveIndividualHighlights(const TArray<FString>& Ids);
+
 	// Remove all individual highlights
 	void RemoveAllIndividualHighlights();
 
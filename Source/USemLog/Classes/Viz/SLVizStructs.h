@@ -145,6 +145,10 @@ struct FSLVizEpisodePlayParams
 	UPROPERTY(EditAnywhere, Category = "Properties")
 	int32 StepSize = 1;
 
+	// Interpolate the poses between the logged frames every render tick (update rate and step size are ignored)
+	UPROPERTY(EditAnywhere, Category = "Properties")
+	bool bInterpolate = false;
+
 	// Default ctor
 	FSLVizEpisodePlayParams() {};
 
@@ -178,5 +182,13 @@ struct FSLVizTimelineParams
 	// Repeat timeline after finishing
 	UPROPERTY(EditAnywhere, Category = "Properties")
 	bool bLoop = false;
+
+	// Recycle the instance components instead of creating one for every pose (skeletal markers)
+	UPROPERTY(EditAnywhere, Category = "Properties")
+	bool bUseInstancePool = false;
+
+	// Maximum number of instance updates per tick, the rest are deferred to the following ticks (skeletal markers, negative values ignored)
+	UPROPERTY(EditAnywhere, Category = "Properties")
+	int32 MaxNumUpdatesPerTick = INDEX_NONE;
 };
 
@@ -60,6 +60,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Replay", meta = (editcondition = "Type==ESLVizQReplayType::Replay"))
 	int32 StepSize = 1;
 
+	UPROPERTY(EditAnywhere, Category = "Replay", meta = (editcondition = "Type==ESLVizQReplayType::Replay"))
+	bool bInterpolate = false;
+
 
 	/* Manual interaction */
 	UPROPERTY(EditAnywhere, Category = "Manual Interaction|Replay", meta = (editcondition = "Type==ESLVizQReplayType::Replay"))
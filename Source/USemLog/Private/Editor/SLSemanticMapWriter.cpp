@@ -54,7 +54,7 @@ bool FSLSemanticMapWriter::WriteToFile(UWorld* World,
 	// Write map to file
 	
 	FPaths::RemoveDuplicateSlashes(FullFilePath);
-	return FFileHelper::SaveStringToFile(SemMap->ToString(), *FullFilePath);
+	return SemMap->SaveToFile(FullFilePath);
 }
 
 // Create semantic map template
@@ -85,14 +85,10 @@ void FSLContactEvent::AddToOwlDoc(FSLOwlDoc* OutDoc)
 	// we cannot use the safer dynamic_cast because RTTI is not enabled by default
 	// if (FOwlEvents* EventsDoc = dynamic_cast<FOwlEvents*>(OutDoc))
 	FSLOwlExperiment* EventsDoc = static_cast<FSLOwlExperiment*>(OutDoc);
-	EventsDoc->AddTimepointIndividual(
-		StartTime, FSLOwlExperimentStatics::CreateTimepointIndividual("log", StartTime));
-	EventsDoc->AddTimepointIndividual(
-		EndTime, FSLOwlExperimentStatics::CreateTimepointIndividual("log", EndTime));
-	EventsDoc->AddObjectIndividual(Individual1,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Individual1->GetIdValue(), Individual1->GetClassValue()));
-	EventsDoc->AddObjectIndividual(Individual2,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Individual2->GetIdValue(), Individual2->GetClassValue()));
+	FSLOwlExperimentStatics::AddTimepointIndividual(EventsDoc, "log", StartTime);
+	FSLOwlExperimentStatics::AddTimepointIndividual(EventsDoc, "log", EndTime);
+	FSLOwlExperimentStatics::AddObjectIndividual(EventsDoc, "log", Individual1);
+	FSLOwlExperimentStatics::AddObjectIndividual(EventsDoc, "log", Individual2);
 	OutDoc->AddIndividual(ToOwlNode());
 }
 
@@ -70,38 +70,40 @@ void FSLContactEventHandler::Finish(float EndTime, bool bForced)
 // Start new contact event
 void FSLContactEventHandler::AddNewContactEvent(const FSLContactResult& InResult)
 {
+	// Keep the already started event with the same individual
+	const uint64 Key = InResult.Other->GetUniqueID();
+	if (StartedContactEvents.Contains(Key))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d A contact event with %s is already started, ignoring.."),
+			*FString(__FUNCTION__), __LINE__, *InResult.Other->GetParentActor()->GetName());
+		return;
+	}
+
 	// Start a semantic contact event
 	TSharedPtr<FSLContactEvent> ContactEvent = MakeShareable(new FSLContactEvent(
 		FSLUuid::NewGuidInBase64Url(), InResult.Time,
 		FSLUuid::PairEncodeCantor(InResult.Self->GetUniqueID(), InResult.Other->GetUniqueID()),
 		InResult.Self, InResult.Other));
-	// Add event to the pending contacts array
-	StartedContactEvents.Emplace(ContactEvent);
+	// Add event to the pending contacts
+	StartedContactEvents.Add(Key, ContactEvent);
 }
 
 // Publish finished event
 bool FSLContactEventHandler::FinishContactEvent(USLBaseIndividual* InOther, float EndTime)
 {
-	// Use iterator to be able to remove the entry from the array
-	for (auto EventItr(StartedContactEvents.CreateIterator()); EventItr; ++EventItr)
+	// It is enough to search using the other id (the parent is the same for all events)
+	TSharedPtr<FSLContactEvent> Event;
+	if (StartedContactEvents.RemoveAndCopyValue(InOther->GetUniqueID(), Event))
 	{
-		// It is enough to compare against the other id when searching
-		if ((*EventItr)->Individual2 == InOther)
+		// Set the event end time
+		Event->EndTime = EndTime;
+
+		// Avoid publishing short events
+		if ((Event->EndTime - Event->StartTime) > ContactEventMin)
 		{
-			// Set the event end time
-			(*EventItr)->EndTime = EndTime;
-
-			// Avoid publishing short events
-			if (((*EventItr)->EndTime - (*EventItr)->StartTime) > ContactEventMin)
-			{
-				OnSemanticEvent.ExecuteIfBound(*EventItr);
-			}
-			
-			// Remove event from the pending list
-			EventItr.RemoveCurrent();
-
-			return true;
+			OnSemanticEvent.ExecuteIfBound(Event);
 		}
+		return true;
 	}
 	return false;
 }
@@ -109,33 +111,35 @@ bool FSLContactEventHandler::FinishContactEvent(USLBaseIndividual* InOther, floa
 // Start new supported by event
 void FSLContactEventHandler::AddNewSupportedByEvent(USLBaseIndividual* Supported, USLBaseIndividual* Supporting, float StartTime, const uint64 EventPairId)
 {
+	// Keep the already started event of the same pair
+	if (StartedSupportedByEvents.Contains(EventPairId))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d A supported by event with the pair id %llu is already started, ignoring.."),
+			*FString(__FUNCTION__), __LINE__, EventPairId);
+		return;
+	}
+
 	// Start a supported by event
 	TSharedPtr<FSLSupportedByEvent> Event = MakeShareable(new FSLSupportedByEvent(
 		FSLUuid::NewGuidInBase64Url(), StartTime, EventPairId, Supported, Supporting));
-	// Add event to the pending array
-	StartedSupportedByEvents.Emplace(Event);
+	// Add event to the pending events
+	StartedSupportedByEvents.Add(EventPairId, Event);
 }
 
 // Finish then publish the event
 bool FSLContactEventHandler::FinishSupportedByEvent(const uint64 InPairId, float EndTime)
 {
-	// Use iterator to be able to remove the entry from the array
-	for (auto EventItr(StartedSupportedByEvents.CreateIterator()); EventItr; ++EventItr)
+	TSharedPtr<FSLSupportedByEvent> Event;
+	if (StartedSupportedByEvents.RemoveAndCopyValue(InPairId, Event))
 	{
-		// It is enough to compare against the other id when searching
-		if ((*EventItr)->PairId == InPairId)
+		// Ignore short events
+		if (EndTime - Event->StartTime > SupportedByEventMin)
 		{
-			// Ignore short events
-			if (EndTime - (*EventItr)->StartTime > SupportedByEventMin)
-			{
-				// Set end time and publish event
-				(*EventItr)->EndTime = EndTime;
-				OnSemanticEvent.ExecuteIfBound(*EventItr);
-			}
-			// Remove event from the pending list
-			EventItr.RemoveCurrent();
-			return true;
+			// Set end time and publish event
+			Event->EndTime = EndTime;
+			OnSemanticEvent.ExecuteIfBound(Event);
 		}
+		return true;
 	}
 	return false;
 }
@@ -143,9 +147,12 @@ bool FSLContactEventHandler::FinishSupportedByEvent(const uint64 InPairId, float
 // Terminate and publish pending contact events (this usually is called at end play)
 void FSLContactEventHandler::FinishAllEvents(float EndTime)
 {
-	// Finish contact events
-	for (auto& Ev : StartedContactEvents)
+	// Finish contact events (in the order they started)
+	StartedContactEvents.ValueSort([](const TSharedPtr<FSLContactEvent>& A, const TSharedPtr<FSLContactEvent>& B)
+		{ return A->StartTime < B->StartTime; });
+	for (auto& Pair : StartedContactEvents)
 	{
+		const TSharedPtr<FSLContactEvent>& Ev = Pair.Value;
 		// Ignore short events
 		if (EndTime - Ev->StartTime > ContactEventMin)
 		{
@@ -156,9 +163,12 @@ void FSLContactEventHandler::FinishAllEvents(float EndTime)
 	}
 	StartedContactEvents.Empty();
 
-	// Finish supported by events
-	for (auto& Ev : StartedSupportedByEvents)
+	// Finish supported by events (in the order they started)
+	StartedSupportedByEvents.ValueSort([](const TSharedPtr<FSLSupportedByEvent>& A, const TSharedPtr<FSLSupportedByEvent>& B)
+		{ return A->StartTime < B->StartTime; });
+	for (auto& Pair : StartedSupportedByEvents)
 	{
+		const TSharedPtr<FSLSupportedByEvent>& Ev = Pair.Value;
 		// Ignore short events
 		if ((EndTime - Ev->StartTime) > SupportedByEventMin)
 		{
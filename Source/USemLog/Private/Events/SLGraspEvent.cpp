@@ -44,14 +44,10 @@ void FSLGraspEvent::AddToOwlDoc(FSLOwlDoc* OutDoc)
 	// we cannot use the safer dynamic_cast because RTTI is not enabled by default
 	// if (FOwlEvents* EventsDoc = dynamic_cast<FOwlEvents*>(OutDoc))
 	FSLOwlExperiment* EventsDoc = static_cast<FSLOwlExperiment*>(OutDoc);
-	EventsDoc->AddTimepointIndividual(
-		StartTime, FSLOwlExperimentStatics::CreateTimepointIndividual("log", StartTime));
-	EventsDoc->AddTimepointIndividual(
-		EndTime, FSLOwlExperimentStatics::CreateTimepointIndividual("log", EndTime));
-	EventsDoc->AddObjectIndividual(Manipulator,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Manipulator->GetIdValue(), Manipulator->GetClassValue()));
-	EventsDoc->AddObjectIndividual(Individual,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Individual->GetIdValue(), Individual->GetClassValue()));
+	FSLOwlExperimentStatics::AddTimepointIndividual(EventsDoc, "log", StartTime);
+	FSLOwlExperimentStatics::AddTimepointIndividual(EventsDoc, "log", EndTime);
+	FSLOwlExperimentStatics::AddObjectIndividual(EventsDoc, "log", Manipulator);
+	FSLOwlExperimentStatics::AddObjectIndividual(EventsDoc, "log", Individual);
 	OutDoc->AddIndividual(ToOwlNode());
 }
 
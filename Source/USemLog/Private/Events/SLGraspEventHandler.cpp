@@ -62,35 +62,38 @@ void FSLGraspEventHandler::Finish(float EndTime, bool bForced)
 // Start new grasp event
 void FSLGraspEventHandler::AddNewEvent(USLBaseIndividual* Self, USLBaseIndividual* Other, float StartTime, const FString& InType)
 {
+	// Keep the already started event with the same individual
+	if (StartedEvents.Contains(Other->GetUniqueID()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d A grasp event with %s is already started, ignoring.."),
+			*FString(__FUNCTION__), __LINE__, *Other->GetParentActor()->GetName());
+		return;
+	}
+
 	// Start a semantic grasp event
 	TSharedPtr<FSLGraspEvent> Event = MakeShareable(new FSLGraspEvent(
 		FSLUuid::NewGuidInBase64Url(), StartTime,
 		FSLUuid::PairEncodeCantor(Self->GetUniqueID(), Other->GetUniqueID()),
 		Self, Other, InType));
-	// Add event to the pending array
-	StartedEvents.Emplace(Event);
+	// Add event to the pending events
+	StartedEvents.Add(Other->GetUniqueID(), Event);
 }
 
 // Publish finished event
 bool FSLGraspEventHandler::FinishEvent(USLBaseIndividual* Other, float EndTime)
 {
-	// Use iterator to be able to remove the entry from the array
-	for (auto EventItr(StartedEvents.CreateIterator()); EventItr; ++EventItr)
+	// It is enough to search using the other id
+	TSharedPtr<FSLGraspEvent> Event;
+	if (StartedEvents.RemoveAndCopyValue(Other->GetUniqueID(), Event))
 	{
-		// It is enough to compare against the other id when searching
-		if ((*EventItr)->Individual == Other)
+		// Ignore short events
+		if ((EndTime - Event->StartTime) > GraspEventMin)
 		{
-			// Ignore short events
-			if ((EndTime - (*EventItr)->StartTime) > GraspEventMin)
-			{
-				// Set end time and publish event
-				(*EventItr)->EndTime = EndTime;
-				OnSemanticEvent.ExecuteIfBound(*EventItr);
-			}
-			// Remove event from the pending list
-			EventItr.RemoveCurrent();
-			return true;
+			// Set end time and publish event
+			Event->EndTime = EndTime;
+			OnSemanticEvent.ExecuteIfBound(Event);
 		}
+		return true;
 	}
 	return false;
 }
@@ -98,9 +101,12 @@ bool FSLGraspEventHandler::FinishEvent(USLBaseIndividual* Other, float EndTime)
 // Terminate and publish pending events (this usually is called at end play)
 void FSLGraspEventHandler::FinishAllEvents(float EndTime)
 {
-	// Finish events
-	for (auto& Ev : StartedEvents)
+	// Finish events (in the order they started)
+	StartedEvents.ValueSort([](const TSharedPtr<FSLGraspEvent>& A, const TSharedPtr<FSLGraspEvent>& B)
+		{ return A->StartTime < B->StartTime; });
+	for (auto& Pair : StartedEvents)
 	{
+		const TSharedPtr<FSLGraspEvent>& Ev = Pair.Value;
 		// Ignore short events
 		if ((EndTime - Ev->StartTime) > GraspEventMin)
 		{
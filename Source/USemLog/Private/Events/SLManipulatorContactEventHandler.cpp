@@ -63,33 +63,36 @@ void FSLManipulatorContactEventHandler::Finish(float EndTime, bool bForced)
 // Start new contact event
 void FSLManipulatorContactEventHandler::AddNewEvent(const FSLContactResult& InResult)
 {
+	// Keep the already started event with the same individual
+	const uint64 Key = InResult.Other->GetUniqueID();
+	if (StartedEvents.Contains(Key))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d A contact event with %s is already started, ignoring.."),
+			*FString(__FUNCTION__), __LINE__, *InResult.Other->GetParentActor()->GetName());
+		return;
+	}
+
 	// Start a semantic contact event
 	TSharedPtr<FSLContactEvent> ContactEvent = MakeShareable(new FSLContactEvent(
 		FSLUuid::NewGuidInBase64Url(), InResult.Time,
 		FSLUuid::PairEncodeCantor(InResult.Self->GetUniqueID(), InResult.Other->GetUniqueID()),
 		InResult.Self, InResult.Other));
-	// Add event to the pending contacts array
-	StartedEvents.Emplace(ContactEvent);
+	// Add event to the pending contacts
+	StartedEvents.Add(Key, ContactEvent);
 }
 
 // Publish finished event
 bool FSLManipulatorContactEventHandler::FinishEvent(USLBaseIndividual* InOther, float EndTime)
 {
-	// Use iterator to be able to remove the entry from the array
-	for (auto EventItr(StartedEvents.CreateIterator()); EventItr; ++EventItr)
+	// It is enough to search using the other id
+	TSharedPtr<FSLContactEvent> Event;
+	if (StartedEvents.RemoveAndCopyValue(InOther->GetUniqueID(), Event))
 	{
-		// It is enough to compare against the other id when searching
-		if ((*EventItr)->Individual2 == InOther)
-		{
-			// Set the event end time
-			(*EventItr)->EndTime = EndTime;
-
-			OnSemanticEvent.ExecuteIfBound(*EventItr);
+		// Set the event end time
+		Event->EndTime = EndTime;
 
-			// Remove event from the pending list
-			EventItr.RemoveCurrent();
-			return true;
-		}
+		OnSemanticEvent.ExecuteIfBound(Event);
+		return true;
 	}
 	return false;
 }
@@ -97,9 +100,12 @@ bool FSLManipulatorContactEventHandler::FinishEvent(USLBaseIndividual* InOther,
 // Terminate and publish pending contact events (this usually is called at end play)
 void FSLManipulatorContactEventHandler::FinishAllEvents(float EndTime)
 {
-	// Finish contact events
-	for (auto& Ev : StartedEvents)
+	// Finish contact events (in the order they started)
+	StartedEvents.ValueSort([](const TSharedPtr<FSLContactEvent>& A, const TSharedPtr<FSLContactEvent>& B)
+		{ return A->StartTime < B->StartTime; });
+	for (auto& Pair : StartedEvents)
 	{
+		const TSharedPtr<FSLContactEvent>& Ev = Pair.Value;
 		// Set end time and publish event
 		Ev->EndTime = EndTime;
 		OnSemanticEvent.ExecuteIfBound(Ev);
@@ -70,13 +70,21 @@ void FSLSlicingEventHandler::Finish(float EndTime, bool bForced)
 // Start new Slicing event
 void FSLSlicingEventHandler::AddNewEvent(USLBaseIndividual* PerformedBy, USLBaseIndividual* DeviceUsed, USLBaseIndividual* ObjectActedOn, float StartTime)
 {
+	// Keep the already started event on the same individual
+	if (StartedEvents.Contains(ObjectActedOn->GetUniqueID()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d A slicing event on %s is already started, ignoring.."),
+			*FString(__FUNCTION__), __LINE__, *ObjectActedOn->GetParentActor()->GetName());
+		return;
+	}
+
 	// Start a semantic Slicing event
 	TSharedPtr<FSLSlicingEvent> Event = MakeShareable(new FSLSlicingEvent(
 		FSLUuid::NewGuidInBase64Url(), StartTime, 
 		FSLUuid::PairEncodeCantor(PerformedBy->GetUniqueID(), ObjectActedOn->GetUniqueID()),
 		PerformedBy, DeviceUsed, ObjectActedOn));
-	// Add event to the pending array
-	StartedEvents.Emplace(Event);
+	// Add event to the pending events
+	StartedEvents.Add(ObjectActedOn->GetUniqueID(), Event);
 }
 
 // Publish finished event
@@ -84,21 +92,16 @@ bool FSLSlicingEventHandler::FinishEvent(USLBaseIndividual* ObjectActedOn,
 	bool bInTaskSuccessful, float EndTime,
 	USLBaseIndividual* OutputsCreated)
 {
-	// Use iterator to be able to remove the entry from the array
-	for (auto EventItr(StartedEvents.CreateIterator()); EventItr; ++EventItr)
+	// It is enough to search using the object acted on id
+	TSharedPtr<FSLSlicingEvent> Event;
+	if (StartedEvents.RemoveAndCopyValue(ObjectActedOn->GetUniqueID(), Event))
 	{
-		// It is enough to compare against the other id when searching
-		if ((*EventItr)->ObjectActedOn == ObjectActedOn)
-		{
-			// Set end time and publish event
-			(*EventItr)->EndTime = EndTime;
-			(*EventItr)->bTaskSuccessful = bInTaskSuccessful;
-			(*EventItr)->CreatedSlice = OutputsCreated;
-			OnSemanticEvent.ExecuteIfBound(*EventItr);
-			// Remove event from the pending list
-			EventItr.RemoveCurrent();
-			return true;
-		}
+		// Set end time and publish event
+		Event->EndTime = EndTime;
+		Event->bTaskSuccessful = bInTaskSuccessful;
+		Event->CreatedSlice = OutputsCreated;
+		OnSemanticEvent.ExecuteIfBound(Event);
+		return true;
 	}
 	return false;
 }
@@ -106,9 +109,12 @@ bool FSLSlicingEventHandler::FinishEvent(USLBaseIndividual* ObjectActedOn,
 // Terminate and publish pending events (this usually is called at end play)
 void FSLSlicingEventHandler::FinishAllEvents(float EndTime)
 {
-	// Finish events
-	for (auto& Ev : StartedEvents)
+	// Finish events (in the order they started)
+	StartedEvents.ValueSort([](const TSharedPtr<FSLSlicingEvent>& A, const TSharedPtr<FSLSlicingEvent>& B)
+		{ return A->StartTime < B->StartTime; });
+	for (auto& Pair : StartedEvents)
 	{
+		const TSharedPtr<FSLSlicingEvent>& Ev = Pair.Value;
 		// Set end time and publish event
 		Ev->EndTime = EndTime;
 		OnSemanticEvent.ExecuteIfBound(Ev);
@@ -79,14 +79,10 @@ void FSLSupportedByEvent::AddToOwlDoc(FSLOwlDoc* OutDoc)
 	// we cannot use the safer dynamic_cast because RTTI is not enabled by default
 	// if (FOwlEvents* EventsDoc = dynamic_cast<FOwlEvents*>(OutDoc))
 	FSLOwlExperiment* EventsDoc = static_cast<FSLOwlExperiment*>(OutDoc);
-	EventsDoc->AddTimepointIndividual(StartTime,
-		FSLOwlExperimentStatics::CreateTimepointIndividual("log", StartTime));
-	EventsDoc->AddTimepointIndividual(EndTime,
-		FSLOwlExperimentStatics::CreateTimepointIndividual("log", EndTime));
-	EventsDoc->AddObjectIndividual(SupportedIndividual,
-		 FSLOwlExperimentStatics::CreateObjectIndividual("log", SupportedIndividual->GetIdValue(), SupportedIndividual->GetClassValue()));
-	EventsDoc->AddObjectIndividual(SupportingIndividual,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", SupportingIndividual->GetIdValue(), SupportingIndividual->GetClassValue()));
+	FSLOwlExperimentStatics::AddTimepointIndividual(EventsDoc, "log", StartTime);
+	FSLOwlExperimentStatics::AddTimepointIndividual(EventsDoc, "log", EndTime);
+	FSLOwlExperimentStatics::AddObjectIndividual(EventsDoc, "log", SupportedIndividual);
+	FSLOwlExperimentStatics::AddObjectIndividual(EventsDoc, "log", SupportingIndividual);
 	OutDoc->AddIndividual(ToOwlNode());
 }
 
@@ -125,6 +125,13 @@ bool FSLMetaDBHandler::Connect(const FString& DBName, const FString& ServerIp, u
 	}
 
 	bson_destroy(server_ping_cmd);
+
+	// Upload the scan images in the background with pooled connections
+	if (bScanItems && !Uploader.Start(Uri, DBName, ScansCollName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Could not start the background uploader, images will be written synchronously.."),
+			*FString(__func__), __LINE__);
+	}
 	return true;
 #else
 	UE_LOG(LogTemp, Error, TEXT("%s::%d SL_WITH_LIBMONGO_C flag is 0, aborting.."),
@@ -133,10 +140,15 @@ bool FSLMetaDBHandler::Connect(const FString& DBName, const FString& ServerIp, u
 #endif //SL_WITH_LIBMONGO_C
 }
 
-// Disconnect and clean db connection
-void FSLMetaDBHandler::Disconnect() const
+// Disconnect and clean db connection (pending image uploads are finished first)
+void FSLMetaDBHandler::Disconnect()
 {
+	Uploader.Stop();
+
 #if SL_WITH_LIBMONGO_C
+	// All uploads are finished, write the remaining scan entries
+	WritePendingScanEntries(false);
+
 	// Release handles and clean up mongoc
 	if (gridfs)
 	{
@@ -174,6 +186,21 @@ void FSLMetaDBHandler::Disconnect() const
 #endif //SL_WITH_LIBMONGO_C
 }
 
+// Block until all the queued image uploads are written and write the scan entries referencing them,
+// return false on timeout (the entries stay pending) or if entries were skipped because of failed uploads
+bool FSLMetaDBHandler::FlushUploads()
+{
+	if (!Uploader.Flush())
+	{
+		return false;
+	}
+#if SL_WITH_LIBMONGO_C
+	return WritePendingScanEntries(false);
+#else
+	return true;
+#endif //SL_WITH_LIBMONGO_C
+}
+
 // Create indexes on the inserted data
 void FSLMetaDBHandler::CreateIndexes() const
 {
@@ -267,6 +294,8 @@ void FSLMetaDBHandler::StartScanEntry(const FString& Class, int32 ResX, int32 Re
 	scan_entry_doc = bson_new();
 	scan_pose_arr = bson_new();
 	scan_pose_arr_idx = 0;
+	ScanFileOids.Reset();
+	ScanNumPendingFiles = MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>();
 
 	BSON_APPEND_UTF8(scan_entry_doc, "class", TCHAR_TO_UTF8(*Class));
 
@@ -330,7 +359,8 @@ void FSLMetaDBHandler::AddScanPoseEntry(const FSLScanPoseData& ScanPoseData)
 	BSON_APPEND_ARRAY_BEGIN(&scan_pose_doc, "images", &scan_img_arr);
 	for (const auto& Pair : ScanPoseData.Images)
 	{
-		AddToGridFs(Pair.Value, &file_oid);
+		AddToGridFs(Pair.Value, &file_oid, ScanNumPendingFiles);
+		ScanFileOids.Add(file_oid);
 		bson_uint32_to_string(img_arr_idx, &img_key, img_key_str, sizeof img_key_str);
 		BSON_APPEND_DOCUMENT_BEGIN(&scan_img_arr, img_key, &scan_img_arr_obj);
 		BSON_APPEND_UTF8(&scan_img_arr_obj, "type", TCHAR_TO_UTF8(*Pair.Key));
@@ -358,15 +388,31 @@ void FSLMetaDBHandler::FinishScanEntry()
 		 * <-- END "scans" array -->
 		 */
 
-		 // Write entry to the collection
-		bson_error_t error;
-		if (!mongoc_collection_insert_one(scans_collection, scan_entry_doc, NULL, NULL, &error))
+		bson_clear(&scan_pose_arr);
+		if (Uploader.IsRunning())
 		{
-			UE_LOG(LogTemp, Error, TEXT("%s::%d Err.: %s"),
-				*FString(__func__), __LINE__, *FString(error.message));
+			// The entry is written once its images are uploaded
+			FSLGridFsPendingDoc PendingDoc;
+			PendingDoc.Doc = scan_entry_doc;
+			PendingDoc.FileOids = MoveTemp(ScanFileOids);
+			PendingDoc.NumPendingFiles = MoveTemp(ScanNumPendingFiles);
+			PendingScanEntryDocs.Emplace(MoveTemp(PendingDoc));
+			scan_entry_doc = nullptr;
+
+			// Write the entries of the previous items which are uploaded in the meantime (does not block)
+			WritePendingScanEntries(true);
+		}
+		else
+		{
+			// Write entry to the collection
+			bson_error_t error;
+			if (!mongoc_collection_insert_one(scans_collection, scan_entry_doc, NULL, NULL, &error))
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Err.: %s"),
+					*FString(__func__), __LINE__, *FString(error.message));
+			}
+			bson_clear(&scan_entry_doc);
 		}
-		bson_clear(&scan_pose_arr);
-		bson_clear(&scan_entry_doc);
 	}
 	else
 	{
@@ -376,9 +422,53 @@ void FSLMetaDBHandler::FinishScanEntry()
 }
 
 #if SL_WITH_LIBMONGO_C
+// Write the scan entries waiting for their image uploads (only the ones with all images processed if only uploaded),
+// skip the ones referencing failed uploads, return false if any entry was skipped
+bool FSLMetaDBHandler::WritePendingScanEntries(bool bOnlyUploaded)
+{
+	bool bAllWritten = true;
+	bson_error_t error;
+	int32 DocIdx = 0;
+	while (DocIdx < PendingScanEntryDocs.Num())
+	{
+		FSLGridFsPendingDoc& PendingDoc = PendingScanEntryDocs[DocIdx];
+		if (bOnlyUploaded && !PendingDoc.IsUploaded())
+		{
+			DocIdx++;
+			continue;
+		}
+
+		if (Uploader.HasFailed(PendingDoc.FileOids))
+		{
+			bson_iter_t iter;
+			const FString Class = bson_iter_init_find(&iter, PendingDoc.Doc, "class") ? FString(UTF8_TO_TCHAR(bson_iter_utf8(&iter, NULL))) : FString();
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Scan entry of %s references images which could not be uploaded, skipping entry.."),
+				*FString(__func__), __LINE__, *Class);
+			bAllWritten = false;
+		}
+		else if (!mongoc_collection_insert_one(scans_collection, PendingDoc.Doc, NULL, NULL, &error))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Err.: %s"),
+				*FString(__func__), __LINE__, *FString(error.message));
+			bAllWritten = false;
+		}
+		bson_destroy(PendingDoc.Doc);
+		PendingScanEntryDocs.RemoveAt(DocIdx);
+	}
+	return bAllWritten;
+}
+
 // Add image to gridfs, output the oid
-void FSLMetaDBHandler::AddToGridFs(const TArray<uint8>& CompressedBitmap, bson_oid_t* out_oid)
+void FSLMetaDBHandler::AddToGridFs(const TArray<uint8>& CompressedBitmap, bson_oid_t* out_oid,
+	const TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe>& NumEntryPendingFiles)
 {
+	// The file id is generated locally, the scan document can reference it before the upload finished
+	if (Uploader.IsRunning())
+	{
+		Uploader.Enqueue(CompressedBitmap, out_oid, NumEntryPendingFiles);
+		return;
+	}
+
 	mongoc_gridfs_file_t *file;
 	mongoc_gridfs_file_opt_t file_opt = { 0 };
 	const bson_value_t* file_id_val;
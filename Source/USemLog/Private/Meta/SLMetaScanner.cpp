@@ -73,6 +73,9 @@ void USLMetaScanner::Init(const FString& InTaskId, FSLMetaScannerParams ScanPara
 			SaveLocallyFolderName = "/SemLog/" + InTaskId + "/3dscan/";
 		}
 
+		// Image encodings per view mode
+		ViewModeCodecs = ScanParams.ViewModeCodecs;
+
 		// If no view modes are available, add a default one
 		if(ViewModes.Num() == 0)
 		{
@@ -222,16 +225,25 @@ void USLMetaScanner::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor>
 	//TArray<FColor>& BitmapRef = const_cast<TArray<FColor>&>(Bitmap)
 
 	// Compress image
+	const ESLImageCodec* ViewModeCodec = ViewModeCodecs.Find(ViewModes[CurrViewModeIdx]);
+	const ESLImageCodec Codec = ViewModeCodec ? *ViewModeCodec : ESLImageCodec::PNG;
 	TArray<uint8> CompressedBitmap;
-	FImageUtils::CompressImageArray(SizeX, SizeY, Bitmap, CompressedBitmap);
-
-	// Add image current scan data
-	ScanPoseData.Images.Emplace(GetViewModeName(ViewModes[CurrViewModeIdx]), CompressedBitmap);
+	ESLImageCodec UsedCodec;
+	if (FSLImageCodec::Encode(Codec, SizeX, SizeY, Bitmap, CompressedBitmap, UsedCodec))
+	{
+		// Add image current scan data
+		ScanPoseData.Images.Emplace(GetViewModeName(ViewModes[CurrViewModeIdx]), CompressedBitmap);
 
-	// Save the png locally
-	if (!SaveLocallyFolderName.IsEmpty())
+		// Save the image locally (with the extension of the codec actually used)
+		if (!SaveLocallyFolderName.IsEmpty())
+		{
+			SaveImageLocally(CompressedBitmap, UsedCodec);
+		}
+	}
+	else
 	{
-		SaveImageLocally(CompressedBitmap);
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not encode the %s image, skipping.."),
+			*FString(__FUNCTION__), __LINE__, *GetViewModeName(ViewModes[CurrViewModeIdx]));
 	}
 
 	// Item and camera in position, check for other view modes
@@ -906,10 +918,10 @@ void USLMetaScanner::QuitEditor()
 }
 
 // Save the compressed screenshot image locally
-void USLMetaScanner::SaveImageLocally(const TArray<uint8>& CompressedBitmap)
+void USLMetaScanner::SaveImageLocally(const TArray<uint8>& CompressedBitmap, ESLImageCodec Codec)
 {
 	FString ItemClassFolder = ScanItems[CurrItemIdx].Value + "_" + ViewModePostfix + "/";
-	FString Path = FPaths::ProjectDir() + SaveLocallyFolderName + ItemClassFolder + CurrScanName + ".png";
+	FString Path = FPaths::ProjectDir() + SaveLocallyFolderName + ItemClassFolder + CurrScanName + FSLImageCodec::GetFileExtension(Codec);
 	FPaths::RemoveDuplicateSlashes(Path);
 	FFileHelper::SaveArrayToFile(CompressedBitmap, *Path);
 }
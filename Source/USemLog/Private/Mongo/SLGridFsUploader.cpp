@@ -0,0 +1,472 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Mongo/SLGridFsUploader.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+// Default gridfs chunk size, files up to this size are stored in a single chunk
+static const int32 SLGridFsChunkSize = 255 * 1024;
+
+/**
+* Consumes the upload queue with its own connection from the pool
+*/
+class FSLGridFsUploadWorker : public FRunnable
+{
+public:
+	// Init ctor
+	FSLGridFsUploadWorker(FSLGridFsUploader* InOwner) : Owner(InOwner) {};
+
+	// Upload batches until the owner requests a stop and the queue is empty
+	virtual uint32 Run() override
+	{
+#if SL_WITH_LIBMONGO_C
+		bson_error_t error;
+		mongoc_client_t* client = mongoc_client_pool_pop(Owner->client_pool);
+		mongoc_database_t* database = mongoc_client_get_database(client, TCHAR_TO_UTF8(*Owner->DBName));
+		mongoc_collection_t* files_coll = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*(Owner->Prefix + ".files")));
+		mongoc_collection_t* chunks_coll = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*(Owner->Prefix + ".chunks")));
+
+		// Creating the gridfs handle also makes sure the gridfs indexes exist
+		mongoc_gridfs_t* gridfs = mongoc_client_get_gridfs(client,
+			TCHAR_TO_UTF8(*Owner->DBName), TCHAR_TO_UTF8(*Owner->Prefix), &error);
+		if (!gridfs)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Err.:%s"), *FString(__FUNCTION__), __LINE__, *FString(error.message));
+		}
+
+		TArray<FSLGridFsUploadJob> Batch;
+		while (true)
+		{
+			if (Owner->DequeueBatch(Batch))
+			{
+				Owner->UploadBatch(Batch, gridfs, files_coll, chunks_coll);
+				int64 NumBatchBytes = 0;
+				for (const auto& Job : Batch)
+				{
+					NumBatchBytes += Job.Data.Num();
+					if (Job.NumDocPendingFiles.IsValid())
+					{
+						Job.NumDocPendingFiles->Decrement();
+					}
+				}
+				Owner->NumPendingBytes.Subtract(NumBatchBytes);
+				Owner->SpaceEvent->Trigger();
+
+				// Subtract returns the previous value, wake up the flushing thread if this was the last job
+				if (Owner->NumPending.Subtract(Batch.Num()) == Batch.Num())
+				{
+					Owner->IdleEvent->Trigger();
+				}
+			}
+			else if (Owner->bStopRequested)
+			{
+				break;
+			}
+			else
+			{
+				Owner->WorkEvent->Wait(50);
+			}
+		}
+
+		if (gridfs)
+		{
+			mongoc_gridfs_destroy(gridfs);
+		}
+		mongoc_collection_destroy(chunks_coll);
+		mongoc_collection_destroy(files_coll);
+		mongoc_database_destroy(database);
+		mongoc_client_pool_push(Owner->client_pool, client);
+#endif //SL_WITH_LIBMONGO_C
+		return 0;
+	}
+
+private:
+	// Owner of the queue and the connection pool
+	FSLGridFsUploader* Owner;
+};
+
+// Ctor
+FSLGridFsUploader::FSLGridFsUploader() : MaxBatchSize(16), bBatchSmallFiles(true),
+	MaxNumPending(DefaultMaxNumPending), MaxPendingBytes(DefaultMaxPendingBytes),
+	WorkEvent(nullptr), IdleEvent(nullptr), SpaceEvent(nullptr)
+{
+#if SL_WITH_LIBMONGO_C
+	uri = nullptr;
+	client_pool = nullptr;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Dtor
+FSLGridFsUploader::~FSLGridFsUploader()
+{
+	Stop();
+}
+
+// Start the upload workers, each with its own connection from the pool,
+// enqueueing blocks while the pending uploads exceed the max number of files or bytes
+bool FSLGridFsUploader::Start(const FString& Uri, const FString& InDBName, const FString& InPrefix,
+	int32 NumWorkers, int32 InMaxBatchSize, bool bInBatchSmallFiles, int32 InMaxNumPending, int64 InMaxPendingBytes)
+{
+#if SL_WITH_LIBMONGO_C
+	if (IsRunning())
+	{
+		return true;
+	}
+
+	bson_error_t error;
+	uri = mongoc_uri_new_with_error(TCHAR_TO_UTF8(*Uri), &error);
+	if (!uri)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Err.:%s; [Uri=%s]"),
+			*FString(__FUNCTION__), __LINE__, *FString(error.message), *Uri);
+		return false;
+	}
+
+	NumWorkers = FMath::Max(NumWorkers, 1);
+	client_pool = mongoc_client_pool_new(uri);
+	mongoc_client_pool_max_size(client_pool, NumWorkers);
+	mongoc_client_pool_set_appname(client_pool, TCHAR_TO_UTF8(*("SL_UPLOAD_" + InPrefix)));
+
+	DBName = InDBName;
+	Prefix = InPrefix;
+	MaxBatchSize = FMath::Max(InMaxBatchSize, 1);
+	bBatchSmallFiles = bInBatchSmallFiles;
+	MaxNumPending = FMath::Max(InMaxNumPending, 1);
+	MaxPendingBytes = FMath::Max(InMaxPendingBytes, (int64)1);
+	bStopRequested = false;
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	IdleEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	SpaceEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	FailedOids.Empty();
+
+	for (int32 Idx = 0; Idx < NumWorkers; ++Idx)
+	{
+		FSLGridFsUploadWorker* Worker = new FSLGridFsUploadWorker(this);
+		Workers.Add(Worker);
+		WorkerThreads.Add(FRunnableThread::Create(Worker, *FString::Printf(TEXT("SLGridFsUploadWorker_%d"), Idx)));
+	}
+	return true;
+#else
+	return false;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+#if SL_WITH_LIBMONGO_C
+// Queue the binary for upload, the file id is set right away (can be referenced before the upload finished),
+// the optional document counter is incremented until the file is processed,
+// blocks until the workers catch up if the pending uploads budget is exceeded
+void FSLGridFsUploader::Enqueue(const TArray<uint8>& Data, bson_oid_t* out_oid,
+	const TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe>& NumDocPendingFiles)
+{
+	// A file larger than the bytes budget is accepted once the queue is empty,
+	// the timed wait covers the triggers consumed by other producers
+	while (NumPending.GetValue() > 0 && (NumPending.GetValue() >= MaxNumPending
+		|| NumPendingBytes.GetValue() + Data.Num() > MaxPendingBytes))
+	{
+		SpaceEvent->Wait(50);
+	}
+
+	FSLGridFsUploadJob Job;
+	bson_oid_init(&Job.Oid, NULL);
+	bson_oid_copy(&Job.Oid, out_oid);
+	Job.Data = Data;
+	Job.NumDocPendingFiles = NumDocPendingFiles;
+	if (NumDocPendingFiles.IsValid())
+	{
+		NumDocPendingFiles->Increment();
+	}
+
+	NumPending.Increment();
+	NumPendingBytes.Add(Job.Data.Num());
+	Queue.Enqueue(MoveTemp(Job));
+	WorkEvent->Trigger();
+}
+#endif //SL_WITH_LIBMONGO_C
+
+// Block until all queued binaries are uploaded, return false on timeout
+bool FSLGridFsUploader::Flush(float Timeout)
+{
+	// The idle event auto resets, a trigger from a previous flush only causes one extra check
+	const double EndTime = FPlatformTime::Seconds() + Timeout;
+	while (IsRunning() && NumPending.GetValue() > 0)
+	{
+		const double RemainingTime = EndTime - FPlatformTime::Seconds();
+		if (RemainingTime <= 0.0 || !IdleEvent->Wait(FTimespan::FromSeconds(RemainingTime)))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Timeout (%.1fs), %d uploads are still pending.."),
+				*FString(__FUNCTION__), __LINE__, Timeout, NumPending.GetValue());
+			return false;
+		}
+	}
+	return true;
+}
+
+// Flush and stop the workers
+void FSLGridFsUploader::Stop()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	// Workers exit once the queue is empty
+	bStopRequested = true;
+	for (FRunnableThread* Thread : WorkerThreads)
+	{
+		WorkEvent->Trigger();
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+	WorkerThreads.Empty();
+	for (FSLGridFsUploadWorker* Worker : Workers)
+	{
+		delete Worker;
+	}
+	Workers.Empty();
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+	FPlatformProcess::ReturnSynchEventToPool(IdleEvent);
+	IdleEvent = nullptr;
+	FPlatformProcess::ReturnSynchEventToPool(SpaceEvent);
+	SpaceEvent = nullptr;
+
+#if SL_WITH_LIBMONGO_C
+	mongoc_client_pool_destroy(client_pool);
+	client_pool = nullptr;
+	mongoc_uri_destroy(uri);
+	uri = nullptr;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Get the next batch of jobs, returns false if the queue is empty
+bool FSLGridFsUploader::DequeueBatch(TArray<FSLGridFsUploadJob>& OutBatch)
+{
+	OutBatch.Reset();
+	FScopeLock Lock(&DequeueLock);
+	FSLGridFsUploadJob Job;
+	while (OutBatch.Num() < MaxBatchSize && Queue.Dequeue(Job))
+	{
+		OutBatch.Emplace(MoveTemp(Job));
+	}
+	return OutBatch.Num() > 0;
+}
+
+#if SL_WITH_LIBMONGO_C
+// Check if the upload of any of the files failed
+bool FSLGridFsUploader::HasFailed(const TArray<bson_oid_t>& Oids)
+{
+	FScopeLock Lock(&FailedLock);
+	for (const auto& Oid : Oids)
+	{
+		for (const auto& FailedOid : FailedOids)
+		{
+			if (bson_oid_equal(&Oid, &FailedOid))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// Upload the batch with the given connection handles (a null gridfs handle fails the whole batch)
+void FSLGridFsUploader::UploadBatch(TArray<FSLGridFsUploadJob>& Batch, mongoc_gridfs_t* gridfs,
+	mongoc_collection_t* files_coll, mongoc_collection_t* chunks_coll)
+{
+	TArray<const FSLGridFsUploadJob*> FailedJobs;
+	TArray<FSLGridFsUploadJob*> SmallJobs;
+	for (auto& Job : Batch)
+	{
+		if (!gridfs)
+		{
+			FailedJobs.Add(&Job);
+		}
+		else if (bBatchSmallFiles && Job.Data.Num() <= SLGridFsChunkSize)
+		{
+			SmallJobs.Add(&Job);
+		}
+		else if (!UploadFile(Job, gridfs))
+		{
+			FailedJobs.Add(&Job);
+		}
+	}
+
+	if (SmallJobs.Num() > 0)
+	{
+		UploadSmallFiles(SmallJobs, files_coll, chunks_coll, FailedJobs);
+	}
+
+	if (FailedJobs.Num() > 0)
+	{
+		AddFailed(FailedJobs);
+	}
+}
+
+// Remember the ids of the files which could not be uploaded
+void FSLGridFsUploader::AddFailed(const TArray<const FSLGridFsUploadJob*>& Jobs)
+{
+	UE_LOG(LogTemp, Error, TEXT("%s::%d %d file(s) could not be uploaded to %s.%s.."),
+		*FString(__FUNCTION__), __LINE__, Jobs.Num(), *DBName, *Prefix);
+	FScopeLock Lock(&FailedLock);
+	for (const auto& Job : Jobs)
+	{
+		FailedOids.Add(Job->Oid);
+	}
+}
+
+// Upload the file through the gridfs api (used for files larger than one chunk)
+bool FSLGridFsUploader::UploadFile(FSLGridFsUploadJob& Job, mongoc_gridfs_t* gridfs) const
+{
+	mongoc_gridfs_file_opt_t file_opt = { 0 };
+	mongoc_iovec_t iov;
+	bson_error_t error;
+
+	// Create new file with the pre-generated id
+	mongoc_gridfs_file_t* file = mongoc_gridfs_create_file(gridfs, &file_opt);
+	bson_value_t id_val;
+	id_val.value_type = BSON_TYPE_OID;
+	bson_oid_copy(&Job.Oid, &id_val.value.v_oid);
+	if (!mongoc_gridfs_file_set_id(file, &id_val, &error))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Err.:%s"), *FString(__FUNCTION__), __LINE__, *FString(error.message));
+		mongoc_gridfs_file_destroy(file);
+		return false;
+	}
+
+	// Set data binary and length
+	iov.iov_base = (char*)(Job.Data.GetData());
+	iov.iov_len = Job.Data.Num();
+
+	// Write data to gridfs
+	if (iov.iov_len != mongoc_gridfs_file_writev(file, &iov, 1, 0))
+	{
+		if (mongoc_gridfs_file_error(file, &error))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d Err.:%s"), *FString(__FUNCTION__), __LINE__, *FString(error.message));
+		}
+		mongoc_gridfs_file_destroy(file);
+		return false;
+	}
+
+	// Saves modifications to file to the MongoDB server
+	if (!mongoc_gridfs_file_save(file))
+	{
+		mongoc_gridfs_file_error(file, &error);
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Err.:%s"), *FString(__FUNCTION__), __LINE__, *FString(error.message));
+		mongoc_gridfs_file_destroy(file);
+		return false;
+	}
+
+	mongoc_gridfs_file_destroy(file);
+	return true;
+}
+
+// Insert the files and chunks documents of the single chunk files in one batch, output the jobs which could not be uploaded
+void FSLGridFsUploader::UploadSmallFiles(const TArray<FSLGridFsUploadJob*>& Jobs, mongoc_collection_t* files_coll,
+	mongoc_collection_t* chunks_coll, TArray<const FSLGridFsUploadJob*>& OutFailedJobs) const
+{
+	const int64 UploadDate = (int64)(FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds();
+
+	TArray<bson_t*> chunk_docs;
+	for (const auto& Job : Jobs)
+	{
+		bson_t* chunk_doc = bson_new();
+		BSON_APPEND_OID(chunk_doc, "files_id", &Job->Oid);
+		BSON_APPEND_INT32(chunk_doc, "n", 0);
+		BSON_APPEND_BINARY(chunk_doc, "data", BSON_SUBTYPE_BINARY, Job->Data.GetData(), Job->Data.Num());
+		chunk_docs.Add(chunk_doc);
+	}
+
+	// Chunks first, the files documents make the files visible to the readers
+	TArray<bool> ChunkFailed;
+	InsertDocs(chunks_coll, chunk_docs, ChunkFailed);
+
+	// Only the files with a stored chunk get a files document
+	TArray<bson_t*> file_docs;
+	TArray<int32> FileJobIndexes;
+	for (int32 JobIdx = 0; JobIdx < Jobs.Num(); ++JobIdx)
+	{
+		if (ChunkFailed[JobIdx])
+		{
+			OutFailedJobs.Add(Jobs[JobIdx]);
+			continue;
+		}
+
+		bson_t* file_doc = bson_new();
+		BSON_APPEND_OID(file_doc, "_id", &Jobs[JobIdx]->Oid);
+		BSON_APPEND_INT64(file_doc, "length", Jobs[JobIdx]->Data.Num());
+		BSON_APPEND_INT32(file_doc, "chunkSize", SLGridFsChunkSize);
+		BSON_APPEND_DATE_TIME(file_doc, "uploadDate", UploadDate);
+		file_docs.Add(file_doc);
+		FileJobIndexes.Add(JobIdx);
+	}
+
+	TArray<bool> FileFailed;
+	InsertDocs(files_coll, file_docs, FileFailed);
+	for (int32 DocIdx = 0; DocIdx < FileFailed.Num(); ++DocIdx)
+	{
+		if (FileFailed[DocIdx])
+		{
+			OutFailedJobs.Add(Jobs[FileJobIndexes[DocIdx]]);
+		}
+	}
+
+	for (bson_t* doc : chunk_docs)
+	{
+		bson_destroy(doc);
+	}
+	for (bson_t* doc : file_docs)
+	{
+		bson_destroy(doc);
+	}
+}
+
+// Insert the documents unordered, flag the ones which could not be inserted (all of them if the server did not report the failed indexes)
+void FSLGridFsUploader::InsertDocs(mongoc_collection_t* coll, const TArray<bson_t*>& Docs, TArray<bool>& OutFailed) const
+{
+	OutFailed.Init(false, Docs.Num());
+	if (Docs.Num() == 0)
+	{
+		return;
+	}
+
+	// Unordered, the insert continues after a failed document and reports every failed one by its index
+	bson_t* opts = BCON_NEW("ordered", BCON_BOOL(false));
+	bson_t reply;
+	bson_error_t error;
+	if (!mongoc_collection_insert_many(coll, (const bson_t**)Docs.GetData(), Docs.Num(), opts, &reply, &error))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Err.:%s"), *FString(__FUNCTION__), __LINE__, *FString(error.message));
+
+		bson_iter_t iter;
+		bson_iter_t errors_iter;
+		bson_iter_t error_iter;
+		if (bson_iter_init_find(&iter, &reply, "writeErrors") && BSON_ITER_HOLDS_ARRAY(&iter) && bson_iter_recurse(&iter, &errors_iter))
+		{
+			while (bson_iter_next(&errors_iter))
+			{
+				if (BSON_ITER_HOLDS_DOCUMENT(&errors_iter) && bson_iter_recurse(&errors_iter, &error_iter)
+					&& bson_iter_find(&error_iter, "index"))
+				{
+					const int64 DocIdx = bson_iter_as_int64(&error_iter);
+					if (OutFailed.IsValidIndex(DocIdx))
+					{
+						OutFailed[DocIdx] = true;
+					}
+				}
+			}
+		}
+		else
+		{
+			// No per document results (e.g. connection error)
+			OutFailed.Init(true, Docs.Num());
+		}
+	}
+	bson_destroy(&reply);
+	bson_destroy(opts);
+}
+#endif //SL_WITH_LIBMONGO_C
@@ -191,18 +191,12 @@ void USLBoneContactMonitor::Finish(bool bForced)
 	if (!bIsFinished && (bIsInit || bIsStarted))
 	{
 		// Publish dangling recently finished events
-		for (const auto& EvItr : RecentlyEndedGraspOverlapEvents)
-		{
-			OnEndGraspBoneOverlap.Broadcast(EvItr.Other, BoneName);
-		}
-		RecentlyEndedGraspOverlapEvents.Empty();
+		RecentlyEndedGraspOverlapEvents.PopExpired(-1.f, ConcatenateIfSmaller,
+			[this](const FSLBoneContactEndEvent& Ev) { OnEndGraspBoneOverlap.Broadcast(Ev.Other, BoneName); });
 
 		// Publish dangling recently finished events
-		for (const auto& EvItr : RecentlyEndedContactOverlapEvents)
-		{
-			OnEndContactBoneOverlap.Broadcast(EvItr.Other, BoneName);
-		}
-		RecentlyEndedContactOverlapEvents.Empty();
+		RecentlyEndedContactOverlapEvents.PopExpired(-1.f, ConcatenateIfSmaller,
+			[this](const FSLBoneContactEndEvent& Ev) { OnEndContactBoneOverlap.Broadcast(Ev.Other, BoneName); });
 
 		SetGenerateOverlapEvents(false);
 		
@@ -497,8 +491,8 @@ void USLBoneContactMonitor::OnGraspOverlapEnd(UPrimitiveComponent* OverlappedCom
 		}
 
 		// Grasp overlap ended ended
-		RecentlyEndedGraspOverlapEvents.Emplace(FSLBoneContactEndEvent(
-			OtherIndividual, GetWorld()->GetTimeSeconds()));
+		RecentlyEndedGraspOverlapEvents.Add(OtherIndividual, GetWorld()->GetTimeSeconds(),
+			FSLBoneContactEndEvent(OtherIndividual, GetWorld()->GetTimeSeconds()));
 			
 		// Delay publishing for a while, in case the new event is of the same type and should be concatenated
 		if(!GetWorld()->GetTimerManager().IsTimerActive(GraspDelayTimerHandle))
@@ -528,25 +522,19 @@ void USLBoneContactMonitor::DelayedGraspOverlapEndEventCallback()
 	// Curr time (keep very recently added events for another delay)
 	const float CurrTime = GetWorld()->GetTimeSeconds();
 	
-	for (auto EvItr(RecentlyEndedGraspOverlapEvents.CreateIterator()); EvItr; ++EvItr)
+	// If enough time has passed, publish the events
+	RecentlyEndedGraspOverlapEvents.PopExpired(CurrTime, ConcatenateIfSmaller, [this](const FSLBoneContactEndEvent& Ev)
 	{
-		// If enough time has passed, publish the event
-		if(CurrTime - EvItr->Timestamp > ConcatenateIfSmaller)
+		if (bLogGraspDebug)
 		{
-			if (bLogGraspDebug)
-			{
-				UE_LOG(LogTemp, Error, TEXT("%s::%d \t %.4fs \t\t Grasp Contact Ended ( !!! broadcast !!! with delay): \t\t %s::%s->%s;"),
-					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *GetName(), *EvItr->Other->GetParentActor()->GetName());
-			}
-
-			// Broadcast delayed event
-			OnEndGraspBoneOverlap.Broadcast(EvItr->Other, BoneName);
-			
-			// Remove event from the pending list
-			EvItr.RemoveCurrent();
+			UE_LOG(LogTemp, Error, TEXT("%s::%d \t %.4fs \t\t Grasp Contact Ended ( !!! broadcast !!! with delay): \t\t %s::%s->%s;"),
+				*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
+				*GetOwner()->GetName(), *GetName(), *Ev.Other->GetParentActor()->GetName());
 		}
-	}
+
+		// Broadcast delayed event
+		OnEndGraspBoneOverlap.Broadcast(Ev.Other, BoneName);
+	});
 
 	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
 	if(RecentlyEndedGraspOverlapEvents.Num() > 0)
@@ -560,24 +548,14 @@ void USLBoneContactMonitor::DelayedGraspOverlapEndEventCallback()
 // Check if this begin event happened right after the previous one ended, if so remove it from the array, and cancel publishing the begin event
 bool USLBoneContactMonitor::IsAJitterGrasp(USLBaseIndividual* OtherIndividual, float StartTime)
 {
-	for (auto EvItr(RecentlyEndedGraspOverlapEvents.CreateIterator()); EvItr; ++EvItr)
+	if (RecentlyEndedGraspOverlapEvents.RemoveIfJitter(OtherIndividual, StartTime, ConcatenateIfSmaller))
 	{
-		// Check if it is an event between the same entities
-		if(EvItr->Other == OtherIndividual)
+		// Check if it was the last event, if so, pause the delay publisher
+		if (RecentlyEndedGraspOverlapEvents.Num() == 0)
 		{
-			// Check time difference
-			if(StartTime - EvItr->Timestamp < ConcatenateIfSmaller)
-			{
-				EvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedGraspOverlapEvents.Num() == 0)
-				{
-					GetWorld()->GetTimerManager().ClearTimer(GraspDelayTimerHandle);
-				}
-				return true;
-			}
+			GetWorld()->GetTimerManager().ClearTimer(GraspDelayTimerHandle);
 		}
+		return true;
 	}
 	return false;
 }
@@ -732,8 +710,8 @@ void USLBoneContactMonitor::OnContactOverlapEnd(UPrimitiveComponent* OverlappedC
 	}
 
 	// Contact overlap ended ended
-	RecentlyEndedContactOverlapEvents.Emplace(FSLBoneContactEndEvent(
-		OtherIndividual, GetWorld()->GetTimeSeconds()));
+	RecentlyEndedContactOverlapEvents.Add(OtherIndividual, GetWorld()->GetTimeSeconds(),
+		FSLBoneContactEndEvent(OtherIndividual, GetWorld()->GetTimeSeconds()));
 		
 	// Delay publishing for a while, in case the new event is of the same type and should be concatenated
 	if(!GetWorld()->GetTimerManager().IsTimerActive(ContactDelayTimerHandle))
@@ -751,25 +729,19 @@ void USLBoneContactMonitor::DelayContactEndCallback()
 	// Curr time (keep very recently added events for another delay)
 	const float CurrTime = GetWorld()->GetTimeSeconds();
 	
-	for (auto EvItr(RecentlyEndedContactOverlapEvents.CreateIterator()); EvItr; ++EvItr)
+	// If enough time has passed, publish the events
+	RecentlyEndedContactOverlapEvents.PopExpired(CurrTime, ConcatenateIfSmaller, [this](const FSLBoneContactEndEvent& Ev)
 	{
-		// If enough time has passed, publish the event
-		if(CurrTime - EvItr->Timestamp > ConcatenateIfSmaller)
+		if (bLogContactDebug)
 		{
-			if (bLogContactDebug)
-			{
-				UE_LOG(LogTemp, Error, TEXT("%s::%d \t\t %.4fs \t\t Contact Ended ( !!! broadcast !!! with delay): \t\t %s::%s->%s;"),
-					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *GetName(), *EvItr->Other->GetParentActor()->GetName());
-			}
-
-			// Broadcast delayed event
-			OnEndContactBoneOverlap.Broadcast(EvItr->Other, BoneName);
-			
-			// Remove event from the pending list
-			EvItr.RemoveCurrent();
+			UE_LOG(LogTemp, Error, TEXT("%s::%d \t\t %.4fs \t\t Contact Ended ( !!! broadcast !!! with delay): \t\t %s::%s->%s;"),
+				*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
+				*GetOwner()->GetName(), *GetName(), *Ev.Other->GetParentActor()->GetName());
 		}
-	}
+
+		// Broadcast delayed event
+		OnEndContactBoneOverlap.Broadcast(Ev.Other, BoneName);
+	});
 
 	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
 	if(RecentlyEndedContactOverlapEvents.Num() > 0)
@@ -784,24 +756,14 @@ void USLBoneContactMonitor::DelayContactEndCallback()
 // if so remove it from the array, and cancel publishing the begin event
 bool USLBoneContactMonitor::IsAJitterContact(USLBaseIndividual* OtherIndividual, float StartTime)
 {
-	for (auto EvItr(RecentlyEndedContactOverlapEvents.CreateIterator()); EvItr; ++EvItr)
+	if (RecentlyEndedContactOverlapEvents.RemoveIfJitter(OtherIndividual, StartTime, ConcatenateIfSmaller))
 	{
-		// Check if it is an event between the same entities
-		if(EvItr->Other == OtherIndividual)
+		// Check if it was the last event, if so, pause the delay publisher
+		if (RecentlyEndedContactOverlapEvents.Num() == 0)
 		{
-			// Check time difference
-			if(StartTime - EvItr->Timestamp < ConcatenateIfSmaller)
-			{
-				EvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedContactOverlapEvents.Num() == 0)
-				{
-					GetWorld()->GetTimerManager().ClearTimer(ContactDelayTimerHandle);
-				}
-				return true;
-			}
+			GetWorld()->GetTimerManager().ClearTimer(ContactDelayTimerHandle);
 		}
+		return true;
 	}
 	return false;
 }
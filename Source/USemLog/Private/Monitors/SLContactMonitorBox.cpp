@@ -25,6 +25,7 @@ USLContactMonitorBox::USLContactMonitorBox()
 	bIsFinished = false;
 
 	bLogSupportedByEvents = true;
+	SupportedByUpdateId = INDEX_NONE;
 
 	OwnerIndividualComponent = nullptr;
 
@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Monitors/SLContactMonitorInterface.h"
+#include "Monitors/SLMonitorScheduler.h"
 #include "Individuals/SLIndividualUtils.h"
 #include "Components/MeshComponent.h"
 #include "Utils/SLUuid.h"
@@ -12,15 +13,20 @@ void ISLContactMonitorInterface::Finish(bool bForced)
 	if (!bIsFinished && (bIsInit || bIsStarted))
 	{
 		// Publish any pending delayed events	
-		for(const auto& Ev : RecentlyEndedOverlapEvents)
-		{
-			PublishDelayedOverlapEndEvent(Ev);
-		}
-		RecentlyEndedOverlapEvents.Empty();
+		RecentlyEndedOverlapEvents.PopExpired(-1.f, ConcatenateIfSmaller,
+			[this](const FSLOverlapEndEvent& Ev) { PublishDelayedOverlapEndEvent(Ev); });
 		
 		// Disable overlap events
 		ShapeComponent->SetGenerateOverlapEvents(false);
 
+		// Stop the supported by checks (forced finishes come from the dtor, the scheduler clears with the world)
+		USLMonitorScheduler* Scheduler = bForced ? nullptr : USLMonitorScheduler::Get(World);
+		if (Scheduler)
+		{
+			Scheduler->Unregister(SupportedByUpdateId);
+		}
+		SupportedByUpdateId = INDEX_NONE;
+
 		// Mark as finished
 		bIsStarted = false;
 		bIsInit = false;
@@ -59,11 +65,28 @@ void ISLContactMonitorInterface::TriggerInitialOverlaps()
 // Start checking for supported by events
 void ISLContactMonitorInterface::StartSupportedByUpdateCheck()
 {
-	if(World)
+	if (USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(World))
 	{
-		// Start updating the timer, will be paused if there are no candidates
-		SupportedByTimerDelegate.BindRaw(this, &ISLContactMonitorInterface::SupportedByUpdateCheckBegin);
-		World->GetTimerManager().SetTimer(SupportedByTimerHandle, SupportedByTimerDelegate, SupportedByUpdateRate, true);
+		// Start the update, will be paused if there are no candidates
+		// (the shape component implements the interface, forced finishes do not unregister, check that it is still alive)
+		TWeakObjectPtr<UShapeComponent> WeakShapeComponent(ShapeComponent);
+		SupportedByUpdateId = Scheduler->Register(TEXT("SupportedBy"), [this, WeakShapeComponent](float DeltaTime)
+		{
+			if (WeakShapeComponent.IsValid())
+			{
+				SupportedByUpdateCheckBegin();
+			}
+		}, SupportedByUpdateRate, true);
+	}
+}
+
+// Enable the supported by update check if there are candidates
+void ISLContactMonitorInterface::ResumeSupportedByUpdateCheck()
+{
+	USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(World);
+	if (Scheduler && !Scheduler->IsEnabled(SupportedByUpdateId))
+	{
+		Scheduler->SetEnabled(SupportedByUpdateId, true);
 	}
 }
 
@@ -117,10 +140,13 @@ void ISLContactMonitorInterface::SupportedByUpdateCheckBegin()
 		}
 	}
 	
-	// PauseGraspDetection timer
+	// Pause the update until new candidates are added
 	if (SupportedByCandidates.Num() == 0)
 	{
-		World->GetTimerManager().PauseTimer(SupportedByTimerHandle);
+		if (USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(World))
+		{
+			Scheduler->SetEnabled(SupportedByUpdateId, false);
+		}
 	}
 }
 
@@ -185,12 +211,9 @@ void ISLContactMonitorInterface::OnOverlapBegin(UPrimitiveComponent* OverlappedC
 
 		if(bLogSupportedByEvents)
 		{
-			// Add candidate and re-start (if paused) timer cb
+			// Add candidate and re-start (if paused) the update
 			SupportedByCandidates.Emplace(SemanticOverlapResult);
-			if(World->GetTimerManager().IsTimerPaused(SupportedByTimerHandle))
-			{
-				World->GetTimerManager().UnPauseTimer(SupportedByTimerHandle);
-			}
+			ResumeSupportedByUpdateCheck();
 		}
 	}
 	else if (ISLContactMonitorInterface* OtherContactTrigger = Cast<ISLContactMonitorInterface>(OtherComp))
@@ -211,12 +234,9 @@ void ISLContactMonitorInterface::OnOverlapBegin(UPrimitiveComponent* OverlappedC
 			
 			if(bLogSupportedByEvents)
 			{
-				// Add candidate and re-start (if paused) timer cb
+				// Add candidate and re-start (if paused) the update
 				SupportedByCandidates.Emplace(SemanticOverlapResult);
-				if(World->GetTimerManager().IsTimerPaused(SupportedByTimerHandle))
-				{
-					World->GetTimerManager().UnPauseTimer(SupportedByTimerHandle);
-				}
+				ResumeSupportedByUpdateCheck();
 			}
 		}
 	}
@@ -246,7 +266,8 @@ void ISLContactMonitorInterface::OnOverlapEnd(UPrimitiveComponent* OverlappedCom
 	}
 
 	// Delay publishing the overlap event in case of possible concatenations
-	RecentlyEndedOverlapEvents.Emplace(FSLOverlapEndEvent(OtherComp, OtherIndividual, World->GetTimeSeconds()));
+	RecentlyEndedOverlapEvents.Add(OtherIndividual, World->GetTimeSeconds(),
+		FSLOverlapEndEvent(OtherComp, OtherIndividual, World->GetTimeSeconds()));
 
 	// Delay publishing for a while, in case the new event is of the same type and should be concatenated
 	if(!World->GetTimerManager().IsTimerActive(DelayTimerHandle))
@@ -262,14 +283,9 @@ void ISLContactMonitorInterface::DelayedOverlapEndEventCallback()
 	// Curr time (keep very recently added events for another delay)
 	const float CurrTime = World->GetTimeSeconds();
 	
-	for (auto OverlapEndEvItr(RecentlyEndedOverlapEvents.CreateIterator()); OverlapEndEvItr; ++OverlapEndEvItr)
-	{
-		if(PublishDelayedOverlapEndEvent(*OverlapEndEvItr, CurrTime))
-		{
-			// Remove event from the pending list
-			OverlapEndEvItr.RemoveCurrent();
-		}
-	}
+	// Publish the events old enough to not be concatenated anymore
+	RecentlyEndedOverlapEvents.PopExpired(CurrTime, ConcatenateIfSmaller,
+		[this](const FSLOverlapEndEvent& Ev) { PublishDelayedOverlapEndEvent(Ev); });
 
 	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
 	if(RecentlyEndedOverlapEvents.Num() > 0)
@@ -332,25 +348,14 @@ bool ISLContactMonitorInterface::PublishDelayedOverlapEndEvent(const FSLOverlapE
 // Skip publishing overlap event if it can be concatenated with the current event start
 bool ISLContactMonitorInterface::SkipOverlapEndEventBroadcast(USLBaseIndividual* InIndividual, float StartTime)
 {
-	for (auto OverlapEndEvItr(RecentlyEndedOverlapEvents.CreateIterator()); OverlapEndEvItr; ++OverlapEndEvItr)
+	if (RecentlyEndedOverlapEvents.RemoveIfJitter(InIndividual, StartTime, ConcatenateIfSmaller))
 	{
-		// Check if it is an event between the same entities
-		if(OverlapEndEvItr->OtherIndividual == InIndividual)
+		// Check if it was the last event, if so, pause the delay publisher
+		if (RecentlyEndedOverlapEvents.Num() == 0)
 		{
-			// Check time difference
-			if(StartTime - OverlapEndEvItr->Time < ConcatenateIfSmaller)
-			{
-				OverlapEndEvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedOverlapEvents.Num() == 0)
-				{
-					World->GetTimerManager().ClearTimer(DelayTimerHandle);
-				}
-				
-				return true;
-			}
+			World->GetTimerManager().ClearTimer(DelayTimerHandle);
 		}
+		return true;
 	}
 	return false;
 }
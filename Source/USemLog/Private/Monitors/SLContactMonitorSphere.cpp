@@ -24,6 +24,7 @@ USLContactMonitorSphere::USLContactMonitorSphere()
 	bIsFinished = false;
 
 	bLogSupportedByEvents = true;
+	SupportedByUpdateId = INDEX_NONE;
 	
 	OwnerIndividualComponent = nullptr;
 
@@ -133,10 +133,10 @@ void USLContainerMonitor::OnSLGraspEnd(USLBaseIndividual* Self, USLBaseIndividua
 	if(CurrGraspedIndividual == Other)
 	{
 		// Publish close/open events
-		for(const auto Pair : ContainerToDistance)
+		const FVector GraspedLocation = CurrGraspedIndividual->GetParentActor()->GetActorLocation();
+		for(const auto& Pair : ContainerToDistance)
 		{
-			const float CurrDistance = FVector::Distance(Pair.Key->GetParentActor()->GetActorLocation(),
-				CurrGraspedIndividual->GetParentActor()->GetActorLocation());
+			const float CurrDistance = FVector::Distance(Pair.Key->GetActorLocation(), GraspedLocation);
 
 			if(CurrDistance - Pair.Value > MinDistance)
 			{
@@ -214,9 +214,11 @@ bool USLContainerMonitor::SetContainersAndDistances()
 	}
 
 	// Store the containers and their distances to the manipulator
+	const FVector GraspedLocation = CurrGraspedIndividual->GetParentActor()->GetActorLocation();
+	ContainerToDistance.Reserve(Containers.Num());
 	for(const auto& C : Containers)
 	{
-		ContainerToDistance.Emplace(C, FVector::Distance(C->GetActorLocation(), CurrGraspedIndividual->GetParentActor()->GetActorLocation()));
+		ContainerToDistance.Emplace(C, FVector::Distance(C->GetActorLocation(), GraspedLocation));
 		//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] Container=%s; Dist=%f"),
 		//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *C->GetName(), FVector::Distance(C->GetActorLocation(), CurrGraspedActor->GetActorLocation()));
 	}
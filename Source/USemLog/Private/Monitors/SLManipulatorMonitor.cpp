@@ -248,30 +248,28 @@ void USLManipulatorMonitor::Finish(bool bForced)
 		}
 
 		// Publish dangling recently finished events
-		for (const auto& EvItr : RecentlyEndedGraspEvents)
+		RecentlyEndedGraspEvents.PopExpired(-1.f, GraspConcatenateIfSmaller, [this](const FSLGraspEndEvent& Ev)
 		{
 			if (bLogGraspDebug)
 			{
 				UE_LOG(LogTemp, Error, TEXT("%s::%d \t %.4fs \t\t Grasp Ended ( !!! broadcast !!! through finish): \t\t %s::%s->%s;"),
 					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *GetName(), *EvItr.Other->GetParentActor()->GetName());
+					*GetOwner()->GetName(), *GetName(), *Ev.Other->GetParentActor()->GetName());
 			}
-			OnEndManipulatorGrasp.Broadcast(OwnerIndividualObject, EvItr.Other, EvItr.Time);
-		}
-		RecentlyEndedGraspEvents.Empty();
+			OnEndManipulatorGrasp.Broadcast(OwnerIndividualObject, Ev.Other, Ev.Time);
+		});
 
 		// Publish dangling recently finished events
-		for (const auto& EvItr : RecentlyEndedContactEvents)
+		RecentlyEndedContactEvents.PopExpired(-1.f, ContactConcatenateIfSmaller, [this](const FSLContactEndEvent& Ev)
 		{
 			if (bLogGraspDebug)
 			{
 				UE_LOG(LogTemp, Error, TEXT("%s::%d \t %.4fs \t\t Contact Ended ( !!! broadcast !!! through finish): \t\t %s::%s->%s;"),
 					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *GetName(), *EvItr.Other->GetParentActor()->GetName());
+					*GetOwner()->GetName(), *GetName(), *Ev.Other->GetParentActor()->GetName());
 			}
-			OnEndManipulatorContact.Broadcast(OwnerIndividualObject, EvItr.Other, EvItr.Time);
-		}
-		RecentlyEndedContactEvents.Empty();
+			OnEndManipulatorContact.Broadcast(OwnerIndividualObject, Ev.Other, Ev.Time);
+		});
 
 		// Mark as finished
 		bIsStarted = false;
@@ -860,7 +858,8 @@ void USLManipulatorMonitor::GraspEnded(USLBaseIndividual* OtherIndividual)
 		}
 
 		// Grasp ended
-		RecentlyEndedGraspEvents.Emplace(FSLGraspEndEvent(OtherIndividual, GetWorld()->GetTimeSeconds()));
+		RecentlyEndedGraspEvents.Add(OtherIndividual, GetWorld()->GetTimeSeconds(),
+			FSLGraspEndEvent(OtherIndividual, GetWorld()->GetTimeSeconds()));
 		
 		// Delay publishing for a while, in case the new event is of the same type and should be concatenated
 		if(!GetWorld()->GetTimerManager().IsTimerActive(GraspDelayTimerHandle))
@@ -883,31 +882,25 @@ void USLManipulatorMonitor::DelayedGraspEndCallback()
 	// Curr time (keep very recently added events for another delay)
 	const float CurrTime = GetWorld()->GetTimeSeconds();
 	
-	for (auto EvItr(RecentlyEndedGraspEvents.CreateIterator()); EvItr; ++EvItr)
+	// If enough time has passed, publish the events
+	RecentlyEndedGraspEvents.PopExpired(CurrTime, GraspConcatenateIfSmaller, [this](const FSLGraspEndEvent& Ev)
 	{
-		// If enough time has passed, publish the event
-		if(CurrTime - EvItr->Time > GraspConcatenateIfSmaller)
+		if (bLogGraspDebug)
 		{
-			if (bLogGraspDebug)
-			{
-				UE_LOG(LogTemp, Error, TEXT("%s::%d \t %.4fs \t\t Grasp Ended ( !!! broadcast !!! with delay): \t\t %s::%s->%s;"),
-					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *GetName(), *EvItr->Other->GetParentActor()->GetName());
-			}
-
-			// Broadcast delayed event
-			OnEndManipulatorGrasp.Broadcast(OwnerIndividualObject, EvItr->Other, EvItr->Time);
+			UE_LOG(LogTemp, Error, TEXT("%s::%d \t %.4fs \t\t Grasp Ended ( !!! broadcast !!! with delay): \t\t %s::%s->%s;"),
+				*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
+				*GetOwner()->GetName(), *GetName(), *Ev.Other->GetParentActor()->GetName());
+		}
 
-			// Check if the grasp helper should be ended
-			if (bUseGraspHelper)
-			{
-				GraspHelper.CheckEndGraspHelp(EvItr->Other->GetParentActor());
-			}
+		// Broadcast delayed event
+		OnEndManipulatorGrasp.Broadcast(OwnerIndividualObject, Ev.Other, Ev.Time);
 
-			// Remove event from the pending list
-			EvItr.RemoveCurrent();
+		// Check if the grasp helper should be ended
+		if (bUseGraspHelper)
+		{
+			GraspHelper.CheckEndGraspHelp(Ev.Other->GetParentActor());
 		}
-	}
+	});
 
 	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
 	if(RecentlyEndedGraspEvents.Num() > 0)
@@ -921,24 +914,14 @@ void USLManipulatorMonitor::DelayedGraspEndCallback()
 // Check if this begin event happened right after the previous one ended, if so remove it from the array, and cancel publishing the begin event
 bool USLManipulatorMonitor::IsAJitterGrasp(USLBaseIndividual* OtherIndividual, float StartTime)
 {
-	for (auto EvItr(RecentlyEndedGraspEvents.CreateIterator()); EvItr; ++EvItr)
+	if (RecentlyEndedGraspEvents.RemoveIfJitter(OtherIndividual, StartTime, GraspConcatenateIfSmaller))
 	{
-		// Check if it is an event between the same entities
-		if(EvItr->Other == OtherIndividual)
+		// Check if it was the last event, if so, pause the delay publisher
+		if (RecentlyEndedGraspEvents.Num() == 0)
 		{
-			// Check time difference
-			if(StartTime - EvItr->Time < GraspConcatenateIfSmaller)
-			{
-				EvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedGraspEvents.Num() == 0)
-				{
-					GetWorld()->GetTimerManager().ClearTimer(GraspDelayTimerHandle);
-				}
-				return true;
-			}
+			GetWorld()->GetTimerManager().ClearTimer(GraspDelayTimerHandle);
 		}
+		return true;
 	}
 	return false;
 }
@@ -1007,7 +990,8 @@ void USLManipulatorMonitor::OnBoneContactEnd(USLBaseIndividual* OtherIndividual,
 			}
 
 			// Manipulator contact ended
-			RecentlyEndedContactEvents.Emplace(FSLContactEndEvent(OtherIndividual, GetWorld()->GetTimeSeconds()));
+			RecentlyEndedContactEvents.Add(OtherIndividual, GetWorld()->GetTimeSeconds(),
+				FSLContactEndEvent(OtherIndividual, GetWorld()->GetTimeSeconds()));
 				
 			// Delay publishing for a while, in case the new event is of the same type and should be concatenated
 			if(!GetWorld()->GetTimerManager().IsTimerActive(ContactDelayTimerHandle))
@@ -1066,25 +1050,19 @@ void USLManipulatorMonitor::DelayedContactEndCallback()
 	// Curr time (keep very recently added events for another delay)
 	const float CurrTime = GetWorld()->GetTimeSeconds();
 	
-	for (auto EvItr(RecentlyEndedContactEvents.CreateIterator()); EvItr; ++EvItr)
+	// If enough time has passed, publish the events
+	RecentlyEndedContactEvents.PopExpired(CurrTime, ContactConcatenateIfSmaller, [this](const FSLContactEndEvent& Ev)
 	{
-		// If enough time has passed, publish the event
-		if(CurrTime - EvItr->Time > ContactConcatenateIfSmaller)
+		if (bLogContactDebug)
 		{
-			if (bLogContactDebug)
-			{
-				UE_LOG(LogTemp, Error, TEXT("%s::%d \t %.4fs \t\t Contact Ended ( !!! broadcast !!! with delay): \t\t %s::%s->%s;"),
-					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *GetName(), *EvItr->Other->GetParentActor()->GetName());
-			}
-
-			// Broadcast contact event
-			OnEndManipulatorContact.Broadcast(OwnerIndividualObject, EvItr->Other, EvItr->Time);
-
-			// Remove from the pending list
-			EvItr.RemoveCurrent();
+			UE_LOG(LogTemp, Error, TEXT("%s::%d \t %.4fs \t\t Contact Ended ( !!! broadcast !!! with delay): \t\t %s::%s->%s;"),
+				*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
+				*GetOwner()->GetName(), *GetName(), *Ev.Other->GetParentActor()->GetName());
 		}
-	}
+
+		// Broadcast contact event
+		OnEndManipulatorContact.Broadcast(OwnerIndividualObject, Ev.Other, Ev.Time);
+	});
 
 	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
 	if(RecentlyEndedContactEvents.Num() > 0)
@@ -1098,26 +1076,15 @@ void USLManipulatorMonitor::DelayedContactEndCallback()
 // Check if this begin event happened right after the previous one ended, if so remove it from the array, and cancel publishing the begin event
 bool USLManipulatorMonitor::IsAJitterContact(USLBaseIndividual* InOther, float StartTime)
 {
-	for (auto EvItr(RecentlyEndedContactEvents.CreateIterator()); EvItr; ++EvItr)
+	// Check time difference between the previous and current event, if small the event will be concatenated
+	if (RecentlyEndedContactEvents.RemoveIfJitter(InOther, StartTime, ContactConcatenateIfSmaller))
 	{
-		// Check if it is an event between the same entities
-		if(EvItr->Other == InOther)
+		// Check if it was the last event, if so, pause the delay publisher
+		if (RecentlyEndedContactEvents.Num() == 0)
 		{
-			// Check time difference between the previous and current event
-			const float TimeGap = StartTime - EvItr->Time;
-			if(TimeGap < ContactConcatenateIfSmaller)
-			{
-				// Event will be concatenated
-				EvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedContactEvents.Num() == 0)
-				{
-					GetWorld()->GetTimerManager().ClearTimer(ContactDelayTimerHandle);
-				}
-				return true;
-			}
+			GetWorld()->GetTimerManager().ClearTimer(ContactDelayTimerHandle);
 		}
+		return true;
 	}
 	return false;
 }
@@ -0,0 +1,280 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Monitors/SLMonitorScheduler.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+// Ctor
+USLMonitorScheduler::USLMonitorScheduler() : NextTaskId(0), bIsUpdating(false)
+{
+}
+
+// Clear the groups and log their update cost
+void USLMonitorScheduler::Deinitialize()
+{
+	LogStats();
+	Groups.Empty();
+	TaskLocations.Empty();
+	PendingTasks.Empty();
+	Super::Deinitialize();
+}
+
+// Update the due tasks of every group
+void USLMonitorScheduler::Tick(float DeltaTime)
+{
+	const float CurrTime = GetWorld()->GetTimeSeconds();
+
+	bIsUpdating = true;
+	for (auto& GroupPair : Groups)
+	{
+		UpdateGroup(GroupPair.Value, CurrTime);
+	}
+	bIsUpdating = false;
+
+	// Apply the changes made from inside the updates
+	for (auto& GroupPair : Groups)
+	{
+		if (GroupPair.Value.bHasPendingRemovals)
+		{
+			RemovePendingTasks(GroupPair.Key, GroupPair.Value);
+		}
+	}
+	if (PendingTasks.Num() > 0)
+	{
+		TArray<TPair<FName, FSLMonitorTask>> NewTasks = MoveTemp(PendingTasks);
+		PendingTasks.Reset();
+		for (auto& NewTaskPair : NewTasks)
+		{
+			FSLMonitorGroup& Group = Groups.FindOrAdd(NewTaskPair.Key);
+			const int32 Idx = Group.Tasks.Emplace(MoveTemp(NewTaskPair.Value));
+			TaskLocations.Add(Group.Tasks[Idx].Id, TPair<FName, int32>(NewTaskPair.Key, Idx));
+		}
+	}
+}
+
+// Only tick in game worlds
+bool USLMonitorScheduler::IsTickable() const
+{
+	return !IsTemplate() && GetWorld() && GetWorld()->IsGameWorld() && (Groups.Num() > 0 || PendingTasks.Num() > 0);
+}
+
+// Return the stat id to use for this tickable
+TStatId USLMonitorScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USLMonitorScheduler, STATGROUP_Tickables);
+}
+
+// Get the scheduler of the world
+USLMonitorScheduler* USLMonitorScheduler::Get(UWorld* World)
+{
+	return World ? World->GetSubsystem<USLMonitorScheduler>() : nullptr;
+}
+
+// Add an update callback to the group (every frame if the update rate is 0), returns the task id
+int32 USLMonitorScheduler::Register(FName GroupName, TFunction<void(float)> Update, float UpdateRate, bool bStartEnabled)
+{
+	const float CurrTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.f;
+
+	FSLMonitorTask Task;
+	Task.Id = NextTaskId++;
+	Task.Update = MoveTemp(Update);
+	Task.UpdateRate = FMath::Max(UpdateRate, 0.f);
+	Task.LastUpdateTime = CurrTime;
+	Task.NextUpdateTime = CurrTime + Task.UpdateRate;
+	Task.bEnabled = bStartEnabled;
+
+	// Adding to the groups while updating could invalidate the iterated tasks
+	const int32 TaskId = Task.Id;
+	if (bIsUpdating)
+	{
+		PendingTasks.Emplace(GroupName, MoveTemp(Task));
+		TaskLocations.Add(TaskId, TPair<FName, int32>(GroupName, INDEX_NONE));
+	}
+	else
+	{
+		FSLMonitorGroup& Group = Groups.FindOrAdd(GroupName);
+		TaskLocations.Add(TaskId, TPair<FName, int32>(GroupName, Group.Tasks.Emplace(MoveTemp(Task))));
+	}
+	return TaskId;
+}
+
+// Remove the task, safe to call from inside the updates
+void USLMonitorScheduler::Unregister(int32 TaskId)
+{
+	const TPair<FName, int32>* Location = TaskLocations.Find(TaskId);
+	if (!Location)
+	{
+		return;
+	}
+
+	// Not yet added to its group
+	if (Location->Value == INDEX_NONE)
+	{
+		PendingTasks.RemoveAll([TaskId](const TPair<FName, FSLMonitorTask>& P) { return P.Value.Id == TaskId; });
+		TaskLocations.Remove(TaskId);
+		return;
+	}
+
+	const FName GroupName = Location->Key;
+	FSLMonitorGroup& Group = Groups.FindChecked(GroupName);
+	FSLMonitorTask& Task = Group.Tasks[Location->Value];
+	Task.bEnabled = false;
+	Task.bPendingRemoval = true;
+	Group.bHasPendingRemovals = true;
+	if (!bIsUpdating)
+	{
+		RemovePendingTasks(GroupName, Group);
+	}
+}
+
+// Enable or disable the task updates, enabling restarts the update interval
+void USLMonitorScheduler::SetEnabled(int32 TaskId, bool bEnabled)
+{
+	if (FSLMonitorTask* Task = FindTask(TaskId))
+	{
+		if (bEnabled && !Task->bEnabled)
+		{
+			const float CurrTime = GetWorld()->GetTimeSeconds();
+			Task->LastUpdateTime = CurrTime;
+			Task->NextUpdateTime = CurrTime + Task->UpdateRate;
+		}
+		Task->bEnabled = bEnabled && !Task->bPendingRemoval;
+	}
+}
+
+// Check if the task updates are enabled
+bool USLMonitorScheduler::IsEnabled(int32 TaskId) const
+{
+	const FSLMonitorTask* Task = FindTask(TaskId);
+	return Task && Task->bEnabled;
+}
+
+// Set the update rate of the task
+void USLMonitorScheduler::SetUpdateRate(int32 TaskId, float UpdateRate)
+{
+	if (FSLMonitorTask* Task = FindTask(TaskId))
+	{
+		Task->UpdateRate = FMath::Max(UpdateRate, 0.f);
+		Task->NextUpdateTime = Task->LastUpdateTime + Task->UpdateRate;
+	}
+}
+
+// Set the max time spent per frame updating the group in milliseconds (unlimited if 0)
+void USLMonitorScheduler::SetTimeBudget(FName GroupName, float TimeBudgetMs)
+{
+	Groups.FindOrAdd(GroupName).TimeBudget = FMath::Max(TimeBudgetMs, 0.f) * 0.001f;
+}
+
+// Get the update cost of the group
+const FSLMonitorGroupStats* USLMonitorScheduler::GetStats(FName GroupName) const
+{
+	const FSLMonitorGroup* Group = Groups.Find(GroupName);
+	return Group ? &Group->Stats : nullptr;
+}
+
+// Log the update cost of every group
+void USLMonitorScheduler::LogStats() const
+{
+	for (const auto& GroupPair : Groups)
+	{
+		const FSLMonitorGroupStats& Stats = GroupPair.Value.Stats;
+		if (Stats.NumUpdates == 0)
+		{
+			continue;
+		}
+		UE_LOG(LogTemp, Log, TEXT("%s::%d [%s] Tasks=%d; Updates=%lld; Total=%.3fms; Avg=%.4fms; MaxFrame=%.3fms; BudgetExceeded=%lld;"),
+			*FString(__func__), __LINE__, *GroupPair.Key.ToString(), GroupPair.Value.Tasks.Num(), Stats.NumUpdates,
+			Stats.TotalTime * 1000.0, Stats.TotalTime * 1000.0 / Stats.NumUpdates, Stats.MaxFrameTime * 1000.0,
+			Stats.NumBudgetExceeded);
+	}
+}
+
+// Update the due tasks of the group until the budget is exceeded
+void USLMonitorScheduler::UpdateGroup(FSLMonitorGroup& Group, float CurrTime)
+{
+	const int32 NumTasks = Group.Tasks.Num();
+	if (NumTasks == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumUpdated = 0;
+	for (int32 NumChecked = 0; NumChecked < NumTasks; ++NumChecked)
+	{
+		if (Group.NextTaskIdx >= NumTasks)
+		{
+			Group.NextTaskIdx = 0;
+		}
+		FSLMonitorTask& Task = Group.Tasks[Group.NextTaskIdx++];
+		if (!Task.bEnabled || CurrTime < Task.NextUpdateTime)
+		{
+			continue;
+		}
+
+		const float DeltaTime = CurrTime - Task.LastUpdateTime;
+		Task.LastUpdateTime = CurrTime;
+		Task.NextUpdateTime = CurrTime + Task.UpdateRate;
+		Task.Update(DeltaTime);
+		NumUpdated++;
+
+		// Continue with the next task in the following frame
+		if (Group.TimeBudget > 0.f && FPlatformTime::Seconds() - StartTime > Group.TimeBudget)
+		{
+			Group.Stats.NumBudgetExceeded++;
+			break;
+		}
+	}
+
+	if (NumUpdated > 0)
+	{
+		const double FrameTime = FPlatformTime::Seconds() - StartTime;
+		Group.Stats.NumUpdates += NumUpdated;
+		Group.Stats.TotalTime += FrameTime;
+		Group.Stats.MaxFrameTime = FMath::Max(Group.Stats.MaxFrameTime, FrameTime);
+	}
+}
+
+// Remove the tasks marked for removal and update the index map
+void USLMonitorScheduler::RemovePendingTasks(FName GroupName, FSLMonitorGroup& Group)
+{
+	for (const auto& Task : Group.Tasks)
+	{
+		if (Task.bPendingRemoval)
+		{
+			TaskLocations.Remove(Task.Id);
+		}
+	}
+	Group.Tasks.RemoveAll([](const FSLMonitorTask& Task) { return Task.bPendingRemoval; });
+	for (int32 Idx = 0; Idx < Group.Tasks.Num(); ++Idx)
+	{
+		TaskLocations.FindChecked(Group.Tasks[Idx].Id).Value = Idx;
+	}
+	Group.NextTaskIdx = 0;
+	Group.bHasPendingRemovals = false;
+}
+
+// Get the task from its id
+FSLMonitorTask* USLMonitorScheduler::FindTask(int32 TaskId)
+{
+	return const_cast<FSLMonitorTask*>(static_cast<const USLMonitorScheduler*>(this)->FindTask(TaskId));
+}
+
+// Get the task from its id
+const FSLMonitorTask* USLMonitorScheduler::FindTask(int32 TaskId) const
+{
+	const TPair<FName, int32>* Location = TaskLocations.Find(TaskId);
+	if (!Location)
+	{
+		return nullptr;
+	}
+
+	if (Location->Value == INDEX_NONE)
+	{
+		const TPair<FName, FSLMonitorTask>* Pending = PendingTasks.FindByPredicate(
+			[TaskId](const TPair<FName, FSLMonitorTask>& P) { return P.Value.Id == TaskId; });
+		return Pending ? &Pending->Value : nullptr;
+	}
+	return &Groups.FindChecked(Location->Key).Tasks[Location->Value];
+}
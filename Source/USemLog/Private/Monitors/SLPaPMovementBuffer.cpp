@@ -0,0 +1,126 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Monitors/SLPaPMovementBuffer.h"
+
+// Allocate the buffer (the capacity is rounded up to a power of two)
+FSLPaPMovementBuffer::FSLPaPMovementBuffer(int32 InCapacity) : FirstSeq(0), NextSeq(0), MaximaFirst(0), MaximaNext(0)
+{
+	const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2));
+	Mask = Capacity - 1;
+	Samples.SetNumUninitialized(Capacity);
+	HeightMaxima.SetNumUninitialized(Capacity);
+}
+
+// Add a new sample
+void FSLPaPMovementBuffer::Add(float Time, const FVector& Location)
+{
+	// Overwrite the oldest sample if full
+	if (static_cast<uint32>(Num()) > Mask)
+	{
+		RemoveFirst();
+	}
+
+	FSLPaPMovementSample& Sample = Samples[NextSeq & Mask];
+	Sample.PathLength = Num() > 0 ? Last().PathLength + FVector::Distance(Last().Location, Location) : 0.f;
+	Sample.Time = Time;
+	Sample.Location = Location;
+
+	// Older samples which are not higher than the new one can never be the newest higher sample
+	while (MaximaNext != MaximaFirst && Samples[HeightMaxima[(MaximaNext - 1) & Mask] & Mask].Location.Z <= Location.Z)
+	{
+		MaximaNext--;
+	}
+	HeightMaxima[MaximaNext++ & Mask] = NextSeq++;
+}
+
+// Remove the samples older than the duration relative to the newest sample
+void FSLPaPMovementBuffer::RemoveOlderThan(float Duration)
+{
+	while (Num() > 0 && Last().Time - (*this)[0].Time > Duration)
+	{
+		RemoveFirst();
+	}
+}
+
+// Remove all samples (keeps the allocation)
+void FSLPaPMovementBuffer::Reset()
+{
+	FirstSeq = NextSeq = 0;
+	MaximaFirst = MaximaNext = 0;
+}
+
+// Index of the newest sample higher than the given value, INDEX_NONE if none
+int32 FSLPaPMovementBuffer::FindLastHigherThan(float Z) const
+{
+	// The newest higher sample is always a height maximum, binary search the descending heights
+	int32 Low = 0;
+	int32 High = static_cast<int32>(MaximaNext - MaximaFirst) - 1;
+	int32 Found = INDEX_NONE;
+	while (Low <= High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		const uint32 Seq = HeightMaxima[(MaximaFirst + Mid) & Mask];
+		if (Samples[Seq & Mask].Location.Z > Z)
+		{
+			Found = static_cast<int32>(Seq - FirstSeq);
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid - 1;
+		}
+	}
+	return Found;
+}
+
+// Index of the newest sample in [MinIdx, MaxIdx] further than the distance from the location, INDEX_NONE if none
+int32 FSLPaPMovementBuffer::FindLastFurtherThan(const FVector& Location, float Dist, int32 MaxIdx, int32 MinIdx) const
+{
+	int32 Idx = FMath::Min(MaxIdx, Num() - 1);
+	while (Idx >= MinIdx && Idx >= 0)
+	{
+		const FSLPaPMovementSample& Sample = (*this)[Idx];
+		const float SampleDist = FVector::Distance(Sample.Location, Location);
+		if (SampleDist > Dist)
+		{
+			return Idx;
+		}
+
+		// An older sample can only be further if the path between the two is longer than the missing distance
+		Idx = FindLastPathLengthBelow(Sample.PathLength - (Dist - SampleDist) + PathLengthTolerance, Idx - 1);
+	}
+	return INDEX_NONE;
+}
+
+// Index of the newest sample in [0, MaxIdx] with a path length smaller than the value, INDEX_NONE if none
+int32 FSLPaPMovementBuffer::FindLastPathLengthBelow(float Value, int32 MaxIdx) const
+{
+	int32 Low = 0;
+	int32 High = MaxIdx;
+	int32 Found = INDEX_NONE;
+	while (Low <= High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if ((*this)[Mid].PathLength < Value)
+		{
+			Found = Mid;
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid - 1;
+		}
+	}
+	return Found;
+}
+
+// Remove the oldest sample
+void FSLPaPMovementBuffer::RemoveFirst()
+{
+	if (MaximaNext != MaximaFirst && HeightMaxima[MaximaFirst & Mask] == FirstSeq)
+	{
+		MaximaFirst++;
+	}
+	FirstSeq++;
+}
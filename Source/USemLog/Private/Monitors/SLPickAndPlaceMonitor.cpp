@@ -3,17 +3,17 @@
 
 #include "Monitors/SLPickAndPlaceMonitor.h"
 #include "Monitors/SLManipulatorMonitor.h"
+#include "Monitors/SLMonitorScheduler.h"
 #include "Individuals/SLIndividualComponent.h"
 #include "Individuals/Type/SLBaseIndividual.h"
 #include "Animation/SkeletalMeshActor.h"
 
 // Sets default values for this component's properties
-USLPickAndPlaceMonitor::USLPickAndPlaceMonitor()
+USLPickAndPlaceMonitor::USLPickAndPlaceMonitor() : RecentMovementBuffer(RecentMovementBufferSize)
 {
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.bCanEverTick = false;
 	
 	bIgnore = false;
 	bLogDebug = false;
@@ -30,6 +30,7 @@ USLPickAndPlaceMonitor::USLPickAndPlaceMonitor()
 	
 	// Default values
 	UpdateRate = 0.029f;
+	ScheduledUpdateId = INDEX_NONE;
 
 	// Slide detection
 	MinSlideDistXY = 9.f;
@@ -52,9 +53,6 @@ USLPickAndPlaceMonitor::USLPickAndPlaceMonitor()
 
 	/* PickUp */
 	bPickUpHappened = false;
-
-	/* PutDown */
-	RecentMovementBuffer.Reserve(RecentMovementBufferSize);
 }
 
 // Dtor
@@ -72,13 +70,6 @@ void USLPickAndPlaceMonitor::BeginPlay()
 	Super::BeginPlay();
 }
 
-// Called every frame, used for timeline visualizations, activated and deactivated on request
-void USLPickAndPlaceMonitor::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	(this->*UpdateFunctionPtr)();
-}
-
 // Init listener
 void USLPickAndPlaceMonitor::Init()
 {
@@ -126,11 +117,8 @@ void USLPickAndPlaceMonitor::Start()
 		// Subscribe for grasp notifications from sibling component
 		if(SubscribeForGraspEvents())
 		{
-			// Set tick update rate
-			if(UpdateRate > 0.f)
-			{
-				SetComponentTickInterval(UpdateRate);
-			}
+			// Updates are started and stopped with the grasps
+			RegisterScheduledUpdate();
 
 			// Mark as started
 			bIsStarted = true;
@@ -154,8 +142,8 @@ void USLPickAndPlaceMonitor::Finish(float EndTime, bool bForced)
 		EventCheckState = ESLPaPStateCheck::NONE;
 		UpdateFunctionPtr = &USLPickAndPlaceMonitor::Update_NONE;
 
-		// Make sure tick is disabled
-		SetComponentTickEnabled(false);
+		// Make sure the update is removed
+		UnregisterScheduledUpdate();
 
 		// Mark as finished
 		bIsStarted = false;
@@ -248,9 +236,9 @@ void USLPickAndPlaceMonitor::OnManipulatorGraspBegin(USLBaseIndividual* Self, US
 		}
 
 		// Start update
-		if (!IsComponentTickEnabled())
+		if (!IsScheduledUpdateEnabled())
 		{
-			SetComponentTickEnabled(true);
+			SetScheduledUpdateEnabled(true);
 		}
 		else
 		{
@@ -311,9 +299,9 @@ void USLPickAndPlaceMonitor::OnManipulatorGraspEnd(USLBaseIndividual* Self, USLB
 	UpdateFunctionPtr = &USLPickAndPlaceMonitor::Update_NONE;
 
 	// Stop update
-	if (IsComponentTickEnabled())
+	if (IsScheduledUpdateEnabled())
 	{
-		SetComponentTickEnabled(false);
+		SetScheduledUpdateEnabled(false);
 	}
 	else
 	{
@@ -354,7 +342,7 @@ void USLPickAndPlaceMonitor::FinishActiveEvent(float CurrTime)
 }
 
 // Backtrace and check if a put-down event happened
-bool USLPickAndPlaceMonitor::HasPutDownEventHappened(const float CurrTime, const FVector& CurrObjLocation, uint32& OutPutDownEndIdx)
+bool USLPickAndPlaceMonitor::HasPutDownEventHappened(const float CurrTime, const FVector& CurrObjLocation, int32& OutPutDownEndIdx)
 {
 	if (bLogAllEventsDebug || bLogTransportPutDownDebug)
 	{
@@ -362,20 +350,16 @@ bool USLPickAndPlaceMonitor::HasPutDownEventHappened(const float CurrTime, const
 			*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(), *GetOwner()->GetName());
 	}
 
-	// Backtrack movement buffer and see when put-down might have started
-	OutPutDownEndIdx = RecentMovementBuffer.Num() - 1;
-	while(OutPutDownEndIdx > 0 && CurrTime - RecentMovementBuffer[OutPutDownEndIdx].Key < PutDownMovementBacktrackDuration)
+	// Backtrack movement buffer and see when put-down might have started (the newest higher sample within the backtrack duration)
+	OutPutDownEndIdx = RecentMovementBuffer.FindLastHigherThan(CurrObjLocation.Z + MinPutDownHeight);
+	if(OutPutDownEndIdx > 0 && CurrTime - RecentMovementBuffer[OutPutDownEndIdx].Time < PutDownMovementBacktrackDuration)
 	{
-		if(RecentMovementBuffer[OutPutDownEndIdx].Value.Z - CurrObjLocation.Z > MinPutDownHeight)
+		if (bLogAllEventsDebug || bLogTransportPutDownDebug)
 		{
-			if (bLogAllEventsDebug || bLogTransportPutDownDebug)
-			{
-				UE_LOG(LogTemp, Error, TEXT("%s::%d::%.4fs %s put-down happened at index=%d.."),
-					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(), *GetOwner()->GetName(), OutPutDownEndIdx);
-			}
-			return true;
+			UE_LOG(LogTemp, Error, TEXT("%s::%d::%.4fs %s put-down happened at index=%d.."),
+				*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(), *GetOwner()->GetName(), OutPutDownEndIdx);
 		}
-		OutPutDownEndIdx--;
+		return true;
 	}
 
 	// No put-down has been found in the movement buffer
@@ -603,30 +587,34 @@ void USLPickAndPlaceMonitor::Update_TransportOrPutDown()
 		}
 
 		// Check for the PutDown movement start time
-		uint32 PutDownEndIdx = 0;
+		int32 PutDownEndIdx = INDEX_NONE;
 		if(HasPutDownEventHappened(CurrTime, CurrObjLocation, PutDownEndIdx))
 		{
 			float PutDownStartTime = -1.f;
-			while(PutDownEndIdx > 0)
+
+			// Check when the put-down limits were last crossed (newest sample too high or too far, ignoring the oldest one),
+			// the newer samples are lower than the put-down end, so the newest too high sample is never past it
+			const int32 TooHighIdx = FMath::Min(RecentMovementBuffer.FindLastHigherThan(CurrObjLocation.Z + MaxPutDownHeight), PutDownEndIdx);
+			int32 PutDownStartIdx = RecentMovementBuffer.FindLastFurtherThan(CurrObjLocation, MaxPutDownDistXY,
+				PutDownEndIdx, FMath::Max(TooHighIdx + 1, 1));
+			if(PutDownStartIdx == INDEX_NONE && TooHighIdx > 0)
 			{
-				// Check when the 
-				if(RecentMovementBuffer[PutDownEndIdx].Value.Z - CurrObjLocation.Z > MaxPutDownHeight
-					|| FVector::Distance(RecentMovementBuffer[PutDownEndIdx].Value, CurrObjLocation) > MaxPutDownDistXY)
+				PutDownStartIdx = TooHighIdx;
+			}
+
+			if(PutDownStartIdx > 0)
+			{
+				PutDownStartTime = RecentMovementBuffer[PutDownStartIdx].Time;
+
+				if (bLogAllEventsDebug || bLogTransportPutDownDebug)
 				{
-					PutDownStartTime = RecentMovementBuffer[PutDownEndIdx].Key;
-
-					if (bLogAllEventsDebug || bLogTransportPutDownDebug)
-					{
-						UE_LOG(LogTemp, Error, TEXT("%s::%d::%.4fs %s's grasped object %s **TRASNPORT** (%.4f-%.4f) with **PUT-DOWN** (%.4f-%.4f) .."),
-							*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-							*GetOwner()->GetName(), *CurrGraspedIndividual->GetParentActor()->GetName(),
-							PrevRelevantTime, PutDownStartTime, PutDownStartTime, CurrTime);
-					}
-					OnManipulatorTransportEvent.Broadcast(OwnerIndividualObject, CurrGraspedIndividual, PrevRelevantTime, PutDownStartTime);
-					OnManipulatorPutDownEvent.Broadcast(OwnerIndividualObject, CurrGraspedIndividual, PutDownStartTime, CurrTime);
-					break;
+					UE_LOG(LogTemp, Error, TEXT("%s::%d::%.4fs %s's grasped object %s **TRASNPORT** (%.4f-%.4f) with **PUT-DOWN** (%.4f-%.4f) .."),
+						*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
+						*GetOwner()->GetName(), *CurrGraspedIndividual->GetParentActor()->GetName(),
+						PrevRelevantTime, PutDownStartTime, PutDownStartTime, CurrTime);
 				}
-				PutDownEndIdx--;
+				OnManipulatorTransportEvent.Broadcast(OwnerIndividualObject, CurrGraspedIndividual, PrevRelevantTime, PutDownStartTime);
+				OnManipulatorPutDownEvent.Broadcast(OwnerIndividualObject, CurrGraspedIndividual, PutDownStartTime, CurrTime);
 			}
 
 			// If the limits are not crossed in the buffer the oldest available time is used (TODO, or should we ignore the action?)
@@ -634,7 +622,7 @@ void USLPickAndPlaceMonitor::Update_TransportOrPutDown()
 			{
 				//UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] The limits were not crossed in the available data in the buffer, the oldest available time is used"),
 				//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
-				PutDownStartTime = RecentMovementBuffer[0].Key;
+				PutDownStartTime = RecentMovementBuffer[0].Time;
 
 				//UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] \t ############## TRANSPORT ##############  [%f <--> %f]"),
 				//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), PrevRelevantTime, PutDownStartTime);
@@ -658,7 +646,7 @@ void USLPickAndPlaceMonitor::Update_TransportOrPutDown()
 		}
 
 		// Clear movement buffer
-		RecentMovementBuffer.Reset(RecentMovementBufferSize);
+		RecentMovementBuffer.Reset();
 
 		if (bLogAllEventsDebug || bLogSlideDebug)
 		{
@@ -678,22 +666,14 @@ void USLPickAndPlaceMonitor::Update_TransportOrPutDown()
 		// Cache recent movements 
 		if(RecentMovementBuffer.Num() > 1)
 		{
-			RecentMovementBuffer.Push(TPair<float, FVector>(CurrTime, CurrObjLocation));
+			RecentMovementBuffer.Add(CurrTime, CurrObjLocation);
 
 			// Remove values older than RecentMovementBufferDuration
-			int32 Count = 0;
-			while(RecentMovementBuffer.Last().Key - RecentMovementBuffer[Count].Key > RecentMovementBufferDuration)
-			{
-				Count++;
-			}
-			if(Count > 0)
-			{
-				RecentMovementBuffer.RemoveAt(0, Count, false);
-			}
+			RecentMovementBuffer.RemoveOlderThan(RecentMovementBufferDuration);
 		}
 		else
 		{
-			RecentMovementBuffer.Push(TPair<float, FVector>(CurrTime, CurrObjLocation));
+			RecentMovementBuffer.Add(CurrTime, CurrObjLocation);
 		}
 	}
 }
@@ -714,3 +694,44 @@ ISLContactMonitorInterface* USLPickAndPlaceMonitor::GetContactMonitorComponent(A
 	return nullptr;
 }
 
+// Register the update with the world monitor scheduler (replaces the component tick)
+void USLPickAndPlaceMonitor::RegisterScheduledUpdate()
+{
+	if (USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(GetWorld()))
+	{
+		TWeakObjectPtr<USLPickAndPlaceMonitor> WeakThis(this);
+		ScheduledUpdateId = Scheduler->Register(TEXT("PickAndPlace"), [WeakThis](float DeltaTime)
+		{
+			if (USLPickAndPlaceMonitor* This = WeakThis.Get())
+			{
+				(This->*This->UpdateFunctionPtr)();
+			}
+		}, UpdateRate);
+	}
+}
+
+// Remove the update from the world monitor scheduler
+void USLPickAndPlaceMonitor::UnregisterScheduledUpdate()
+{
+	if (USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(GetWorld()))
+	{
+		Scheduler->Unregister(ScheduledUpdateId);
+	}
+	ScheduledUpdateId = INDEX_NONE;
+}
+
+// Enable or disable the scheduled update
+void USLPickAndPlaceMonitor::SetScheduledUpdateEnabled(bool bEnabled)
+{
+	if (USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(GetWorld()))
+	{
+		Scheduler->SetEnabled(ScheduledUpdateId, bEnabled);
+	}
+}
+
+// Check if the scheduled update is enabled
+bool USLPickAndPlaceMonitor::IsScheduledUpdateEnabled() const
+{
+	const USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(GetWorld());
+	return Scheduler && Scheduler->IsEnabled(ScheduledUpdateId);
+}
@@ -4,6 +4,7 @@
 #include "Monitors/SLReachAndPreGraspMonitor.h"
 #include "Monitors/SLMonitorStructs.h"
 #include "Monitors/SLManipulatorMonitor.h"
+#include "Monitors/SLMonitorScheduler.h"
 #include "Individuals/SLIndividualComponent.h"
 #include "Individuals/SLIndividualUtils.h"
 #include "Individuals/Type/SLBaseIndividual.h"
@@ -13,13 +14,64 @@
 #include "TimerManager.h"
 #include "Components/StaticMeshComponent.h"
 
+// Add the candidate (or reset its values if it already exists), returns its index
+int32 FSLReachCandidates::Add(USLBaseIndividual* Individual, USceneComponent* Root, const FVector& Location, float StartTime, float Dist)
+{
+	int32 Idx = Find(Individual);
+	if (Idx == INDEX_NONE)
+	{
+		Idx = Individuals.Add(Individual);
+		Roots.Add(Root);
+		Locations.AddUninitialized();
+		StartTimes.AddUninitialized();
+		Dists.AddUninitialized();
+		Moved.AddUninitialized();
+		TransformUpdatedHandles.AddDefaulted();
+		Indexes.Add(Individual, Idx);
+	}
+	Locations[Idx] = Location;
+	StartTimes[Idx] = StartTime;
+	Dists[Idx] = Dist;
+	Moved[Idx] = true;
+	return Idx;
+}
+
+// Remove the candidate at the index, the last candidate takes its place
+void FSLReachCandidates::RemoveAtSwap(int32 Idx)
+{
+	Indexes.Remove(Individuals[Idx]);
+	Individuals.RemoveAtSwap(Idx, 1, false);
+	Roots.RemoveAtSwap(Idx, 1, false);
+	Locations.RemoveAtSwap(Idx, 1, false);
+	StartTimes.RemoveAtSwap(Idx, 1, false);
+	Dists.RemoveAtSwap(Idx, 1, false);
+	Moved.RemoveAtSwap(Idx, 1, false);
+	TransformUpdatedHandles.RemoveAtSwap(Idx, 1, false);
+	if (Individuals.IsValidIndex(Idx))
+	{
+		Indexes.Add(Individuals[Idx], Idx);
+	}
+}
+
+// Remove all candidates
+void FSLReachCandidates::Empty()
+{
+	Individuals.Reset();
+	Roots.Reset();
+	Locations.Reset();
+	StartTimes.Reset();
+	Dists.Reset();
+	Moved.Reset();
+	TransformUpdatedHandles.Reset();
+	Indexes.Reset();
+}
+
 // Set default values
 USLReachAndPreGraspMonitor::USLReachAndPreGraspMonitor()
 {
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.bCanEverTick = false;
 
 	InitSphereRadius(30.f);
 
@@ -34,7 +86,10 @@ USLReachAndPreGraspMonitor::USLReachAndPreGraspMonitor()
 
 	// Default values
 	UpdateRate = 0.037;
+	ScheduledUpdateId = INDEX_NONE;
+	bEventDrivenCandidateUpdates = true;
 	ConcatenateIfSmaller = 0.4f;
+	PrevManipulatorLocation = FVector::ZeroVector;
 
 	ShapeColor = FColor::Orange.WithAlpha(64);
 
@@ -51,13 +106,6 @@ USLReachAndPreGraspMonitor::~USLReachAndPreGraspMonitor()
 	}
 }
 
-// Called every frame, used for timeline visualizations, activated and deactivated on request
-void USLReachAndPreGraspMonitor::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	UpdateCandidatesData(DeltaTime);
-}
-
 // Initialize trigger areas for runtime, check if owner is valid and semantically annotated
 void USLReachAndPreGraspMonitor::Init()
 {
@@ -87,11 +135,8 @@ void USLReachAndPreGraspMonitor::Init()
 			return;
 		}
 
-		// Set tick update rate
-		if (UpdateRate > 0.f)
-		{
-			SetComponentTickInterval(UpdateRate);
-		}
+		// Candidates are updated by the world monitor scheduler, enabled while there are candidates
+		RegisterScheduledUpdate();
 		
 		// Disable overlaps until start
 		SetGenerateOverlapEvents(false);
@@ -138,7 +183,8 @@ void USLReachAndPreGraspMonitor::Finish(bool bForced)
 	{
 		OnComponentBeginOverlap.RemoveAll(this);
 		OnComponentEndOverlap.RemoveAll(this);
-		SetComponentTickEnabled(false);
+		UnregisterScheduledUpdate();
+		EmptyCandidates();
 		
 		// Mark as finished
 		bIsStarted = false;
@@ -240,10 +286,52 @@ void USLReachAndPreGraspMonitor::UpdateCandidatesData(float DeltaTime)
 	}
 
 	const float CurrTimestamp = GetWorld()->GetTimeSeconds();
-	for (auto& CanidateData : CandidatesData)
+	const FVector ManipulatorLocation = GetOwner()->GetActorLocation();
+	const bool bManipulatorMoved = ManipulatorLocation != PrevManipulatorLocation;
+	PrevManipulatorLocation = ManipulatorLocation;
+
+	// Sample the candidate locations (in the event driven mode these are set by the transform updates)
+	const int32 NumCandidates = CandidatesData.Num();
+	if (!bEventDrivenCandidateUpdates)
+	{
+		for (int32 Idx = 0; Idx < NumCandidates; ++Idx)
+		{
+			if (USceneComponent* Root = CandidatesData.Roots[Idx].Get())
+			{
+				const FVector CurrLocation = Root->GetComponentLocation();
+				if (CurrLocation != CandidatesData.Locations[Idx])
+				{
+					CandidatesData.Locations[Idx] = CurrLocation;
+					CandidatesData.Moved[Idx] = true;
+				}
+			}
+		}
+	}
+
+	// The distances only change if the manipulator or the candidates moved
+	CandidatesData.CurrDists.SetNumUninitialized(NumCandidates, false);
+	if (bManipulatorMoved)
+	{
+		for (int32 Idx = 0; Idx < NumCandidates; ++Idx)
+		{
+			CandidatesData.CurrDists[Idx] = FVector::Distance(ManipulatorLocation, CandidatesData.Locations[Idx]);
+		}
+	}
+
+	for (int32 Idx = 0; Idx < NumCandidates; ++Idx)
 	{
-		const float CurrDist = FVector::Distance(GetOwner()->GetActorLocation(), CanidateData.Key->GetParentActor()->GetActorLocation());
-		const float PrevDist = CanidateData.Value.Get<1>();
+		if (!bManipulatorMoved)
+		{
+			if (!CandidatesData.Moved[Idx])
+			{
+				continue;
+			}
+			CandidatesData.CurrDists[Idx] = FVector::Distance(ManipulatorLocation, CandidatesData.Locations[Idx]);
+		}
+		CandidatesData.Moved[Idx] = false;
+
+		const float CurrDist = CandidatesData.CurrDists[Idx];
+		const float PrevDist = CandidatesData.Dists[Idx];
 		const float DiffDist = PrevDist - CurrDist;
 
 		// Ignore small difference changes (IgnoreMovementsSmallerThanValue)
@@ -253,23 +341,23 @@ void USLReachAndPreGraspMonitor::UpdateCandidatesData(float DeltaTime)
 			{
 				UE_LOG(LogTemp, Warning, TEXT("%s::%d::%.4f %s's is moving closer to %s; (PrevDist=%f; CurrDist=%f; DiffDist=%f;)"),
 					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *CanidateData.Key->GetParentActor()->GetName(),
+					*GetOwner()->GetName(), *CandidatesData.Individuals[Idx]->GetParentActor()->GetName(),
 					PrevDist, CurrDist, DiffDist);
 			}
 			// Positive difference makes the hand closer to the object, update the distance
-			CanidateData.Value.Get<ESLTimeAndDist::SLDist>() = CurrDist;
+			CandidatesData.Dists[Idx] = CurrDist;
 		}
 		else if (DiffDist < -IgnoreMovementsSmallerThanValue)
 		{
 			// Negative difference makes the hand further away from the object, update distance, reset the start time
-			CanidateData.Value.Get<ESLTimeAndDist::SLTime>() = CurrTimestamp;
-			CanidateData.Value.Get<ESLTimeAndDist::SLDist>() = CurrDist;
+			CandidatesData.StartTimes[Idx] = CurrTimestamp;
+			CandidatesData.Dists[Idx] = CurrDist;
 
 			if (bLogVerboseDebug)
 			{
 				UE_LOG(LogTemp, Warning, TEXT("%s::%d::%.4f %s's is moving further to %s; (PrevDist=%f; CurrDist=%f; DiffDist=%f;)"),
 					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *CanidateData.Key->GetParentActor()->GetName(),
+					*GetOwner()->GetName(), *CandidatesData.Individuals[Idx]->GetParentActor()->GetName(),
 					PrevDist, CurrDist, DiffDist);
 			}
 		}
@@ -280,13 +368,70 @@ void USLReachAndPreGraspMonitor::UpdateCandidatesData(float DeltaTime)
 			{
 				UE_LOG(LogTemp, Warning, TEXT("%s::%d::%.4f %s's is idling relative to %s; (PrevDist=%f; CurrDist=%f; DiffDist=%f;)"),
 					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *CanidateData.Key->GetParentActor()->GetName(),
+					*GetOwner()->GetName(), *CandidatesData.Individuals[Idx]->GetParentActor()->GetName(),
 					PrevDist, CurrDist, DiffDist);
 			}
 		}
 	}
 }
 
+// Add the individual as a reach candidate, listen to its transform updates if event driven
+void USLReachAndPreGraspMonitor::AddCandidate(USLBaseIndividual* Individual, AActor* Actor)
+{
+	USceneComponent* Root = Actor->GetRootComponent();
+	const FVector Location = Actor->GetActorLocation();
+	const float Dist = FVector::Distance(GetOwner()->GetActorLocation(), Location);
+	const bool bIsNew = !CandidatesData.Contains(Individual);
+	const int32 Idx = CandidatesData.Add(Individual, Root, Location, GetWorld()->GetTimeSeconds(), Dist);
+	if (bIsNew && bEventDrivenCandidateUpdates && Root)
+	{
+		CandidatesData.TransformUpdatedHandles[Idx] = Root->TransformUpdated.AddUObject(
+			this, &USLReachAndPreGraspMonitor::OnCandidateTransformUpdated, Individual);
+	}
+}
+
+// Remove the reach candidate, returns false if it was not a candidate
+bool USLReachAndPreGraspMonitor::RemoveCandidate(USLBaseIndividual* Individual)
+{
+	const int32 Idx = CandidatesData.Find(Individual);
+	if (Idx == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (USceneComponent* Root = CandidatesData.Roots[Idx].Get())
+	{
+		Root->TransformUpdated.Remove(CandidatesData.TransformUpdatedHandles[Idx]);
+	}
+	CandidatesData.RemoveAtSwap(Idx);
+	return true;
+}
+
+// Remove all reach candidates
+void USLReachAndPreGraspMonitor::EmptyCandidates()
+{
+	for (int32 Idx = 0; Idx < CandidatesData.Num(); ++Idx)
+	{
+		if (USceneComponent* Root = CandidatesData.Roots[Idx].Get())
+		{
+			Root->TransformUpdated.Remove(CandidatesData.TransformUpdatedHandles[Idx]);
+		}
+	}
+	CandidatesData.Empty();
+}
+
+// Called when a candidate moved (event driven updates)
+void USLReachAndPreGraspMonitor::OnCandidateTransformUpdated(USceneComponent* UpdatedComponent,
+	EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, USLBaseIndividual* Individual)
+{
+	const int32 Idx = CandidatesData.Find(Individual);
+	if (Idx != INDEX_NONE)
+	{
+		CandidatesData.Locations[Idx] = UpdatedComponent->GetComponentLocation();
+		CandidatesData.Moved[Idx] = true;
+	}
+}
+
 // Publish currently overlapping components
 void USLReachAndPreGraspMonitor::TriggerInitialOverlaps()
 {
@@ -362,8 +507,7 @@ void USLReachAndPreGraspMonitor::OnOverlapBegin(UPrimitiveComponent* OverlappedC
 	// Check if the individual can be a reach candidate
 	if (CanBeACandidate(OtherActor))
 	{
-		const float Dist = FVector::Distance(GetOwner()->GetActorLocation(), OtherActor->GetActorLocation());
-		CandidatesData.Emplace(OtherIndividual, MakeTuple(GetWorld()->GetTimeSeconds(), Dist));
+		AddCandidate(OtherIndividual, OtherActor);
 
 		if (bLogDebug)
 		{
@@ -373,14 +517,14 @@ void USLReachAndPreGraspMonitor::OnOverlapBegin(UPrimitiveComponent* OverlappedC
 		}
 
 		// Make sure the candidate update check is running
-		if (!IsComponentTickEnabled())
+		if (!IsScheduledUpdateEnabled())
 		{
 			if (bLogDebug)
 			{
 				UE_LOG(LogTemp, Warning, TEXT("%s::%d::%.4f \t %s's first candidate added, starting tick.."),
 					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(), *GetOwner()->GetName());
 			}
-			SetComponentTickEnabled(true);
+			SetScheduledUpdateEnabled(true);
 		}
 	}
 	else
@@ -409,7 +553,7 @@ void USLReachAndPreGraspMonitor::OnOverlapEnd(UPrimitiveComponent* OverlappedCom
 	}
 
 	// Remove candidate
-	if (CandidatesData.Remove(OtherIndividual) > 0)
+	if (RemoveCandidate(OtherIndividual))
 	{
 		if (bLogDebug)
 		{
@@ -426,7 +570,7 @@ void USLReachAndPreGraspMonitor::OnOverlapEnd(UPrimitiveComponent* OverlappedCom
 				UE_LOG(LogTemp, Warning, TEXT("%s::%d::%.4f \t %s's last candidate removed, stopping tick.."),
 					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(), *GetOwner()->GetName());
 			}
-			SetComponentTickEnabled(false);
+			SetScheduledUpdateEnabled(false);
 		}
 	}
 	else
@@ -460,7 +604,8 @@ void USLReachAndPreGraspMonitor::OnManipulatorGraspBegin(USLBaseIndividual* Self
 	}
 
 	// Check if the grasped object is a candidate and is in contact with the hand
-	if(FSLTimeAndDist* CandidateTimeAndDist = CandidatesData.Find(Other))
+	const int32 CandidateIdx = CandidatesData.Find(Other);
+	if(CandidateIdx != INDEX_NONE)
 	{
 		// TODO this could be an outdated time due to the delay, it however makes sense to keep it this way
 		// since if there is a grasp with the object, it should also be in contact with
@@ -480,16 +625,16 @@ void USLReachAndPreGraspMonitor::OnManipulatorGraspBegin(USLBaseIndividual* Self
 			GetWorld()->GetTimerManager().ClearTimer(DelayTimerHandle);
 
 			// Broadcast reach and pre grasp events
-			const float ReachStartTime = CandidateTimeAndDist->Get<ESLTimeAndDist::SLTime>();
+			const float ReachStartTime = CandidatesData.StartTimes[CandidateIdx];
 			const float ReachEndTime = *ContactTime;
 			OnReachAndPreGraspEvent.Broadcast(OwnerIndividualObject, Other, ReachStartTime, ReachEndTime, Timestamp);
 
 			if (bLogDebug)
 			{
 				FString CandidatesStr;
-				for (const auto& C : CandidatesData)
+				for (const auto& C : CandidatesData.Individuals)
 				{
-					CandidatesStr.Append(C.Key->GetParentActor()->GetName() + ";");
+					CandidatesStr.Append(C->GetParentActor()->GetName() + ";");
 				}
 				UE_LOG(LogTemp, Warning, TEXT("%s::%d::%.4fs %s's removing candidates %s.."),
 					*FString(__FUNCTION__), __LINE__, GetWorld()->GetTimeSeconds(),
@@ -497,9 +642,9 @@ void USLReachAndPreGraspMonitor::OnManipulatorGraspBegin(USLBaseIndividual* Self
 			}
 
 			// Remove existing candidates and pause the update callback while the hand is grasping
-			CandidatesData.Empty();
+			EmptyCandidates();
 			ManipulatorContactData.Empty();
-			SetComponentTickEnabled(false);
+			SetScheduledUpdateEnabled(false);
 
 			// Disable overlaps until grasp is released
 			SetGenerateOverlapEvents(false);
@@ -633,7 +778,7 @@ void USLReachAndPreGraspMonitor::OnManipulatorContactEnd(USLBaseIndividual* Self
 	}
 
 	// Cache the event
-	RecentlyEndedEvents.Emplace(Other, EndTime);
+	RecentlyEndedEvents.Add(Other, EndTime, FSLPreGraspEndEvent(Other, EndTime));
 
 	if (!GetWorld())
 	{
@@ -656,40 +801,36 @@ void USLReachAndPreGraspMonitor::DelayContactEndCallback()
 	// Curr time (keep very recently added events for another delay)
 	const float CurrTime = GetWorld()->GetTimeSeconds();
 	
-	for (auto EvItr(RecentlyEndedEvents.CreateIterator()); EvItr; ++EvItr)
+	// If enough time has passed, reset the reach time
+	RecentlyEndedEvents.PopExpired(CurrTime, ConcatenateIfSmaller, [this](const FSLPreGraspEndEvent& Ev)
 	{
-		// If enough time has passed, reset the reach time
-		if(CurrTime - EvItr->Time > ConcatenateIfSmaller)
+		// Reset reach start in the candidate
+		const int32 CandidateIdx = CandidatesData.Find(Ev.Other);
+		if(CandidateIdx != INDEX_NONE)
 		{
-			// Reset reach start in the candidate
-			if(FSLTimeAndDist* TimeAndDist = CandidatesData.Find(EvItr->Other))
+			// No new contact happened, remove and reset reach time
+			if(ManipulatorContactData.Remove(Ev.Other) > 0)
 			{
-				// No new contact happened, remove and reset reach time
-				if(ManipulatorContactData.Remove(EvItr->Other) > 0)
-				{
-					//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] %s removed as object in contact with the manipulator.. (after delay, contact end time=%f)"),
-					//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *EvItr->Other->GetName(), EvItr->Timestamp);
-					TimeAndDist->Get<ESLTimeAndDist::SLTime>() = GetWorld()->GetTimeSeconds();
-				}
-				else
-				{
-					// Might happen due to the contact event end jitter check publishing delay
-					UE_LOG(LogTemp, Error, TEXT("%s::%d::%4.f %s's %s is not in the contact list.. this should not happen.."),
-						*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(),
-						*GetOwner()->GetName(),	*EvItr->Other->GetParentActor()->GetName());
-				}
+				//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] %s removed as object in contact with the manipulator.. (after delay, contact end time=%f)"),
+				//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *Ev.Other->GetName(), Ev.Time);
+				CandidatesData.StartTimes[CandidateIdx] = GetWorld()->GetTimeSeconds();
 			}
 			else
 			{
 				// Might happen due to the contact event end jitter check publishing delay
-				UE_LOG(LogTemp, Error, TEXT("%s::%d::%4.f %s's %s is not in the candidates list.. this should not happen.."),
+				UE_LOG(LogTemp, Error, TEXT("%s::%d::%4.f %s's %s is not in the contact list.. this should not happen.."),
 					*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(),
-					*GetOwner()->GetName(), *EvItr->Other->GetParentActor()->GetName());
+					*GetOwner()->GetName(),	*Ev.Other->GetParentActor()->GetName());
 			}
-			
-			EvItr.RemoveCurrent();
 		}
-	}
+		else
+		{
+			// Might happen due to the contact event end jitter check publishing delay
+			UE_LOG(LogTemp, Error, TEXT("%s::%d::%4.f %s's %s is not in the candidates list.. this should not happen.."),
+				*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(),
+				*GetOwner()->GetName(), *Ev.Other->GetParentActor()->GetName());
+		}
+	});
 
 	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
 	if(RecentlyEndedEvents.Num() > 0)
@@ -703,26 +844,57 @@ void USLReachAndPreGraspMonitor::DelayContactEndCallback()
 // Check if this begin event happened right after the previous one ended, if so remove it from the array, and cancel publishing the begin event
 bool USLReachAndPreGraspMonitor::SkipIfJitterContact(USLBaseIndividual* Other, float StartTime)
 {
-	for (auto EvItr(RecentlyEndedEvents.CreateIterator()); EvItr; ++EvItr)
+	// Check time difference between the previous and current event, if small the event will be concatenated
+	if (RecentlyEndedEvents.RemoveIfJitter(Other, StartTime, ConcatenateIfSmaller))
 	{
-		// Check if it is an event between the same entities
-		if(EvItr->Other == Other)
+		// Check if it was the last event, if so, pause the delay publisher
+		if (RecentlyEndedEvents.Num() == 0)
 		{
-			// Check time difference between the previous and current event
-			const float TimeGap = StartTime - EvItr->Time;
-			if(TimeGap < ConcatenateIfSmaller)
-			{
-				// Event will be concatenated
-				EvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedEvents.Num() == 0)
-				{
-					GetWorld()->GetTimerManager().ClearTimer(DelayTimerHandle);
-				}
-				return true;
-			}
+			GetWorld()->GetTimerManager().ClearTimer(DelayTimerHandle);
 		}
+		return true;
 	}
 	return false;
 }
+
+// Register the update with the world monitor scheduler (replaces the component tick)
+void USLReachAndPreGraspMonitor::RegisterScheduledUpdate()
+{
+	if (USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(GetWorld()))
+	{
+		TWeakObjectPtr<USLReachAndPreGraspMonitor> WeakThis(this);
+		ScheduledUpdateId = Scheduler->Register(TEXT("ReachAndPreGrasp"), [WeakThis](float DeltaTime)
+		{
+			if (USLReachAndPreGraspMonitor* This = WeakThis.Get())
+			{
+				This->UpdateCandidatesData(DeltaTime);
+			}
+		}, UpdateRate);
+	}
+}
+
+// Remove the update from the world monitor scheduler
+void USLReachAndPreGraspMonitor::UnregisterScheduledUpdate()
+{
+	if (USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(GetWorld()))
+	{
+		Scheduler->Unregister(ScheduledUpdateId);
+	}
+	ScheduledUpdateId = INDEX_NONE;
+}
+
+// Enable or disable the scheduled update
+void USLReachAndPreGraspMonitor::SetScheduledUpdateEnabled(bool bEnabled)
+{
+	if (USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(GetWorld()))
+	{
+		Scheduler->SetEnabled(ScheduledUpdateId, bEnabled);
+	}
+}
+
+// Check if the scheduled update is enabled
+bool USLReachAndPreGraspMonitor::IsScheduledUpdateEnabled() const
+{
+	const USLMonitorScheduler* Scheduler = USLMonitorScheduler::Get(GetWorld());
+	return Scheduler && Scheduler->IsEnabled(ScheduledUpdateId);
+}
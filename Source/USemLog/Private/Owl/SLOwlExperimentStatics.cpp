@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Owl/SLOwlExperimentStatics.h"
+#include "Individuals/Type/SLBaseIndividual.h"
 
 /* Semantic map template creation */
 // Create default experiment document
@@ -93,8 +94,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateEventIndividual(
 	const FString& InClass)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	FSLOwlNode Individual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(
 		InDocPrefix, InId)));
@@ -108,8 +109,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateTimepointIndividual(
 	const float Timepoint)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	const FString Id = "timepoint_" + FString::SanitizeFloat(Timepoint);
 	FSLOwlNode Individual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(
@@ -125,8 +126,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateObjectIndividual(
 	const FString& InClass)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	FSLOwlNode Individual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(
 		InDocPrefix, InId)));
@@ -134,13 +135,41 @@ FSLOwlNode FSLOwlExperimentStatics::CreateObjectIndividual(
 	return Individual;
 }
 
+// Create and add the timepoint individual to the experiment (the node is only created for new timepoints)
+bool FSLOwlExperimentStatics::AddTimepointIndividual(
+	FSLOwlExperiment* Experiment,
+	const FString& InDocPrefix,
+	const float Timepoint)
+{
+	if (Experiment->HasTimepointIndividual(Timepoint))
+	{
+		return false;
+	}
+	return Experiment->AddTimepointIndividual(Timepoint,
+		FSLOwlExperimentStatics::CreateTimepointIndividual(InDocPrefix, Timepoint));
+}
+
+// Create and add the object individual to the experiment (the node is only created for new objects)
+bool FSLOwlExperimentStatics::AddObjectIndividual(
+	FSLOwlExperiment* Experiment,
+	const FString& InDocPrefix,
+	USLBaseIndividual* Individual)
+{
+	if (Experiment->HasObjectIndividual(Individual))
+	{
+		return false;
+	}
+	return Experiment->AddObjectIndividual(Individual,
+		FSLOwlExperimentStatics::CreateObjectIndividual(InDocPrefix, Individual->GetIdValue(), Individual->GetClassValue()));
+}
+
 
 /* Owl properties creation */
 // Create class property
 FSLOwlNode FSLOwlExperimentStatics::CreateClassProperty(const FString& InClass)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName RdfType("rdf", "type");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName RdfType("rdf", "type");
 
 	return FSLOwlNode(RdfType, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue("knowrob", InClass)));
@@ -149,8 +178,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateClassProperty(const FString& InClass)
 // Create startTime property
 FSLOwlNode FSLOwlExperimentStatics::CreateStartTimeProperty(const FString& InDocPrefix, const float Timepoint)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "startTime");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "startTime");
 
 	const FString Id = "timepoint_" + FString::SanitizeFloat(Timepoint);
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
@@ -160,8 +189,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateStartTimeProperty(const FString& InDoc
 // Create endTime property
 FSLOwlNode FSLOwlExperimentStatics::CreateEndTimeProperty(const FString& InDocPrefix, const float Timepoint)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "endTime");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "endTime");
 
 	const FString Id = "timepoint_" + FString::SanitizeFloat(Timepoint);
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
@@ -171,8 +200,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateEndTimeProperty(const FString& InDocPr
 // Create inContact property
 FSLOwlNode FSLOwlExperimentStatics::CreateInContactProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "inContact");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "inContact");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -181,8 +210,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateInContactProperty(const FString& InDoc
 // Create isSupported property
 FSLOwlNode FSLOwlExperimentStatics::CreateIsSupportedProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "isSupported");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "isSupported");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -191,8 +220,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateIsSupportedProperty(const FString& InD
 // Create supports property
 FSLOwlNode FSLOwlExperimentStatics::CreateIsSupportingProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "isSupporting");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "isSupporting");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -201,8 +230,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateIsSupportingProperty(const FString& In
 // Create performedBy property
 FSLOwlNode FSLOwlExperimentStatics::CreatePerformedByProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "performedBy");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "performedBy");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -211,8 +240,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreatePerformedByProperty(const FString& InD
 // Create deviceUsed property
 FSLOwlNode FSLOwlExperimentStatics::CreateDeviceUsedProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "deviceUsed");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "deviceUsed");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -221,8 +250,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateDeviceUsedProperty(const FString& InDo
 // Create objectActedOn property
 FSLOwlNode FSLOwlExperimentStatics::CreateObjectActedOnProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "objectActedOn");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "objectActedOn");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -231,8 +260,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateObjectActedOnProperty(const FString& I
 // Create outputsCreated property
 FSLOwlNode FSLOwlExperimentStatics::CreateOutputsCreatedProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "outputsCreated");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "outputsCreated");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -241,8 +270,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateOutputsCreatedProperty(const FString&
 // Create taskSuccess property
 FSLOwlNode FSLOwlExperimentStatics::CreateTaskSuccessProperty(const FString& InDocPrefix, const bool TaskSuccess)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "taskSuccess");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "taskSuccess");
 
 	const FString Id = TaskSuccess ? "true" : "false";
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
@@ -251,8 +280,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateTaskSuccessProperty(const FString& InD
 
 FSLOwlNode FSLOwlExperimentStatics::CreateGraspTypeProperty(const FString& InDocPrefix, const FString& InGraspType)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "graspType");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "graspType");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InGraspType)));
@@ -260,8 +289,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateGraspTypeProperty(const FString& InDoc
 
 FSLOwlNode FSLOwlExperimentStatics::CreateTypeProperty(const FString& InDocPrefix, const FString& InType)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "type");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "type");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InType)));
@@ -87,7 +87,7 @@ bool FSLOwlSemMapDocUtils::PrintDoc(const FSLOwlDoc& InDoc, const FString& Path,
         return false;
     }
 
-    return FFileHelper::SaveStringToFile(InDoc.ToString(), *FullPath);
+    return InDoc.SaveToFile(FullPath);
 }
 
 // Create a semantic map document template
@@ -0,0 +1,149 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Owl/SLOwlStreamWriter.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+/**
+* Consumes the write queue
+*/
+class FSLOwlStreamWorker : public FRunnable
+{
+public:
+	// Init ctor
+	FSLOwlStreamWorker(FSLOwlStreamWriter* InOwner) : Owner(InOwner) {};
+
+	// Write until the owner requests a stop and the queue is empty
+	virtual uint32 Run() override
+	{
+		while (true)
+		{
+			if (Owner->WritePending())
+			{
+				continue;
+			}
+			else if (Owner->bStopRequested)
+			{
+				// The last jobs might have been queued together with the stop request
+				while (Owner->WritePending()) {}
+				break;
+			}
+			else
+			{
+				Owner->WorkEvent->Wait(50);
+			}
+		}
+		return 0;
+	}
+
+private:
+	// Owner of the queue and the file
+	FSLOwlStreamWriter* Owner;
+};
+
+// Ctor
+FSLOwlStreamWriter::FSLOwlStreamWriter() : WorkEvent(nullptr), FileWriter(nullptr), Worker(nullptr), Thread(nullptr)
+{
+}
+
+// Dtor
+FSLOwlStreamWriter::~FSLOwlStreamWriter()
+{
+	Finish(TEXT(""));
+}
+
+// Create the file, write the document start, and start the writer thread
+bool FSLOwlStreamWriter::Start(const FString& FilePath, const FString& DocStart)
+{
+	if (IsRunning())
+	{
+		return true;
+	}
+
+	FileWriter = IFileManager::Get().CreateFileWriter(*FilePath);
+	if (!FileWriter)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create %s.."), *FString(__FUNCTION__), __LINE__, *FilePath);
+		return false;
+	}
+
+	FSLOwlStreamJob Job;
+	Job.Text = DocStart;
+	Queue.Enqueue(MoveTemp(Job));
+
+	bStopRequested = false;
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Worker = new FSLOwlStreamWorker(this);
+	Thread = FRunnableThread::Create(Worker, TEXT("SLOwlStreamWorker"));
+	return true;
+}
+
+// Queue the nodes to be written as children of the document root
+void FSLOwlStreamWriter::Write(TArray<FSLOwlNode>&& Nodes)
+{
+	if (!IsRunning() || Nodes.Num() == 0)
+	{
+		return;
+	}
+
+	FSLOwlStreamJob Job;
+	Job.Nodes = MoveTemp(Nodes);
+	Queue.Enqueue(MoveTemp(Job));
+	WorkEvent->Trigger();
+}
+
+// Queue the document end, wait for the pending writes and close the file
+void FSLOwlStreamWriter::Finish(const FString& DocEnd)
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	FSLOwlStreamJob Job;
+	Job.Text = DocEnd;
+	Queue.Enqueue(MoveTemp(Job));
+
+	// The worker exits once the queue is empty
+	bStopRequested = true;
+	WorkEvent->Trigger();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+	delete Worker;
+	Worker = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+
+	FileWriter->Close();
+	delete FileWriter;
+	FileWriter = nullptr;
+}
+
+// Write the queued jobs, returns false if the queue is empty
+bool FSLOwlStreamWriter::WritePending()
+{
+	FSLOwlStreamJob Job;
+	if (!Queue.Dequeue(Job))
+	{
+		return false;
+	}
+
+	FString Str = MoveTemp(Job.Text);
+	for (const auto& Node : Job.Nodes)
+	{
+		Node.WriteTo(Str, FString(), 1);
+	}
+
+	if (!Str.IsEmpty())
+	{
+		FTCHARToUTF8 Utf8Str(*Str);
+		FileWriter->Serialize(const_cast<ANSICHAR*>(Utf8Str.Get()), Utf8Str.Length());
+	}
+	return true;
+}
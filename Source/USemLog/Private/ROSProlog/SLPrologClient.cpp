@@ -7,11 +7,21 @@
 USLPrologClient::USLPrologClient() 
 {
 	bIsTickable = true;
+	BatchedTellElapsedTime = 0.f;
+	bDisconnectRequested = false;
+	DisconnectRequestTime = 0.0;
 }
 
 // Destructor
 USLPrologClient::~USLPrologClient()
 {
+#if SL_WITH_ROSBRIDGE
+	// Pending queries did not finish in time
+	if (bDisconnectRequested)
+	{
+		FinishDisconnect();
+	}
+#endif // SL_WITH_ROSBRIDGE
 }
 
 // Return if object is ready to be ticked
@@ -33,6 +43,16 @@ TStatId USLPrologClient::GetStatId() const
 void USLPrologClient::Tick(float DeltaTime) 
 {
 #if SL_WITH_ROSBRIDGE
+	// Send the batched tells once the window elapsed or the batch is full
+	if (BatchedTells.Queries.Num() > 0)
+	{
+		BatchedTellElapsedTime += DeltaTime;
+		if (BatchedTellElapsedTime > BatchedTellWindow || BatchedTells.Queries.Num() >= BatchedTellMaxNum)
+		{
+			FlushBatchedTellQueries();
+		}
+	}
+
 	// Call update on tick
 	while (QueriesBuffer.Num() > 0) 
 	{
@@ -46,6 +66,21 @@ void USLPrologClient::Tick(float DeltaTime)
 	{
 		SendFinishCommand(FinishCommandsBuffer.Pop());
 	}
+
+	// Close the connection once the last queries are finished
+	if (bDisconnectRequested)
+	{
+		if (!HasPendingCommands())
+		{
+			FinishDisconnect();
+		}
+		else if (FPlatformTime::Seconds() - DisconnectRequestTime > DisconnectTimeout)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d Disconnecting with %d unanswered prolog queries.."),
+				*FString(__FUNCTION__), __LINE__, SentQueries.Num() + SentNextSolutionCommands.Num() + SentFinishCommands.Num());
+			FinishDisconnect();
+		}
+	}
 #endif
 }
 
@@ -73,11 +108,41 @@ void USLPrologClient::Init(FString Host, uint32 port)
 	}
 }
 
-// Disconnect from ROSBridge
+// Send the remaining queries and disconnect from ROSBridge once their responses are processed
 void USLPrologClient::Disconnect() 
 {
 
 	// Finish ROS Connection
+	if (ROSHandler.IsValid() && !bDisconnectRequested)
+	{
+		// Send the remaining batched tells
+		FlushBatchedTellQueries();
+		while (QueriesBuffer.Num() > 0)
+		{
+			SendPrologQuery(QueriesBuffer.Pop());
+		}
+
+		// The query is only run after its next_solution and finish commands, disconnect on tick when done
+		bDisconnectRequested = true;
+		DisconnectRequestTime = FPlatformTime::Seconds();
+		if (!HasPendingCommands())
+		{
+			FinishDisconnect();
+		}
+	}
+}
+
+// True if queries are buffered or waiting for their responses
+bool USLPrologClient::HasPendingCommands() const
+{
+	return QueriesBuffer.Num() > 0 || NextSolutionCommandsBuffer.Num() > 0 || FinishCommandsBuffer.Num() > 0
+		|| SentQueries.Num() > 0 || SentNextSolutionCommands.Num() > 0 || SentFinishCommands.Num() > 0;
+}
+
+// Close the ROSBridge connection
+void USLPrologClient::FinishDisconnect()
+{
+	bDisconnectRequested = false;
 	if (ROSHandler.IsValid())
 	{
 		ROSHandler->Disconnect();
@@ -94,35 +159,88 @@ void USLPrologClient::AddQuery(FString Id, FSLQueryHandler *QueryHandle)
 // Add event query
 void USLPrologClient::AddEventQuery(TSharedPtr<ISLEvent> Event) 
 {
-	FSLQueryHandler* QueryHandler =  new FSLQueryHandler(Event->ToROSQuery(), false);
-	AddQuery(Event->Id, QueryHandler);
+	AddBatchedTellQuery(Event->Id, Event->ToROSQuery());
 }
 
 // Add object query
 void USLPrologClient::AddObjectQuery(USLBaseIndividual *Entity)
 {
 	
-	// Creates query ID
-	FString IdValue = FSLUuid::NewGuidInBase64();
-
 	// Get Bounds
 	FVector Extent = Entity->GetParentActorExtent();
 
 	// Creates query
-	FString Query = FString::Printf(TEXT("Obj = \'http://www.ease-crc.org/ont/SOMA.owl#%s_%s\', "), *Entity->GetClassValue(), *Entity->GetIdValue());
-	Query.Append("tell([");
-	Query.Append("is_object(Obj), ");
-	Query.Append(FString::Printf(TEXT("has_type(Shape, soma:\'Shape\'), ")));
-	Query.Append(FString::Printf(TEXT("has_type(ShapeReg, soma:\'BoxShape\'), ")));
-	Query.Append(FString::Printf(TEXT("holds(ShapeReg, soma:hasDepth, %f), "), Extent.X));
-	Query.Append(FString::Printf(TEXT("holds(ShapeReg, soma:hasWidth, %f), "), Extent.Y));
-	Query.Append(FString::Printf(TEXT("holds(ShapeReg, soma:hasHeight, %f), "), Extent.Z));
-	Query.Append(FString::Printf(TEXT("holds(Shape, dul:hasRegion, ShapeReg), ")));
-	Query.Append(FString::Printf(TEXT("holds(Obj, soma:hasShape, Shape) ")));
-	Query.Append("]).");
-
-	FSLQueryHandler* QueryHandler = new FSLQueryHandler(Query, false);
-	AddQuery(IdValue, QueryHandler);
+	FString Query = TEXT("Obj = \'http://www.ease-crc.org/ont/SOMA.owl#");
+	Query += Entity->GetClassValue();
+	Query += TEXT("_");
+	Query += Entity->GetIdValue();
+	Query += TEXT("\', ");
+	Query += TEXT("tell([");
+	Query += TEXT("is_object(Obj), ");
+	Query += TEXT("has_type(Shape, soma:\'Shape\'), ");
+	Query += TEXT("has_type(ShapeReg, soma:\'BoxShape\'), ");
+	Query += FString::Printf(TEXT("holds(ShapeReg, soma:hasDepth, %f), "), Extent.X);
+	Query += FString::Printf(TEXT("holds(ShapeReg, soma:hasWidth, %f), "), Extent.Y);
+	Query += FString::Printf(TEXT("holds(ShapeReg, soma:hasHeight, %f), "), Extent.Z);
+	Query += TEXT("holds(Shape, dul:hasRegion, ShapeReg), ");
+	Query += TEXT("holds(Obj, soma:hasShape, Shape) ");
+	Query += TEXT("]).");
+
+	AddBatchedTellQuery(FSLUuid::NewGuidInBase64(), Query);
+}
+
+// Add a tell query to the batch (sent together with the other tells of the batch window)
+void USLPrologClient::AddBatchedTellQuery(const FString& Id, const FString& Query)
+{
+	if (BatchedTells.Queries.Num() == 0)
+	{
+		BatchedTellElapsedTime = 0.f;
+	}
+	BatchedTells.Ids.Add(Id);
+	BatchedTells.Queries.Add(Query);
+}
+
+// Combine the batched tells into a single query and add it to the buffer
+void USLPrologClient::FlushBatchedTellQueries()
+{
+	if (BatchedTells.Queries.Num() == 0)
+	{
+		return;
+	}
+
+	// Each tell runs in its own scope (\+ \+ undoes the bindings, the asserted facts remain),
+	// otherwise the variables with the same name (Action, Episode ..) would unify between the tells,
+	// a failing tell does not stop the rest of the batch
+	for (const auto& Query : BatchedTells.Queries)
+	{
+		if (!BatchedTellQuery.IsEmpty())
+		{
+			BatchedTellQuery += TEXT(", ");
+		}
+		BatchedTellQuery += TEXT("ignore(\\+ \\+ (");
+		BatchedTellQuery += Query;
+
+		// Remove the query terminator
+		int32 End = BatchedTellQuery.Len();
+		while (End > 0 && (BatchedTellQuery[End - 1] == TEXT('.') || FChar::IsWhitespace(BatchedTellQuery[End - 1])))
+		{
+			End--;
+		}
+		BatchedTellQuery.RemoveAt(End, BatchedTellQuery.Len() - End, false);
+		BatchedTellQuery += TEXT("))");
+	}
+	BatchedTellQuery += TEXT(".");
+
+	// Keep the tells in case the combined query fails
+	const FString Id = FSLUuid::NewGuidInBase64();
+	FSLQueryHandler* QueryHandler = new FSLQueryHandler(BatchedTellQuery, false);
+	AddQuery(Id, QueryHandler);
+	SentTellBatches.Add(Id, MoveTemp(BatchedTells));
+
+	// Keep the allocation for the next batch
+	BatchedTells = FSLPrologTellBatch();
+	BatchedTellQuery.Reset(BatchedTellQuery.Len());
+	BatchedTellElapsedTime = 0.f;
 }
 
 // Send query 
@@ -172,8 +290,31 @@ void  USLPrologClient::ProcessResponse(TSharedPtr<FROSBridgeSrv::SrvResponse> In
 				*Id, bSuccess ? TEXT("true") : TEXT("false"), *Msg->GetMessage());
 		}
 		if (bSuccess) {
+			SentTellBatches.Remove(Id);
 			SendNextSolutionCommand(Id);
 		}
+		else
+		{
+			// A single invalid tell (e.g. syntax error) fails the whole combined query, resend the tells one by one
+			FSLPrologTellBatch Batch;
+			if (SentTellBatches.RemoveAndCopyValue(Id, Batch))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s::%d Batched tell query failed (%s), tell ids: [%s].."),
+					*FString(__FUNCTION__), __LINE__, *Msg->GetMessage(), *FString::Join(Batch.Ids, TEXT(", ")));
+				if (Batch.Queries.Num() > 1)
+				{
+					for (int32 Idx = 0; Idx < Batch.Queries.Num(); ++Idx)
+					{
+						AddQuery(Batch.Ids[Idx], new FSLQueryHandler(Batch.Queries[Idx], false));
+					}
+				}
+				FSLQueryHandler* QueryHandler = nullptr;
+				if (Queries.RemoveAndCopyValue(Id, QueryHandler))
+				{
+					delete QueryHandler;
+				}
+			}
+		}
 	}
 
 	if (Type.Equals("next_solution")) 
@@ -30,6 +30,7 @@
 #include "Monitors/SLContainerMonitor.h"
 
 #include "Owl/SLOwlExperimentStatics.h"
+#include "Owl/SLOwlStreamWriter.h"
 
 #if SL_WITH_MC_GRASP
 #include "Events/SLFixationGraspEventHandler.h"
@@ -292,6 +293,12 @@ void ASLSymbolicLogger::StartImpl()
 		return;
 	}
 
+	// Write the owl document start, the events will be appended as they finish
+	if (LoggerParameters.bStreamOwlEvents)
+	{
+		StartOwlStreaming();
+	}
+
 	// Start handlers
 	for (auto& EvHandler : EventHandlers)
 	{
@@ -403,9 +410,13 @@ void ASLSymbolicLogger::FinishImpl(bool bForced)
 	// Create the experiment owl doc	
 	if (ExperimentDoc.IsValid())
 	{
-		for (const auto& Ev : FinishedEvents)
+		// Streamed events are already written
+		if (!OwlStreamWriter.IsValid())
 		{
-			Ev->AddToOwlDoc(ExperimentDoc.Get());
+			for (const auto& Ev : FinishedEvents)
+			{
+				Ev->AddToOwlDoc(ExperimentDoc.Get());
+			}
 		}
 
 		// Add stored unique timepoints to doc
@@ -469,7 +480,23 @@ void ASLSymbolicLogger::SemanticEventFinishedCallback(TSharedPtr<ISLEvent> Event
 {
 	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, FString::Printf(TEXT("%s::%d %s"), *FString(__func__), __LINE__, *Event->ToString()));
 	//UE_LOG(LogTemp, Error, TEXT(">> %s::%d %s"), *FString(__func__), __LINE__, *Event->ToString());
-	FinishedEvents.Add(Event);
+	if (OwlStreamWriter.IsValid())
+	{
+		// Stream the event individual, only the unique timepoints and objects are kept until finish
+		Event->AddToOwlDoc(ExperimentDoc.Get());
+		OwlStreamWriter->Write(MoveTemp(ExperimentDoc->Individuals));
+		ExperimentDoc->Individuals.Reset();
+
+		// The timelines are still written at finish from all the events
+		if (LoggerParameters.bWriteTimelines)
+		{
+			FinishedEvents.Add(Event);
+		}
+	}
+	else
+	{
+		FinishedEvents.Add(Event);
+	}
 
 #if SL_WITH_ROSBRIDGE
 	if (LoggerParameters.bPublishToROS)
@@ -499,18 +526,59 @@ void ASLSymbolicLogger::WriteToFile()
 	}
 
 	// Write owl data to file
-	if (ExperimentDoc.IsValid())
+	if (OwlStreamWriter.IsValid())
+	{
+		// Append the remaining individuals and close the document
+		OwlStreamWriter->Write(MoveTemp(ExperimentDoc->Individuals));
+		ExperimentDoc->Individuals.Reset();
+		OwlStreamWriter->Finish(FSLOwlDoc::EndToString());
+		OwlStreamWriter.Reset();
+	}
+	else if (ExperimentDoc.IsValid())
 	{
 		// Write experiment to file
-		FString FullFilePath = DirPath + LocationParameters.EpisodeId + TEXT("_ED.owl");
-		FPaths::RemoveDuplicateSlashes(FullFilePath);
+		const FString FullFilePath = GetExperimentDocFilePath();
 		if (!FPaths::FileExists(FullFilePath) || LocationParameters.bOverwrite)
 		{
-			FFileHelper::SaveStringToFile(ExperimentDoc->ToString(), *FullFilePath);					
+			ExperimentDoc->SaveToFile(FullFilePath);
 		}
 	}
 }
 
+// Get the path of the owl experiment file
+FString ASLSymbolicLogger::GetExperimentDocFilePath() const
+{
+	FString FullFilePath = FPaths::ProjectDir() + "/SL/" + LocationParameters.TaskId + "/" + LocationParameters.EpisodeId + TEXT("_ED.owl");
+	FPaths::RemoveDuplicateSlashes(FullFilePath);
+	return FullFilePath;
+}
+
+// Write the document start and stream the following events to the owl file
+void ASLSymbolicLogger::StartOwlStreaming()
+{
+	if (!ExperimentDoc.IsValid() || OwlStreamWriter.IsValid())
+	{
+		return;
+	}
+
+	const FString FullFilePath = GetExperimentDocFilePath();
+	if (FPaths::FileExists(FullFilePath) && !LocationParameters.bOverwrite)
+	{
+		return;
+	}
+
+	OwlStreamWriter = MakeShareable(new FSLOwlStreamWriter());
+	if (OwlStreamWriter->Start(FullFilePath, ExperimentDoc->StartToString()))
+	{
+		// The template individuals are part of the written start
+		ExperimentDoc->Individuals.Reset();
+	}
+	else
+	{
+		OwlStreamWriter.Reset();
+	}
+}
+
 // Create events doc template
 TSharedPtr<FSLOwlExperiment> ASLSymbolicLogger::CreateEventsDocTemplate(ESLOwlExperimentTemplate TemplateType, const FString& InDocId)
 {
@@ -81,6 +81,9 @@ void USLMetadataLogger::Finish(bool bForced)
 			ItemsScanner->Finish();
 		}
 
+		// Wait for the background scan image uploads
+		DBHandler.FlushUploads();
+
 		DBHandler.CreateIndexes();
 		bIsStarted = false;
 		bIsInit = false;
@@ -3,6 +3,7 @@
 
 #include "SLVisionLogger.h"
 #include "Vision/SLVisionPoseableMeshActor.h"
+#include "Individuals/SLIndividualManager.h"
 
 #include "EngineUtils.h"
 #include "GameFramework/PlayerController.h"
@@ -16,14 +17,32 @@
 #include "ImageUtils.h"
 #include "Async.h"
 #include "FileHelper.h"
+#include "Misc/CommandLine.h"
+#include "Misc/PackageName.h"
+#include "Misc/Crc.h"
+#include "HAL/FileManager.h"
 
 // Constructor
 USLVisionLogger::USLVisionLogger() : bIsInit(false), bIsStarted(false), bIsFinished(false), bIsPaused(false)
 {
 	CurrViewModeIdx = INDEX_NONE;
 	CurrVirtualCameraIdx = INDEX_NONE;
+	IndividualManager = nullptr;
 	CurrTimestamp = -1.f;
 	PrevViewMode = ESLVisionViewMode::NONE;
+	NumPendingImages = 0;
+	MaxNumPendingImages = 8;
+	StartFrameIdx = 0;
+	LastFrameIdx = INDEX_NONE;
+	FrameStride = 1;
+	CheckpointInterval = 10;
+	NumFramesSinceCheckpoint = 0;
+	bCheckpointProgress = false;
+	LastCheckpointFrameIdx = INDEX_NONE;
+	bSkipUnchangedFrames = false;
+	UnchangedFrameTolerance = KINDA_SMALL_NUMBER;
+	NumSkippedFrames = 0;
+	CurrResolutionScale = 1.f;
 
 	ViewModes.Add(ESLVisionViewMode::Color);
 	ViewModes.Add(ESLVisionViewMode::Unlit);
@@ -46,11 +65,32 @@ USLVisionLogger::~USLVisionLogger()
 
 // Init Logger
 void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId, const FString& InServerIp, uint16 InServerPort,
-	bool bOverwriteVisionData, const FSLVisionLoggerParams& Params)
+	bool bOverwriteVisionData, const FSLVisionLoggerParams& InParams)
 {
 	if (!bIsInit)
 	{
+		// The processed episode part can be set from the command line (multiple headless instances)
+		FSLVisionLoggerParams Params = InParams;
+		ParseShardCommandLineArgs(Params);
+		ShardKey = Params.GetShardKey();
+		StartFrameIdx = FMath::Max(Params.FirstFrameIdx, 0);
+		LastFrameIdx = Params.LastFrameIdx;
+		FrameStride = FMath::Max(Params.FrameStride, 1);
+		CheckpointInterval = FMath::Max(Params.CheckpointInterval, 1);
+		bCheckpointProgress = Params.IsSharded() || Params.bResume;
+		bSkipUnchangedFrames = Params.bSkipUnchangedFrames;
+		UnchangedFrameTolerance = Params.UnchangedFrameTolerance;
+
 		Resolution = Params.Resolution;
+		CurrScaledResolution = Resolution;
+		ViewModeResolutionScales = Params.ViewModeResolutionScales;
+		MaskROI = Params.MaskROI;
+		MaxNumPendingImages = FMath::Max(Params.MaxNumPendingImages, 1);
+		ViewModeCodecs = Params.ViewModeCodecs;
+
+		// Make sure the image compression module is loaded on the game thread before compressing in the background
+		TArray<uint8> DummyCompressedBitmap;
+		FImageUtils::CompressImageArray(1, 1, TArray<FColor>{FColor::Black}, DummyCompressedBitmap);
 
 		// Save the folder name if the images are going to be stored locally as well
 		if(Params.bIncludeLocally)
@@ -70,12 +110,29 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 		// Create movable clones of the skeletal meshes, hide originals (call before loading the episode data)
 		CreatePoseableMeshesClones();
 
-		// Connect to the database for writing the image data
-		if (!DBHandler.Connect(InTaskId, InEpisodeId, InServerIp, InServerPort, bOverwriteVisionData))
+		// Connect to the database for writing the image data (shards and resumed runs share the collection)
+		const bool bIsSharedColl = Params.IsSharded() || Params.bResume;
+		if (!DBHandler.Connect(InTaskId, InEpisodeId, InServerIp, InServerPort, bOverwriteVisionData, bIsSharedColl))
 		{
 			UE_LOG(LogTemp, Warning, TEXT("%s::%d Could not connect to the DB.."), *FString(__func__), __LINE__);
 			return;
 		}
+		DBHandler.SetCompactFrames(Params.bCompactFrames);
+
+		// Continue after the last checkpointed frame
+		int32 CheckpointFrameIdx = INDEX_NONE;
+		if (Params.bResume && DBHandler.GetCheckpoint(ShardKey, CheckpointFrameIdx))
+		{
+			StartFrameIdx = CheckpointFrameIdx + FrameStride;
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d Resuming shard %s from frame %ld.."),
+				*FString(__func__), __LINE__, *ShardKey, StartFrameIdx);
+		}
+
+		// Remove the frames written after the checkpoint (or all the frames of the shard if starting from scratch)
+		if (bIsSharedColl)
+		{
+			DBHandler.RemoveShardEntries(ShardKey, CheckpointFrameIdx);
+		}
 
 		// Download the whole episode data (make sure the poseable mesh clones are created before this)
 		if (!DBHandler.GetEpisodeData(Params.UpdateRate, SkelToPoseableMap, Episode))
@@ -83,6 +140,10 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 			UE_LOG(LogTemp, Warning, TEXT("%s::%d Could not download the episode data.."), *FString(__func__), __LINE__);
 			return;
 		}
+		if (LastFrameIdx == INDEX_NONE || LastFrameIdx >= Episode.GetFramesNum())
+		{
+			LastFrameIdx = Episode.GetFramesNum() - 1;
+		}
 
 		// Make sure rendering modes are selected
 		if(ViewModes.Num() == 0)
@@ -98,6 +159,20 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 			return;
 		}
 
+		// Keep only the cameras of the shard
+		if (Params.CameraIds.Num() > 0)
+		{
+			VirtualCameras.RemoveAll([&Params](ASLVirtualCameraView* Camera)
+			{
+				return !Params.CameraIds.Contains(Camera->GetId());
+			});
+			if (VirtualCameras.Num() == 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s::%d None of the shard virtual cameras were found.."), *FString(__func__), __LINE__);
+				return;
+			}
+		}
+
 		// Access the viewport (used for the screenshot requests)
 		ViewportClient = GetWorld()->GetGameViewport();
 		if(!ViewportClient)
@@ -114,7 +189,8 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 			if(CreateMaskClones())
 			{
 				// Create color to semantic data mappings on the image handler, setup the rendered to original mask mapping
-				if (!MaskImgHandler.Init())
+				SetIndividualManager();
+				if (!MaskImgHandler.Init(IndividualManager, Params.bCacheMaskColors ? GetMaskColorCachePath() : FString()))
 				{
 					UE_LOG(LogTemp, Error, TEXT("%s::%d Could not init image handler, removing mask view type.."), *FString(__func__), __LINE__);
 					ViewModes.Remove(ESLVisionViewMode::Mask);
@@ -128,7 +204,7 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 					// Create the overlap calc object
 					OverlapCalc = NewObject<USLVisionOverlapCalc>(this);
 					// Give control to the overlap calc to pause and start the vision logger
-					OverlapCalc->Init(this, Resolution/Params.OverlapResolutionDivisor, SaveLocallyFolderName);
+					OverlapCalc->Init(this, Resolution/Params.OverlapResolutionDivisor, SaveLocallyFolderName, Params.bAnalyticOverlaps, Params.bCompareOverlaps);
 				}
 			}
 			else
@@ -155,13 +231,19 @@ void USLVisionLogger::Start(const FString& EpisodeId)
 		if (FirstStep())
 		{
 			// Init data
-			CurrFrameData.Init(CurrTimestamp, Resolution);
+			CurrFrameData.Init(CurrTimestamp, Resolution, Episode.GetCurrIndex());
 			CurrViewData.Init(VirtualCameras[CurrVirtualCameraIdx]->GetId(), VirtualCameras[CurrVirtualCameraIdx]->GetClassName());
 
 			// Start recursion
 			RequestScreenshot();
 			bIsStarted = true;
-		}		
+		}
+		else if (StartFrameIdx > LastFrameIdx)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d All the frames of shard %s are already processed.."),
+				*FString(__func__), __LINE__, *ShardKey);
+			QuitEditor();
+		}
 	}
 }
 
@@ -170,6 +252,15 @@ void USLVisionLogger::Finish(bool bForced)
 {
 	if (!bIsFinished && (bIsInit || bIsStarted))
 	{
+		// Wait for the images compressed in the background and write the remaining frames
+		WriteCompletedFrames(true);
+
+		// Wait for the background image uploads
+		DBHandler.FlushUploads();
+
+		// Save the resume point of the remaining frames
+		WriteProgressCheckpoint();
+
 		// Index the entries in the db
 		DBHandler.CreateIndexes();
 
@@ -291,54 +382,57 @@ void USLVisionLogger::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor
 	// Terminal output with the log progress
 	PrintProgress();
 
-	// Compress image
-	TArray<uint8> CompressedBitmap;
+	// The bitmap is owned by the viewport, copy it for the background compression
+	TArray<FColor> BitmapCopy(Bitmap);
 
 	// If mask mode is currently active, restore the colors and get the entity data
 	if (ViewModes[CurrViewModeIdx] == ESLVisionViewMode::Mask)
 	{
-		// Remove const-ness from image (needed for restore the image masks from the rendered values to the original ones)
-		TArray<FColor>& BitmapRef = const_cast<TArray<FColor>&>(Bitmap);
+		// Crop to the region of interest if the screenshot was not captured with it
+		if (CurrCaptureRegion.Area() > 0 && (SizeX != CurrCaptureRegion.Width() || SizeY != CurrCaptureRegion.Height())
+			&& SizeX >= CurrCaptureRegion.Max.X && SizeY >= CurrCaptureRegion.Max.Y)
+		{
+			TArray<FColor> CroppedBitmap;
+			CroppedBitmap.Reserve(CurrCaptureRegion.Area());
+			for (int32 RowIdx = CurrCaptureRegion.Min.Y; RowIdx < CurrCaptureRegion.Max.Y; ++RowIdx)
+			{
+				CroppedBitmap.Append(BitmapCopy.GetData() + RowIdx * SizeX + CurrCaptureRegion.Min.X, CurrCaptureRegion.Width());
+			}
+			BitmapCopy = MoveTemp(CroppedBitmap);
+			SizeX = CurrCaptureRegion.Width();
+			SizeY = CurrCaptureRegion.Height();
+		}
 
 		// Get information from the mask image and restore any rendering artefacts to the original mask colors
-		MaskImgHandler.GetDataAndRestoreImage(BitmapRef, SizeX, SizeY, CurrViewData);
+		MaskImgHandler.GetDataAndRestoreImage(BitmapCopy, SizeX, SizeY, CurrViewData);
+
+		// Bounding boxes and percentages relative to the full resolution image
+		RescaleMaskViewData(CurrViewData, SizeX, SizeY);
 
-		// Compress the restored bitmap image
-		FImageUtils::CompressImageArray(SizeX, SizeY, BitmapRef, CompressedBitmap);
+		// Compress (and save) the restored bitmap image in the background
+		CompressImageAsync(SizeX, SizeY, MoveTemp(BitmapCopy));
 	
 		if (OverlapCalc)
 		{
-			// Check if the image should be saved locally as well
-			if (!SaveLocallyFolderName.IsEmpty())
-			{
-				SaveImageLocally(CompressedBitmap);
-			}
-
-			// Cache the image binary
-			CurrViewData.Images.Emplace(FSLVisionImageData(GetViewModeName(ViewModes[CurrViewModeIdx]), CompressedBitmap));
+			// The overlap screenshots cover the whole image
+			ResetCaptureRegion();
 
-			// Bind the screenshot callback for calculating overlaps
+			// Bind the screenshot callback for calculating overlaps (analytic overlaps are calculated right away)
 			OverlapCalc->Start(&CurrViewData, CurrTimestamp, Episode.GetCurrIndex());
 
 			// Wait for next step until the overlaps were calculated
-			return;
+			if (OverlapCalc->IsStarted())
+			{
+				return;
+			}
 		}
 	}
 	else
 	{
-		// Compress the original bitmap image
-		FImageUtils::CompressImageArray(SizeX, SizeY, Bitmap, CompressedBitmap);
+		// Compress (and save) the original bitmap image in the background
+		CompressImageAsync(SizeX, SizeY, MoveTemp(BitmapCopy));
 	}
 
-	// Check if the image should be saved locally as well
-	if(!SaveLocallyFolderName.IsEmpty())
-	{
-		SaveImageLocally(CompressedBitmap);
-	}
-
-	// Cache the image binary
-	CurrViewData.Images.Emplace(FSLVisionImageData(GetViewModeName(ViewModes[CurrViewModeIdx]), CompressedBitmap));
-
 	// Go to next frame/camera/view mode
 	if (NextStep())
 	{
@@ -403,8 +497,17 @@ bool USLVisionLogger::NextStep()
 		}
 		else
 		{
-			// Write vision frame data to the database
-			DBHandler.WriteFrame(CurrFrameData);
+			// Queue the vision frame data, it is written to the database once all its images are compressed
+			if (bSkipUnchangedFrames)
+			{
+				// The image binaries are not set yet, only the entity data is copied
+				PrevRenderedFrameData = CurrFrameData;
+			}
+			FSLVisionPendingFrame& PendingFrame = PendingFrames.AddDefaulted_GetRef();
+			PendingFrame.FrameData = MoveTemp(CurrFrameData);
+			PendingFrame.Images = MoveTemp(CurrPendingImages);
+			CurrPendingImages.Reset();
+			WriteCompletedFrames(false);
 
 			if (SetupNextEpisodeFrame())
 			{
@@ -414,7 +517,7 @@ bool USLVisionLogger::NextStep()
 				CurrViewData.Init(VirtualCameras[CurrVirtualCameraIdx]->GetId(), VirtualCameras[CurrVirtualCameraIdx]->GetClassName());
 
 				CurrFrameData.Clear();
-				CurrFrameData.Init(CurrTimestamp, Resolution);
+				CurrFrameData.Init(CurrTimestamp, Resolution, Episode.GetCurrIndex());
 
 				return true;
 			}
@@ -427,10 +530,10 @@ bool USLVisionLogger::NextStep()
 	}
 }
 
-// Goto the first episode frame
+// Goto the first episode frame (of the shard)
 bool USLVisionLogger::SetupFirstEpisodeFrame()
 {
-	if(!Episode.SetupFirstFrame(CurrTimestamp, true, OrigToMaskClones, PoseableOrigToMaskClones))
+	if(StartFrameIdx > LastFrameIdx || !Episode.SetupFrame(StartFrameIdx, CurrTimestamp, true, OrigToMaskClones, PoseableOrigToMaskClones))
 	{
 		//UE_LOG(LogTemp, Error, TEXT("%s::%d First frame not available.."), *FString(__func__), __LINE__);
 		return false;
@@ -438,10 +541,19 @@ bool USLVisionLogger::SetupFirstEpisodeFrame()
 	return true;
 }
 
-// Goto next episode frame, return false if there are no other left
+// Goto next episode frame (of the shard), return false if there are no other left
 bool USLVisionLogger::SetupNextEpisodeFrame()
 {
-	if(!Episode.SetupNextFrame(CurrTimestamp, true, OrigToMaskClones, PoseableOrigToMaskClones))
+	int32 NextFrameIdx = Episode.GetCurrIndex() + FrameStride;
+
+	// Frames without any movement reference the last rendered frame
+	while (bSkipUnchangedFrames && NextFrameIdx <= LastFrameIdx && !Episode.HasChanges(NextFrameIdx, UnchangedFrameTolerance))
+	{
+		Episode.SetupFrame(NextFrameIdx, CurrTimestamp, true, OrigToMaskClones, PoseableOrigToMaskClones);
+		QueueReferenceFrame();
+		NextFrameIdx += FrameStride;
+	}
+	if(NextFrameIdx > LastFrameIdx || !Episode.SetupFrame(NextFrameIdx, CurrTimestamp, true, OrigToMaskClones, PoseableOrigToMaskClones))
 	{
 		//UE_LOG(LogTemp, Error, TEXT("%s::%d No new frames.."), *FString(__func__), __LINE__);
 		return false;
@@ -488,6 +600,7 @@ bool USLVisionLogger::SetupFirstViewMode()
 	}
 	
 	ApplyViewMode(ViewModes[CurrViewModeIdx]);
+	ApplyViewModeCapture(ViewModes[CurrViewModeIdx]);
 	return true;
 }
 
@@ -502,6 +615,7 @@ bool USLVisionLogger::SetupNextViewMode()
 	}
 
 	ApplyViewMode(ViewModes[CurrViewModeIdx]);
+	ApplyViewModeCapture(ViewModes[CurrViewModeIdx]);
 	return true;
 }
 
@@ -695,6 +809,74 @@ void USLVisionLogger::InitScreenshotResolution(FIntPoint InResolution)
 	GIsHighResScreenshot = false;	
 }
 
+// Set the screenshot resolution and the capture region of the view mode
+void USLVisionLogger::ApplyViewModeCapture(ESLVisionViewMode Mode)
+{
+	const float* Scale = ViewModeResolutionScales.Find(Mode);
+	CurrResolutionScale = Scale ? FMath::Clamp(*Scale, 0.01f, 1.f) : 1.f;
+	CurrScaledResolution = FIntPoint(
+		FMath::Max(FMath::RoundToInt(Resolution.X * CurrResolutionScale), 1),
+		FMath::Max(FMath::RoundToInt(Resolution.Y * CurrResolutionScale), 1));
+	InitScreenshotResolution(CurrScaledResolution);
+
+	// Only the mask images are cropped to the region of interest
+	CurrCaptureRegion = FIntRect();
+	if (Mode == ESLVisionViewMode::Mask && MaskROI.Area() > 0)
+	{
+		CurrCaptureRegion = FIntRect(
+			FMath::FloorToInt(MaskROI.Min.X * CurrResolutionScale), FMath::FloorToInt(MaskROI.Min.Y * CurrResolutionScale),
+			FMath::CeilToInt(MaskROI.Max.X * CurrResolutionScale), FMath::CeilToInt(MaskROI.Max.Y * CurrResolutionScale));
+		CurrCaptureRegion.Clip(FIntRect(FIntPoint::ZeroValue, CurrScaledResolution));
+	}
+	GetHighResScreenshotConfig().UnscaledCaptureRegion = CurrCaptureRegion;
+	GetHighResScreenshotConfig().CaptureRegion = CurrCaptureRegion;
+}
+
+// Reset the screenshot capture region to the whole image
+void USLVisionLogger::ResetCaptureRegion()
+{
+	GetHighResScreenshotConfig().UnscaledCaptureRegion = FIntRect();
+	GetHighResScreenshotConfig().CaptureRegion = FIntRect();
+}
+
+// Convert the mask data of the (downscaled or cropped) image to full resolution bounding boxes and percentages
+void USLVisionLogger::RescaleMaskViewData(FSLVisionViewData& ViewData, int32 SizeX, int32 SizeY) const
+{
+	const bool bIsCropped = CurrCaptureRegion.Area() > 0;
+	if (CurrResolutionScale == 1.f && !bIsCropped)
+	{
+		return;
+	}
+
+	const FIntPoint Offset = bIsCropped ? CurrCaptureRegion.Min : FIntPoint::ZeroValue;
+	const float InvScale = 1.f / CurrResolutionScale;
+	const float PercentageScale = (float)((int64)SizeX * SizeY) / ((int64)CurrScaledResolution.X * CurrScaledResolution.Y);
+
+	// Pixel bounds of the downscaled pixels in the full resolution image
+	auto RescaleBB = [&](FIntPoint& MinBB, FIntPoint& MaxBB)
+	{
+		MinBB.X = FMath::FloorToInt((MinBB.X + Offset.X) * InvScale);
+		MinBB.Y = FMath::FloorToInt((MinBB.Y + Offset.Y) * InvScale);
+		MaxBB.X = FMath::Min(FMath::CeilToInt((MaxBB.X + Offset.X + 1) * InvScale) - 1, Resolution.X - 1);
+		MaxBB.Y = FMath::Min(FMath::CeilToInt((MaxBB.Y + Offset.Y + 1) * InvScale) - 1, Resolution.Y - 1);
+	};
+
+	for (auto& Entity : ViewData.Entities)
+	{
+		RescaleBB(Entity.MinBB, Entity.MaxBB);
+		Entity.ImagePercentage *= PercentageScale;
+	}
+	for (auto& SkelEntity : ViewData.SkelEntities)
+	{
+		for (auto& Bone : SkelEntity.Bones)
+		{
+			RescaleBB(Bone.MinBB, Bone.MaxBB);
+			Bone.ImagePercentage *= PercentageScale;
+		}
+		SkelEntity.CalculateParamsFromBones();
+	}
+}
+
 // Init render parameters (resolution, view mode)
 void USLVisionLogger::InitRenderParameters()
 {
@@ -934,13 +1116,261 @@ void USLVisionLogger::QuitEditor()
 #endif // WITH_EDITOR
 }
 
-// Save the compressed screenshot image locally
-void USLVisionLogger::SaveImageLocally(const TArray<uint8>& CompressedBitmap)
+// Compress (and save locally) the image in the background, a placeholder is added to the current view data
+void USLVisionLogger::CompressImageAsync(int32 SizeX, int32 SizeY, TArray<FColor>&& Bitmap)
+{
+	// Encoding of the current view mode
+	const ESLImageCodec* ViewModeCodec = ViewModeCodecs.Find(ViewModes[CurrViewModeIdx]);
+	const ESLImageCodec Codec = ViewModeCodec ? *ViewModeCodec : ESLImageCodec::PNG;
+
+	// Empty if the image should not be saved locally
+	const FString LocalPath = SaveLocallyFolderName.IsEmpty() ? FString() : GetLocalImagePathNoExtension();
+
+	TFuture<TArray<uint8>> CompressedBitmap = Async(EAsyncExecution::ThreadPool,
+		[SizeX, SizeY, Bitmap = MoveTemp(Bitmap), LocalPath, Codec]()
+	{
+		TArray<uint8> OutCompressedBitmap;
+		ESLImageCodec UsedCodec;
+		if (!FSLImageCodec::Encode(Codec, SizeX, SizeY, Bitmap, OutCompressedBitmap, UsedCodec))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not encode the image.."), *FString(__FUNCTION__), __LINE__);
+			OutCompressedBitmap.Empty();
+		}
+		else if (!LocalPath.IsEmpty())
+		{
+			// Extension of the codec actually used
+			FFileHelper::SaveArrayToFile(OutCompressedBitmap, *(LocalPath + FSLImageCodec::GetFileExtension(UsedCodec)));
+		}
+		return OutCompressedBitmap;
+	});
+
+	// The image binary is set before the frame is written to the database
+	const int32 ImageIdx = CurrViewData.Images.Emplace(FSLVisionImageData(GetViewModeName(ViewModes[CurrViewModeIdx]), TArray<uint8>()));
+	FSLVisionImageData& ImageData = CurrViewData.Images[ImageIdx];
+	if (SizeX != Resolution.X || SizeY != Resolution.Y)
+	{
+		ImageData.Size = FIntPoint(SizeX, SizeY);
+	}
+	if (CurrCaptureRegion.Area() > 0)
+	{
+		const float InvScale = 1.f / CurrResolutionScale;
+		ImageData.Region = FIntRect(
+			FMath::FloorToInt(CurrCaptureRegion.Min.X * InvScale), FMath::FloorToInt(CurrCaptureRegion.Min.Y * InvScale),
+			FMath::Min(FMath::CeilToInt(CurrCaptureRegion.Max.X * InvScale), Resolution.X),
+			FMath::Min(FMath::CeilToInt(CurrCaptureRegion.Max.Y * InvScale), Resolution.Y));
+	}
+	CurrPendingImages.Emplace(CurrFrameData.Views.Num(), ImageIdx, MoveTemp(CompressedBitmap));
+
+	// Block only if too many images are already in progress
+	WaitForPendingImagesLimit();
+}
+
+// Write the frames with all their images compressed to the database (in order), wait for the pending ones if requested
+void USLVisionLogger::WriteCompletedFrames(bool bWaitForPending)
+{
+	int32 NumWrittenFrames = 0;
+	for (auto& PendingFrame : PendingFrames)
+	{
+		// Frames are written in order, stop at the first one which is not ready
+		bool bIsReady = true;
+		for (auto& PendingImage : PendingFrame.Images)
+		{
+			if (!PendingImage.CompressedBitmap.IsReady())
+			{
+				if (!bWaitForPending)
+				{
+					bIsReady = false;
+					break;
+				}
+				PendingImage.CompressedBitmap.Wait();
+			}
+		}
+		if (!bIsReady)
+		{
+			break;
+		}
+
+		// Set the image binaries and write the frame
+		for (auto& PendingImage : PendingFrame.Images)
+		{
+			PendingFrame.FrameData.Views[PendingImage.ViewIdx].Images[PendingImage.ImageIdx].Data = PendingImage.CompressedBitmap.Get();
+		}
+
+		// Skip the images which could not be encoded (reference frames have no image data, only the size and region are used)
+		if (PendingFrame.FrameData.RefFrameIdx == INDEX_NONE)
+		{
+			for (auto& View : PendingFrame.FrameData.Views)
+			{
+				View.Images.RemoveAll([](const FSLVisionImageData& Img) { return Img.Data.Num() == 0; });
+			}
+		}
+		DBHandler.WriteFrame(PendingFrame.FrameData, ShardKey);
+		NumFramesSinceCheckpoint++;
+		NumWrittenFrames++;
+	}
+	PendingFrames.RemoveAt(0, NumWrittenFrames);
+
+	// Save the resume point every few frames (sharded or resumed runs)
+	if (bCheckpointProgress && NumFramesSinceCheckpoint >= CheckpointInterval)
+	{
+		WriteProgressCheckpoint();
+	}
+
+	// Images of an unfinished frame (e.g. forced finish) are not written
+	if (bWaitForPending)
+	{
+		for (auto& PendingImage : CurrPendingImages)
+		{
+			PendingImage.CompressedBitmap.Wait();
+		}
+		CurrPendingImages.Empty();
+		NumPendingImages = 0;
+	}
+}
+
+// Wait for the oldest pending images until the queue depth is within the limit
+void USLVisionLogger::WaitForPendingImagesLimit()
+{
+	// Images still in progress, oldest first
+	TArray<FSLVisionPendingImage*> InProgressImages;
+	for (auto& PendingFrame : PendingFrames)
+	{
+		for (auto& PendingImage : PendingFrame.Images)
+		{
+			if (!PendingImage.CompressedBitmap.IsReady())
+			{
+				InProgressImages.Add(&PendingImage);
+			}
+		}
+	}
+	for (auto& PendingImage : CurrPendingImages)
+	{
+		if (!PendingImage.CompressedBitmap.IsReady())
+		{
+			InProgressImages.Add(&PendingImage);
+		}
+	}
+
+	NumPendingImages = InProgressImages.Num();
+	for (int32 Idx = 0; NumPendingImages > MaxNumPendingImages && Idx < InProgressImages.Num(); ++Idx)
+	{
+		InProgressImages[Idx]->CompressedBitmap.Wait();
+		NumPendingImages--;
+	}
+}
+
+// Get the local path of the current screenshot image without the file extension (added after encoding)
+FString USLVisionLogger::GetLocalImagePathNoExtension() const
 {
 	const FString FolderName = VirtualCameras[CurrVirtualCameraIdx]->GetClassName() + "_" + CurrViewModePostfix;
-	FString Path = FPaths::ProjectDir() + "/SemLog/" + SaveLocallyFolderName + "/" + FolderName + "/" + CurrImageFilename + ".png";
+	FString Path = FPaths::ProjectDir() + "/SemLog/" + SaveLocallyFolderName + "/" + FolderName + "/" + CurrImageFilename;
+	FPaths::RemoveDuplicateSlashes(Path);
+	return Path;
+}
+
+// Get the individual manager from the world (or spawn a new one), provides the mask colors
+bool USLVisionLogger::SetIndividualManager()
+{
+	if (IndividualManager && IndividualManager->IsValidLowLevel() && !IndividualManager->IsPendingKillOrUnreachable())
+	{
+		return true;
+	}
+
+	for (TActorIterator<ASLIndividualManager>Iter(GetWorld()); Iter; ++Iter)
+	{
+		if ((*Iter)->IsValidLowLevel() && !(*Iter)->IsPendingKillOrUnreachable())
+		{
+			IndividualManager = *Iter;
+			return true;
+		}
+	}
+
+	// Spawning a new manager
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = TEXT("SL_IndividualManager");
+	IndividualManager = GetWorld()->SpawnActor<ASLIndividualManager>(SpawnParams);
+#if WITH_EDITOR
+	IndividualManager->SetActorLabel(TEXT("SL_IndividualManager"));
+#endif // WITH_EDITOR
+	return true;
+}
+
+// Get the mask color cache file of the level and its mask configuration (masked actors and level save time)
+FString USLVisionLogger::GetMaskColorCachePath() const
+{
+	const FString LevelPackageName = UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName());
+	const FString LevelFilename = FPackageName::LongPackageNameToFilename(LevelPackageName, FPackageName::GetMapPackageExtension());
+
+	// Any change in the masked actors or a new save of the level (e.g. re-calibrated masks) results in a new cache file
+	TArray<FString> MaskedActorNames;
+	for (const auto& Pair : OrigToMaskClones)
+	{
+		MaskedActorNames.Add(Pair.Key->GetName());
+	}
+	for (const auto& Pair : PoseableOrigToMaskClones)
+	{
+		MaskedActorNames.Add(Pair.Key->GetName());
+	}
+	MaskedActorNames.Sort();
+	MaskedActorNames.Add(IFileManager::Get().GetTimeStamp(*LevelFilename).ToString());
+	const uint32 ConfigHash = FCrc::StrCrc32(*FString::Join(MaskedActorNames, TEXT(";")));
+
+	FString Path = FPaths::ProjectDir() + "/SemLog/Cache/VisionMasks/" + FPaths::GetBaseFilename(LevelPackageName) +
+		FString::Printf(TEXT("_%08X.bin"), ConfigHash);
 	FPaths::RemoveDuplicateSlashes(Path);
-	FFileHelper::SaveArrayToFile(CompressedBitmap, *Path);
+	return Path;
+}
+
+// Overwrite the processed episode part with the command line values (multiple headless instances)
+void USLVisionLogger::ParseShardCommandLineArgs(FSLVisionLoggerParams& OutParams) const
+{
+	FParse::Value(FCommandLine::Get(), TEXT("SLVisFirstFrame="), OutParams.FirstFrameIdx);
+	FParse::Value(FCommandLine::Get(), TEXT("SLVisLastFrame="), OutParams.LastFrameIdx);
+	FParse::Value(FCommandLine::Get(), TEXT("SLVisFrameStride="), OutParams.FrameStride);
+	FParse::Value(FCommandLine::Get(), TEXT("SLVisCheckpointInterval="), OutParams.CheckpointInterval);
+
+	FString CameraIds;
+	if (FParse::Value(FCommandLine::Get(), TEXT("SLVisCameras="), CameraIds))
+	{
+		CameraIds.ParseIntoArray(OutParams.CameraIds, TEXT(","));
+	}
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("SLVisResume")))
+	{
+		OutParams.bResume = true;
+	}
+}
+
+// Queue a copy of the last rendered frame data for the current (unchanged) frame, its images are reused
+void USLVisionLogger::QueueReferenceFrame()
+{
+	FSLVisionPendingFrame& PendingFrame = PendingFrames.AddDefaulted_GetRef();
+	PendingFrame.FrameData = PrevRenderedFrameData;
+	PendingFrame.FrameData.Timestamp = CurrTimestamp;
+	PendingFrame.FrameData.FrameIdx = Episode.GetCurrIndex();
+	PendingFrame.FrameData.RefFrameIdx = PrevRenderedFrameData.FrameIdx;
+	NumSkippedFrames++;
+
+	// No images to wait for if the rendered frame is already written
+	WriteCompletedFrames(false);
+}
+
+// Save the last frame up to which all the frames are written as the resume point (does not wait for the pending uploads)
+void USLVisionLogger::WriteProgressCheckpoint()
+{
+	NumFramesSinceCheckpoint = 0;
+	if (!bCheckpointProgress)
+	{
+		return;
+	}
+
+	int32 FrameIdx;
+	float Timestamp;
+	if (DBHandler.GetLastContiguousWrittenFrame(FrameIdx, Timestamp) && FrameIdx != LastCheckpointFrameIdx)
+	{
+		DBHandler.WriteCheckpoint(ShardKey, FrameIdx, Timestamp);
+		LastCheckpointFrameIdx = FrameIdx;
+	}
 }
 
 // Output progress to terminal
@@ -956,13 +1386,15 @@ void USLVisionLogger::PrintProgress() const
 	const int32 CurrImgNr = Episode.GetCurrIndex() * TotalCameras * TotalViewModes + CurrVirtualCameraIdx * TotalViewModes + CurrViewModeNr;
 	const int32 TotalImgs = TotalFrames * TotalCameras * TotalViewModes;
 
-	UE_LOG(LogTemp, Warning, TEXT("%s::%d \t Camera=%ld/%ld; \t\t ViewMode=%ld/%ld; \t\t Image=%ld/%ld; \t\t Ts=%.2f/%.2f; \t\t Frame=%ld/%ld;"),
+	UE_LOG(LogTemp, Warning, TEXT("%s::%d \t Camera=%ld/%ld; \t\t ViewMode=%ld/%ld; \t\t Image=%ld/%ld; \t\t Ts=%.2f/%.2f; \t\t Frame=%ld/%ld; \t\t Skipped=%ld; \t\t Pending=%ld/%ld;"),
 		*FString(__func__), __LINE__,		
 		CurrCameraNr, TotalCameras,
 		CurrViewModeNr, TotalViewModes,
 		CurrImgNr, TotalImgs,
 		CurrTimestamp, LastTs,
-		CurrFrameNr, TotalFrames);
+		CurrFrameNr, TotalFrames,
+		NumSkippedFrames,
+		NumPendingImages, MaxNumPendingImages);
 }
 
 // Get view mode as string
@@ -0,0 +1,358 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Utils/SLImageCodec.h"
+#include "ImageUtils.h"
+#include "Misc/Compression.h"
+
+// Header layout: magic (4), version (1), codec (1), padding (2), size x (4), size y (4), raw payload size (4)
+static const uint32 SLImageCodecMagic = 0x43494C53; // "SLIC"
+static const uint8 SLImageCodecVersion = 1;
+static const int32 SLImageCodecHeaderSize = 20;
+
+// Encode the bitmap with the given codec, outputs the codec actually used (e.g. PNG fallback for too many mask colors)
+bool FSLImageCodec::Encode(ESLImageCodec Codec, int32 SizeX, int32 SizeY, const TArray<FColor>& Bitmap, TArray<uint8>& OutData, ESLImageCodec& OutUsedCodec)
+{
+	OutData.Reset();
+	OutUsedCodec = Codec;
+	if (SizeX <= 0 || SizeY <= 0 || Bitmap.Num() != SizeX * SizeY)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Image size mismatch.."), *FString(__FUNCTION__), __LINE__);
+		return false;
+	}
+
+	if (Codec == ESLImageCodec::PNG)
+	{
+		FImageUtils::CompressImageArray(SizeX, SizeY, Bitmap, OutData);
+		return OutData.Num() > 0;
+	}
+	else if (Codec == ESLImageCodec::RawLZ4 || Codec == ESLImageCodec::RawZlib)
+	{
+		const int32 RawPayloadSize = Bitmap.Num() * sizeof(FColor);
+		WriteHeader(Codec, SizeX, SizeY, RawPayloadSize, OutData);
+		return CompressPayload(Codec == ESLImageCodec::RawLZ4 ? NAME_LZ4 : NAME_Zlib,
+			reinterpret_cast<const uint8*>(Bitmap.GetData()), RawPayloadSize, OutData);
+	}
+	else if (Codec == ESLImageCodec::MaskRLE)
+	{
+		// Runs are already compact for flat colored masks, no further compression
+		TArray<uint8> RawPayload;
+		EncodeMaskRLE(Bitmap, RawPayload);
+		WriteHeader(Codec, SizeX, SizeY, RawPayload.Num(), OutData);
+		OutData.Append(RawPayload);
+		return true;
+	}
+	else if (Codec == ESLImageCodec::MaskIndexed)
+	{
+		TArray<uint8> RawPayload;
+		if (!EncodeMaskIndexed(Bitmap, RawPayload))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d Too many colors for an indexed encoding, using PNG.."), *FString(__FUNCTION__), __LINE__);
+			OutUsedCodec = ESLImageCodec::PNG;
+			FImageUtils::CompressImageArray(SizeX, SizeY, Bitmap, OutData);
+			return OutData.Num() > 0;
+		}
+		WriteHeader(Codec, SizeX, SizeY, RawPayload.Num(), OutData);
+		return CompressPayload(NAME_LZ4, RawPayload.GetData(), RawPayload.Num(), OutData);
+	}
+	return false;
+}
+
+// Decode the (non-PNG) image data into a bitmap
+bool FSLImageCodec::Decode(const TArray<uint8>& Data, int32& OutSizeX, int32& OutSizeY, TArray<FColor>& OutBitmap)
+{
+	ESLImageCodec Codec;
+	int32 RawPayloadSize;
+	if (!ReadHeader(Data, Codec, OutSizeX, OutSizeY, RawPayloadSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d No image codec header found (PNG images should be decoded with the image wrapper).."),
+			*FString(__FUNCTION__), __LINE__);
+		return false;
+	}
+
+	const int32 NumPixels = OutSizeX * OutSizeY;
+	if (Codec == ESLImageCodec::RawLZ4 || Codec == ESLImageCodec::RawZlib)
+	{
+		if (RawPayloadSize != NumPixels * (int32)sizeof(FColor))
+		{
+			return false;
+		}
+		TArray<uint8> RawPayload;
+		if (!UncompressPayload(Codec == ESLImageCodec::RawLZ4 ? NAME_LZ4 : NAME_Zlib, Data, RawPayloadSize, RawPayload))
+		{
+			return false;
+		}
+		OutBitmap.SetNumUninitialized(NumPixels);
+		FMemory::Memcpy(OutBitmap.GetData(), RawPayload.GetData(), RawPayloadSize);
+		return true;
+	}
+	else if (Codec == ESLImageCodec::MaskRLE)
+	{
+		if (Data.Num() != SLImageCodecHeaderSize + RawPayloadSize)
+		{
+			return false;
+		}
+		return DecodeMaskRLE(Data.GetData() + SLImageCodecHeaderSize, RawPayloadSize, NumPixels, OutBitmap);
+	}
+	else if (Codec == ESLImageCodec::MaskIndexed)
+	{
+		TArray<uint8> RawPayload;
+		if (!UncompressPayload(NAME_LZ4, Data, RawPayloadSize, RawPayload))
+		{
+			return false;
+		}
+		return DecodeMaskIndexed(RawPayload.GetData(), RawPayload.Num(), NumPixels, OutBitmap);
+	}
+	return false;
+}
+
+// Get the codec of the encoded data (PNG if no header is found)
+ESLImageCodec FSLImageCodec::GetCodec(const TArray<uint8>& Data)
+{
+	ESLImageCodec Codec;
+	int32 SizeX, SizeY, RawPayloadSize;
+	return ReadHeader(Data, Codec, SizeX, SizeY, RawPayloadSize) ? Codec : ESLImageCodec::PNG;
+}
+
+// Get the file extension used when saving the images locally
+FString FSLImageCodec::GetFileExtension(ESLImageCodec Codec)
+{
+	switch (Codec)
+	{
+	case ESLImageCodec::RawLZ4:
+		return FString(".lz4");
+	case ESLImageCodec::RawZlib:
+		return FString(".zlib");
+	case ESLImageCodec::MaskRLE:
+		return FString(".rle");
+	case ESLImageCodec::MaskIndexed:
+		return FString(".idx");
+	default:
+		return FString(".png");
+	}
+}
+
+// Append the header to the data
+void FSLImageCodec::WriteHeader(ESLImageCodec Codec, int32 SizeX, int32 SizeY, int32 RawPayloadSize, TArray<uint8>& OutData)
+{
+	const int32 Offset = OutData.AddZeroed(SLImageCodecHeaderSize);
+	uint8* Header = OutData.GetData() + Offset;
+	FMemory::Memcpy(Header, &SLImageCodecMagic, 4);
+	Header[4] = SLImageCodecVersion;
+	Header[5] = static_cast<uint8>(Codec);
+	FMemory::Memcpy(Header + 8, &SizeX, 4);
+	FMemory::Memcpy(Header + 12, &SizeY, 4);
+	FMemory::Memcpy(Header + 16, &RawPayloadSize, 4);
+}
+
+// Read the header from the data, returns false if the header is not valid
+bool FSLImageCodec::ReadHeader(const TArray<uint8>& Data, ESLImageCodec& OutCodec, int32& OutSizeX, int32& OutSizeY, int32& OutRawPayloadSize)
+{
+	if (Data.Num() < SLImageCodecHeaderSize)
+	{
+		return false;
+	}
+
+	const uint8* Header = Data.GetData();
+	uint32 Magic;
+	FMemory::Memcpy(&Magic, Header, 4);
+	if (Magic != SLImageCodecMagic || Header[4] != SLImageCodecVersion || Header[5] > static_cast<uint8>(ESLImageCodec::MaskIndexed))
+	{
+		return false;
+	}
+
+	OutCodec = static_cast<ESLImageCodec>(Header[5]);
+	FMemory::Memcpy(&OutSizeX, Header + 8, 4);
+	FMemory::Memcpy(&OutSizeY, Header + 12, 4);
+	FMemory::Memcpy(&OutRawPayloadSize, Header + 16, 4);
+	return OutSizeX > 0 && OutSizeY > 0 && OutRawPayloadSize >= 0;
+}
+
+// Append the compressed buffer to the data
+bool FSLImageCodec::CompressPayload(FName FormatName, const uint8* RawPayload, int32 RawPayloadSize, TArray<uint8>& OutData)
+{
+	const int32 Offset = OutData.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, RawPayloadSize);
+	OutData.AddUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(FormatName, OutData.GetData() + Offset, CompressedSize, RawPayload, RawPayloadSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not compress the image payload with %s.."),
+			*FString(__FUNCTION__), __LINE__, *FormatName.ToString());
+		OutData.SetNum(Offset);
+		return false;
+	}
+	OutData.SetNum(Offset + CompressedSize, false);
+	return true;
+}
+
+// Decompress the payload following the header
+bool FSLImageCodec::UncompressPayload(FName FormatName, const TArray<uint8>& Data, int32 RawPayloadSize, TArray<uint8>& OutRawPayload)
+{
+	OutRawPayload.SetNumUninitialized(RawPayloadSize);
+	if (!FCompression::UncompressMemory(FormatName, OutRawPayload.GetData(), RawPayloadSize,
+		Data.GetData() + SLImageCodecHeaderSize, Data.Num() - SLImageCodecHeaderSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not uncompress the image payload with %s.."),
+			*FString(__FUNCTION__), __LINE__, *FormatName.ToString());
+		return false;
+	}
+	return true;
+}
+
+/* Encodings */
+// Run length encoding of the pixels (run length and color pairs)
+void FSLImageCodec::EncodeMaskRLE(const TArray<FColor>& Bitmap, TArray<uint8>& OutRawPayload)
+{
+	const int32 NumPixels = Bitmap.Num();
+	const FColor* Pixels = Bitmap.GetData();
+
+	int32 Idx = 0;
+	while (Idx < NumPixels)
+	{
+		const FColor RunColor = Pixels[Idx];
+		uint32 RunLength = 1;
+		while (Idx + (int32)RunLength < NumPixels && Pixels[Idx + RunLength] == RunColor)
+		{
+			RunLength++;
+		}
+		Idx += RunLength;
+
+		const int32 Offset = OutRawPayload.AddUninitialized(sizeof(uint32) + sizeof(FColor));
+		FMemory::Memcpy(OutRawPayload.GetData() + Offset, &RunLength, sizeof(uint32));
+		FMemory::Memcpy(OutRawPayload.GetData() + Offset + sizeof(uint32), &RunColor, sizeof(FColor));
+	}
+}
+
+// Palette of the colors followed by the per pixel palette indexes
+bool FSLImageCodec::EncodeMaskIndexed(const TArray<FColor>& Bitmap, TArray<uint8>& OutRawPayload)
+{
+	const int32 NumPixels = Bitmap.Num();
+	const FColor* Pixels = Bitmap.GetData();
+
+	// Build the palette, masks have long runs of the same color, avoid the map lookup for them
+	TMap<FColor, uint16> ColorToIndex;
+	TArray<FColor> Palette;
+	TArray<uint16> Indexes;
+	Indexes.SetNumUninitialized(NumPixels);
+	FColor PrevColor = FColor::Transparent;
+	uint16 PrevIndex = MAX_uint16;
+	for (int32 Idx = 0; Idx < NumPixels; ++Idx)
+	{
+		const FColor& PixelColor = Pixels[Idx];
+		if (PixelColor != PrevColor || PrevIndex == MAX_uint16)
+		{
+			if (const uint16* ColorIdx = ColorToIndex.Find(PixelColor))
+			{
+				PrevIndex = *ColorIdx;
+			}
+			else
+			{
+				if (Palette.Num() >= MAX_uint16)
+				{
+					return false;
+				}
+				PrevIndex = (uint16)Palette.Add(PixelColor);
+				ColorToIndex.Add(PixelColor, PrevIndex);
+			}
+			PrevColor = PixelColor;
+		}
+		Indexes[Idx] = PrevIndex;
+	}
+
+	// Palette size, palette, and the indexes (one byte per index if the palette allows it)
+	const uint32 NumColors = Palette.Num();
+	const int32 IndexSize = NumColors <= 256 ? sizeof(uint8) : sizeof(uint16);
+	OutRawPayload.SetNumUninitialized(sizeof(uint32) + NumColors * sizeof(FColor) + NumPixels * IndexSize);
+	uint8* Out = OutRawPayload.GetData();
+	FMemory::Memcpy(Out, &NumColors, sizeof(uint32));
+	Out += sizeof(uint32);
+	FMemory::Memcpy(Out, Palette.GetData(), NumColors * sizeof(FColor));
+	Out += NumColors * sizeof(FColor);
+	if (IndexSize == sizeof(uint8))
+	{
+		for (int32 Idx = 0; Idx < NumPixels; ++Idx)
+		{
+			Out[Idx] = (uint8)Indexes[Idx];
+		}
+	}
+	else
+	{
+		FMemory::Memcpy(Out, Indexes.GetData(), NumPixels * sizeof(uint16));
+	}
+	return true;
+}
+
+/* Decodings */
+// Decode the run length encoded pixels
+bool FSLImageCodec::DecodeMaskRLE(const uint8* RawPayload, int32 RawPayloadSize, int32 NumPixels, TArray<FColor>& OutBitmap)
+{
+	const int32 RunSize = sizeof(uint32) + sizeof(FColor);
+	if (RawPayloadSize % RunSize != 0)
+	{
+		return false;
+	}
+
+	OutBitmap.SetNumUninitialized(NumPixels);
+	FColor* Pixels = OutBitmap.GetData();
+	int32 PixelIdx = 0;
+	for (int32 Offset = 0; Offset < RawPayloadSize; Offset += RunSize)
+	{
+		uint32 RunLength;
+		FColor RunColor;
+		FMemory::Memcpy(&RunLength, RawPayload + Offset, sizeof(uint32));
+		FMemory::Memcpy(&RunColor, RawPayload + Offset + sizeof(uint32), sizeof(FColor));
+		if (PixelIdx + (int64)RunLength > NumPixels)
+		{
+			return false;
+		}
+		for (uint32 Idx = 0; Idx < RunLength; ++Idx)
+		{
+			Pixels[PixelIdx++] = RunColor;
+		}
+	}
+	return PixelIdx == NumPixels;
+}
+
+// Decode the palette indexed pixels
+bool FSLImageCodec::DecodeMaskIndexed(const uint8* RawPayload, int32 RawPayloadSize, int32 NumPixels, TArray<FColor>& OutBitmap)
+{
+	if (RawPayloadSize < (int32)sizeof(uint32))
+	{
+		return false;
+	}
+
+	uint32 NumColors;
+	FMemory::Memcpy(&NumColors, RawPayload, sizeof(uint32));
+	const int32 IndexSize = NumColors <= 256 ? sizeof(uint8) : sizeof(uint16);
+	if (NumColors == 0 || NumColors > MAX_uint16
+		|| RawPayloadSize != (int64)sizeof(uint32) + NumColors * sizeof(FColor) + (int64)NumPixels * IndexSize)
+	{
+		return false;
+	}
+
+	TArray<FColor> Palette;
+	Palette.SetNumUninitialized(NumColors);
+	FMemory::Memcpy(Palette.GetData(), RawPayload + sizeof(uint32), NumColors * sizeof(FColor));
+	const uint8* Indexes = RawPayload + sizeof(uint32) + NumColors * sizeof(FColor);
+
+	OutBitmap.SetNumUninitialized(NumPixels);
+	FColor* Pixels = OutBitmap.GetData();
+	for (int32 Idx = 0; Idx < NumPixels; ++Idx)
+	{
+		uint16 ColorIdx;
+		if (IndexSize == sizeof(uint8))
+		{
+			ColorIdx = Indexes[Idx];
+		}
+		else
+		{
+			FMemory::Memcpy(&ColorIdx, Indexes + Idx * sizeof(uint16), sizeof(uint16));
+		}
+		if (ColorIdx >= NumColors)
+		{
+			return false;
+		}
+		Pixels[Idx] = Palette[ColorIdx];
+	}
+	return true;
+}
@@ -9,14 +9,44 @@
 #endif // SL_WITH_ROS_CONVERSIONS
 
 
+/**
+* Packed entity, skeletal entity or bone data of the compact frames
+*/
+struct FSLVisionPackedEntityData
+{
+	// Index in the entity dictionary
+	int32 DictIdx;
+
+	// Index of the skeletal entity in the view (bones only)
+	int32 ParentIdx;
+
+	// The percentage of the entity in the image
+	float ImagePercentage;
+
+	// Percentage of the entity being occluded
+	float OcclusionPercentage;
+
+	// Image bounding box
+	uint16 MinX;
+	uint16 MinY;
+	uint16 MaxX;
+	uint16 MaxY;
+
+	// Non zero if the entity is clipped by the image borders
+	uint32 bIsClipped;
+};
+
 // Ctor
-FSLVisionDBHandler::FSLVisionDBHandler() {}
+FSLVisionDBHandler::FSLVisionDBHandler() : bCompactFrames(false), NumSavedEntityDictEntries(0),
+	LastContiguousFrameIdx(INDEX_NONE), LastContiguousTimestamp(-1.f), bFrameMissing(false) {}
 
-// Connect to the database
+// Connect to the database (keep the previous entries if the collection is shared between multiple instances or resumed)
 bool FSLVisionDBHandler::Connect(const FString& DBName, const FString& CollName, const FString& ServerIp,
-	uint16 ServerPort, bool bRemovePrevEntries)
+	uint16 ServerPort, bool bRemovePrevEntries, bool bKeepPrevEntries)
 {
 	const FString VisCollName = CollName + ".vis";
+	const FString ProgressCollName = VisCollName + ".progress";
+	const FString DictCollName = VisCollName + ".dict";
 
 #if SL_WITH_LIBMONGO_C
 	// Required to initialize libmongoc's internals	
@@ -60,7 +90,12 @@ bool FSLVisionDBHandler::Connect(const FString& DBName, const FString& CollName,
 
 	if (mongoc_database_has_collection(database, TCHAR_TO_UTF8(*VisCollName), &error))
 	{
-		if (bRemovePrevEntries)
+		if (bKeepPrevEntries)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d Vis collection %s already exists, adding to it.."),
+				*FString(__func__), __LINE__, *VisCollName);
+		}
+		else if (bRemovePrevEntries)
 		{
 			if (!mongoc_collection_drop(mongoc_database_get_collection(database, TCHAR_TO_UTF8(*VisCollName)), &error))
 			{
@@ -77,6 +112,18 @@ bool FSLVisionDBHandler::Connect(const FString& DBName, const FString& CollName,
 				UE_LOG(LogTemp, Error, TEXT("%s::%d Could not drop collection, err.:%s;"),
 					*FString(__func__), __LINE__, *FString(error.message));
 			}
+			if (mongoc_database_has_collection(database, TCHAR_TO_UTF8(*ProgressCollName), &error) &&
+				!mongoc_collection_drop(mongoc_database_get_collection(database, TCHAR_TO_UTF8(*ProgressCollName)), &error))
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Could not drop collection, err.:%s;"),
+					*FString(__func__), __LINE__, *FString(error.message));
+			}
+			if (mongoc_database_has_collection(database, TCHAR_TO_UTF8(*DictCollName), &error) &&
+				!mongoc_collection_drop(mongoc_database_get_collection(database, TCHAR_TO_UTF8(*DictCollName)), &error))
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Could not drop collection, err.:%s;"),
+					*FString(__func__), __LINE__, *FString(error.message));
+			}
 		}
 		else
 		{
@@ -89,6 +136,8 @@ bool FSLVisionDBHandler::Connect(const FString& DBName, const FString& CollName,
 	UE_LOG(LogTemp, Warning, TEXT("%s::%d Creating a new vis collection %s .."),
 		*FString(__func__), __LINE__, *VisCollName);
 	vis_collection = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*VisCollName));
+	progress_collection = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*ProgressCollName));
+	dict_collection = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*DictCollName));
 
 	// Create a gridfs handle prefixed the vision collection
 	gridfs = mongoc_client_get_gridfs(client, TCHAR_TO_UTF8(*DBName), TCHAR_TO_UTF8(*VisCollName), &error);
@@ -111,6 +160,13 @@ bool FSLVisionDBHandler::Connect(const FString& DBName, const FString& CollName,
 	}
 	bson_destroy(server_ping_cmd);
 
+	// Upload the images in the background with pooled connections
+	if (!Uploader.Start(Uri, DBName, VisCollName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Could not start the background uploader, images will be written synchronously.."),
+			*FString(__func__), __LINE__);
+	}
+
 	// Remove previously added vision data
 	if (bRemovePrevEntries)
 	{
@@ -124,10 +180,15 @@ bool FSLVisionDBHandler::Connect(const FString& DBName, const FString& CollName,
 #endif //SL_WITH_LIBMONGO_C
 }
 
-// Disconnect and clean db connection
-void FSLVisionDBHandler::Disconnect() const
+// Disconnect and clean db connection (pending image uploads are finished first)
+void FSLVisionDBHandler::Disconnect()
 {
+	Uploader.Stop();
+
 #if SL_WITH_LIBMONGO_C
+	// All uploads are finished, write the remaining frames
+	WritePendingFrames(false);
+
 	// Release handles and clean up mongoc
 	if (uri)
 	{
@@ -149,10 +210,35 @@ void FSLVisionDBHandler::Disconnect() const
 	{
 		mongoc_collection_destroy(vis_collection);
 	}
+	if (progress_collection)
+	{
+		mongoc_collection_destroy(progress_collection);
+	}
+	if (dict_collection)
+	{
+		mongoc_collection_destroy(dict_collection);
+	}
 	mongoc_cleanup();
 #endif //SL_WITH_LIBMONGO_C
 }
 
+// Block until all the queued image uploads are written and write the frames referencing them,
+// return false on timeout (the frames stay pending) or if frames were skipped because of failed uploads
+bool FSLVisionDBHandler::FlushUploads()
+{
+#if SL_WITH_LIBMONGO_C
+	if (!Uploader.Flush())
+	{
+		// Write the frames which are already uploaded, the rest stays pending
+		WritePendingFrames(true);
+		return false;
+	}
+	return WritePendingFrames(false);
+#else
+	return Uploader.Flush();
+#endif //SL_WITH_LIBMONGO_C
+}
+
 // Create indexes on the inserted data
 void FSLVisionDBHandler::CreateIndexes() const
 {
@@ -395,10 +481,31 @@ bool FSLVisionDBHandler::GetEpisodeData(float UpdateRate, const TMap<ASkeletalMe
 #endif //SL_WITH_LIBMONGO_C
 }
 
-// Write current frame
-void FSLVisionDBHandler::WriteFrame(const FSLVisionFrameData& Frame) const
+// Write current frame (the images are uploaded in the background), tagged with the shard key if not empty,
+// frames referencing a previous frame reuse the image files of the last written frame, return false if the frame was skipped
+bool FSLVisionDBHandler::WriteFrame(const FSLVisionFrameData& Frame, const FString& ShardKey)
 {
 #if SL_WITH_LIBMONGO_C
+	// A reference frame without the image files of its referenced frame would be written without images
+	if (Frame.RefFrameIdx != INDEX_NONE && PrevImageFiles.Num() != Frame.Views.Num())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Frame %d references frame %d whose image files are not available (%d/%d views), skipping frame.."),
+			*FString(__func__), __LINE__, Frame.FrameIdx, Frame.RefFrameIdx, PrevImageFiles.Num(), Frame.Views.Num());
+		if (Uploader.IsRunning())
+		{
+			// Keep the place of the missing frame in the write order
+			FSLVisionPendingFrameDoc& SkippedFrame = PendingFrameDocs.AddDefaulted_GetRef();
+			SkippedFrame.PendingDoc.Doc = nullptr;
+			SkippedFrame.FrameIdx = Frame.FrameIdx;
+			SkippedFrame.Timestamp = Frame.Timestamp;
+		}
+		else
+		{
+			OnFrameWritten(Frame.FrameIdx, Frame.Timestamp, false);
+		}
+		return false;
+	}
+
 	// Document holding the frame data in bson format
 	bson_t frame_doc;
 	bson_init(&frame_doc);
@@ -437,9 +544,58 @@ void FSLVisionDBHandler::WriteFrame(const FSLVisionFrameData& Frame) const
 
 	bson_oid_t file_oid;
 
+	// Ids of the image files referenced by the frame and the number of them still uploading
+	TArray<bson_oid_t> FileOids;
+	TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe> NumPendingFiles;
+	if (Uploader.IsRunning())
+	{
+		NumPendingFiles = MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>();
+	}
+
 	// Add timestamp
 	BSON_APPEND_DOUBLE(&frame_doc, "timestamp", Frame.Timestamp);
 
+	// Add the episode frame index and the shard which wrote it (used for resuming)
+	if (Frame.FrameIdx != INDEX_NONE)
+	{
+		BSON_APPEND_INT32(&frame_doc, "frame_idx", Frame.FrameIdx);
+	}
+	if (!ShardKey.IsEmpty())
+	{
+		BSON_APPEND_UTF8(&frame_doc, "shard", TCHAR_TO_UTF8(*ShardKey));
+	}
+
+	// Entities are stored as packed binaries indexing the shard dictionary, continue the dictionary of the previous runs
+	if (bCompactFrames)
+	{
+		const FString DictId = ShardKey.IsEmpty() ? FString("default") : ShardKey;
+		if (EntityDictId != DictId)
+		{
+			EntityDictId = DictId;
+			EntityDict.Reset();
+			EntityDictIndexes.Reset();
+			LoadEntityDict(EntityDictId, EntityDict);
+			for (int32 Idx = 0; Idx < EntityDict.Num(); ++Idx)
+			{
+				EntityDictIndexes.Add(EntityDict[Idx].Key + TEXT("|") + EntityDict[Idx].Value, Idx);
+			}
+			NumSavedEntityDictEntries = EntityDict.Num();
+		}
+		BSON_APPEND_BOOL(&frame_doc, "compact", true);
+	}
+
+	// Nothing changed since the referenced frame, its images are reused
+	const bool bIsRefFrame = Frame.RefFrameIdx != INDEX_NONE;
+	if (bIsRefFrame)
+	{
+		BSON_APPEND_INT32(&frame_doc, "ref_frame_idx", Frame.RefFrameIdx);
+	}
+	else
+	{
+		PrevImageFiles.Reset();
+		PrevImageFiles.SetNum(Frame.Views.Num());
+	}
+
 	// Begin adding views data tot the 
 	BSON_APPEND_ARRAY_BEGIN(&frame_doc, "views", &views_arr);
 
@@ -453,84 +609,119 @@ void FSLVisionDBHandler::WriteFrame(const FSLVisionFrameData& Frame) const
 		BSON_APPEND_UTF8(&views_arr_obj, "class", TCHAR_TO_UTF8(*ViewData.Class));
 		BSON_APPEND_UTF8(&views_arr_obj, "id", TCHAR_TO_UTF8(*ViewData.Id));
 
-		// Create the entities array
-		j = 0;
-		BSON_APPEND_ARRAY_BEGIN(&views_arr_obj, "entities", &entities_arr);
-		for (const auto& Entity : ViewData.Entities)
+		if (bCompactFrames)
 		{
-			bson_uint32_to_string(j, &j_key, j_str, sizeof j_str);
-			BSON_APPEND_DOCUMENT_BEGIN(&entities_arr, j_key, &entities_arr_obj);
-
-			BSON_APPEND_UTF8(&entities_arr_obj, "id", TCHAR_TO_UTF8(*Entity.Id));
-			BSON_APPEND_UTF8(&entities_arr_obj, "class", TCHAR_TO_UTF8(*Entity.Class));
-			BSON_APPEND_DOUBLE(&entities_arr_obj, "img_perc", Entity.ImagePercentage);
-			BSON_APPEND_DOUBLE(&entities_arr_obj, "occl_perc", Entity.OcclusionPercentage);
-			BSON_APPEND_BOOL(&entities_arr_obj, "clipped", Entity.bIsClipped);
-		
-			AddBBObj(Entity.MinBB, Entity.MaxBB, &entities_arr_obj);
-
-			bson_append_document_end(&entities_arr, &entities_arr_obj);
-			j++;
+			AddCompactEntitiesData(ViewData, &views_arr_obj);
 		}
-		bson_append_array_end(&views_arr_obj, &entities_arr);
-
-		// Create the skeletal entities array
-		j = 0;
-		BSON_APPEND_ARRAY_BEGIN(&views_arr_obj, "skel_entities", &entities_arr);
-		for (const auto& SkelEntity : ViewData.SkelEntities)
+		else
 		{
-			bson_uint32_to_string(j, &j_key, j_str, sizeof j_str);
-			BSON_APPEND_DOCUMENT_BEGIN(&entities_arr, j_key, &entities_arr_obj);
+			// Create the entities array
+			j = 0;
+			BSON_APPEND_ARRAY_BEGIN(&views_arr_obj, "entities", &entities_arr);
+			for (const auto& Entity : ViewData.Entities)
+			{
+				bson_uint32_to_string(j, &j_key, j_str, sizeof j_str);
+				BSON_APPEND_DOCUMENT_BEGIN(&entities_arr, j_key, &entities_arr_obj);
+
+				BSON_APPEND_UTF8(&entities_arr_obj, "id", TCHAR_TO_UTF8(*Entity.Id));
+				BSON_APPEND_UTF8(&entities_arr_obj, "class", TCHAR_TO_UTF8(*Entity.Class));
+				BSON_APPEND_DOUBLE(&entities_arr_obj, "img_perc", Entity.ImagePercentage);
+				BSON_APPEND_DOUBLE(&entities_arr_obj, "occl_perc", Entity.OcclusionPercentage);
+				BSON_APPEND_BOOL(&entities_arr_obj, "clipped", Entity.bIsClipped);
+		
+				AddBBObj(Entity.MinBB, Entity.MaxBB, &entities_arr_obj);
 
-			BSON_APPEND_UTF8(&entities_arr_obj, "id", TCHAR_TO_UTF8(*SkelEntity.Id));
-			BSON_APPEND_UTF8(&entities_arr_obj, "class", TCHAR_TO_UTF8(*SkelEntity.Class));
-			BSON_APPEND_DOUBLE(&entities_arr_obj, "img_perc", SkelEntity.ImagePercentage);
-			BSON_APPEND_DOUBLE(&entities_arr_obj, "occl_perc", SkelEntity.OcclusionPercentage);
-			BSON_APPEND_BOOL(&entities_arr_obj, "clipped", SkelEntity.bIsClipped);
-			AddBBObj(SkelEntity.MinBB, SkelEntity.MaxBB, &entities_arr_obj);
+				bson_append_document_end(&entities_arr, &entities_arr_obj);
+				j++;
+			}
+			bson_append_array_end(&views_arr_obj, &entities_arr);
 
-			// Create the bones array
-			k = 0;
-			BSON_APPEND_ARRAY_BEGIN(&entities_arr_obj, "bones", &bones_arr);
-			for (const auto& Bone : SkelEntity.Bones)
+			// Create the skeletal entities array
+			j = 0;
+			BSON_APPEND_ARRAY_BEGIN(&views_arr_obj, "skel_entities", &entities_arr);
+			for (const auto& SkelEntity : ViewData.SkelEntities)
 			{
-				bson_uint32_to_string(k, &k_key, k_str, sizeof k_str);
-				BSON_APPEND_DOCUMENT_BEGIN(&bones_arr, k_key, &bones_arr_obj);
+				bson_uint32_to_string(j, &j_key, j_str, sizeof j_str);
+				BSON_APPEND_DOCUMENT_BEGIN(&entities_arr, j_key, &entities_arr_obj);
+
+				BSON_APPEND_UTF8(&entities_arr_obj, "id", TCHAR_TO_UTF8(*SkelEntity.Id));
+				BSON_APPEND_UTF8(&entities_arr_obj, "class", TCHAR_TO_UTF8(*SkelEntity.Class));
+				BSON_APPEND_DOUBLE(&entities_arr_obj, "img_perc", SkelEntity.ImagePercentage);
+				BSON_APPEND_DOUBLE(&entities_arr_obj, "occl_perc", SkelEntity.OcclusionPercentage);
+				BSON_APPEND_BOOL(&entities_arr_obj, "clipped", SkelEntity.bIsClipped);
+				AddBBObj(SkelEntity.MinBB, SkelEntity.MaxBB, &entities_arr_obj);
+
+				// Create the bones array
+				k = 0;
+				BSON_APPEND_ARRAY_BEGIN(&entities_arr_obj, "bones", &bones_arr);
+				for (const auto& Bone : SkelEntity.Bones)
+				{
+					bson_uint32_to_string(k, &k_key, k_str, sizeof k_str);
+					BSON_APPEND_DOCUMENT_BEGIN(&bones_arr, k_key, &bones_arr_obj);
 
-				BSON_APPEND_UTF8(&bones_arr_obj, "class", TCHAR_TO_UTF8(*Bone.Class));
-				BSON_APPEND_DOUBLE(&bones_arr_obj, "img_perc", Bone.ImagePercentage);
-				BSON_APPEND_DOUBLE(&bones_arr_obj, "occl_perc", Bone.OcclusionPercentage);
-				BSON_APPEND_BOOL(&bones_arr_obj, "clipped", Bone.bIsClipped);
+					BSON_APPEND_UTF8(&bones_arr_obj, "class", TCHAR_TO_UTF8(*Bone.Class));
+					BSON_APPEND_DOUBLE(&bones_arr_obj, "img_perc", Bone.ImagePercentage);
+					BSON_APPEND_DOUBLE(&bones_arr_obj, "occl_perc", Bone.OcclusionPercentage);
+					BSON_APPEND_BOOL(&bones_arr_obj, "clipped", Bone.bIsClipped);
 
-				AddBBObj(Bone.MinBB, Bone.MaxBB, &bones_arr_obj);
+					AddBBObj(Bone.MinBB, Bone.MaxBB, &bones_arr_obj);
 
-				bson_append_document_end(&bones_arr, &bones_arr_obj);
-				k++;
-			}
-			bson_append_array_end(&entities_arr_obj, &bones_arr);
+					bson_append_document_end(&bones_arr, &bones_arr_obj);
+					k++;
+				}
+				bson_append_array_end(&entities_arr_obj, &bones_arr);
 
-			bson_append_document_end(&entities_arr, &entities_arr_obj);
-			j++;
+				bson_append_document_end(&entities_arr, &entities_arr_obj);
+				j++;
+			}
+			bson_append_array_end(&views_arr_obj, &entities_arr);
 		}
-		bson_append_array_end(&views_arr_obj, &entities_arr);
 
 		// Create the images array
 		k = 0;
 		BSON_APPEND_ARRAY_BEGIN(&views_arr_obj, "images", &imgs_arr);
-		for (const auto& Img : ViewData.Images)
+		if (bIsRefFrame)
 		{
-			if (AddToGridFs(Img.Data, &file_oid))
+			// Reuse the image files of the referenced frame
+			for (const auto& ImgFile : PrevImageFiles[i])
 			{
 				bson_uint32_to_string(k, &k_key, k_str, sizeof k_str);
 				BSON_APPEND_DOCUMENT_BEGIN(&imgs_arr, k_key, &imgs_arr_obj);
 
-				BSON_APPEND_UTF8(&imgs_arr_obj, "type", TCHAR_TO_UTF8(*Img.Type));
-				BSON_APPEND_OID(&imgs_arr_obj, "file_id", (const bson_oid_t*)&file_oid);
+				BSON_APPEND_UTF8(&imgs_arr_obj, "type", TCHAR_TO_UTF8(*ImgFile.Key));
+				BSON_APPEND_OID(&imgs_arr_obj, "file_id", &ImgFile.Value);
+				FileOids.Add(ImgFile.Value);
+				if (const FSLVisionImageData* Img = ViewData.Images.FindByPredicate(
+					[&ImgFile](const FSLVisionImageData& Item) { return Item.Type == ImgFile.Key; }))
+				{
+					AddImageSizeObj(*Img, &imgs_arr_obj);
+				}
 
 				bson_append_document_end(&imgs_arr, &imgs_arr_obj);
 				k++;
 			}
 		}
+		else
+		{
+			for (const auto& Img : ViewData.Images)
+			{
+				if (AddToGridFs(Img.Data, &file_oid, NumPendingFiles))
+				{
+					bson_uint32_to_string(k, &k_key, k_str, sizeof k_str);
+					BSON_APPEND_DOCUMENT_BEGIN(&imgs_arr, k_key, &imgs_arr_obj);
+
+					BSON_APPEND_UTF8(&imgs_arr_obj, "type", TCHAR_TO_UTF8(*Img.Type));
+					BSON_APPEND_OID(&imgs_arr_obj, "file_id", (const bson_oid_t*)&file_oid);
+					AddImageSizeObj(Img, &imgs_arr_obj);
+
+					bson_append_document_end(&imgs_arr, &imgs_arr_obj);
+					k++;
+
+					PrevImageFiles[i].Emplace(Img.Type, file_oid);
+					FileOids.Add(file_oid);
+				}
+			}
+		}
 		bson_append_array_end(&views_arr_obj, &imgs_arr);
 
 		// End array entry
@@ -539,11 +730,188 @@ void FSLVisionDBHandler::WriteFrame(const FSLVisionFrameData& Frame) const
 	}
 	bson_append_array_end(&frame_doc, &views_arr);
 
+	// New dictionary entries are saved before the frame referencing them
+	if (bCompactFrames)
+	{
+		WriteEntityDict();
+	}
+
 	// Update DB at the given timestamp with the document
 	//WriteToWorldColl_Legacy(&frame_doc, Frame.Timestamp);
-	WriteToVisionColl(&frame_doc);
+	bool bSuccess = true;
+	if (Uploader.IsRunning())
+	{
+		// The frame is written once its images are uploaded, write the previous frames which are ready (does not block)
+		FSLVisionPendingFrameDoc& PendingFrame = PendingFrameDocs.AddDefaulted_GetRef();
+		PendingFrame.PendingDoc.Doc = bson_copy(&frame_doc);
+		PendingFrame.PendingDoc.FileOids = MoveTemp(FileOids);
+		PendingFrame.PendingDoc.NumPendingFiles = NumPendingFiles;
+		PendingFrame.FrameIdx = Frame.FrameIdx;
+		PendingFrame.Timestamp = Frame.Timestamp;
+		WritePendingFrames(true);
+	}
+	else
+	{
+		bSuccess = WriteToVisionColl(&frame_doc);
+		OnFrameWritten(Frame.FrameIdx, Frame.Timestamp, bSuccess);
+	}
 
 	bson_destroy(&frame_doc);
+	return bSuccess;
+#else
+	return false;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Get the last checkpointed frame of the shard, return false if no checkpoint exists
+bool FSLVisionDBHandler::GetCheckpoint(const FString& ShardKey, int32& OutFrameIdx) const
+{
+#if SL_WITH_LIBMONGO_C
+	bool bFound = false;
+	bson_t* filter = BCON_NEW("_id", BCON_UTF8(TCHAR_TO_UTF8(*ShardKey)));
+	mongoc_cursor_t* cursor = mongoc_collection_find_with_opts(progress_collection, filter, NULL, NULL);
+
+	const bson_t* doc;
+	if (mongoc_cursor_next(cursor, &doc))
+	{
+		bson_iter_t iter;
+		if (bson_iter_init_find(&iter, doc, "frame_idx") && BSON_ITER_HOLDS_INT32(&iter))
+		{
+			OutFrameIdx = bson_iter_int32(&iter);
+			bFound = true;
+		}
+	}
+
+	bson_error_t error;
+	if (mongoc_cursor_error(cursor, &error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Err.: %s"),
+			*FString(__func__), __LINE__, *FString(error.message));
+	}
+
+	mongoc_cursor_destroy(cursor);
+	bson_destroy(filter);
+	return bFound;
+#else
+	return false;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Save the last completely written frame of the shard
+bool FSLVisionDBHandler::WriteCheckpoint(const FString& ShardKey, int32 FrameIdx, float Timestamp) const
+{
+#if SL_WITH_LIBMONGO_C
+	bson_error_t error;
+	bson_t* selector = BCON_NEW("_id", BCON_UTF8(TCHAR_TO_UTF8(*ShardKey)));
+	bson_t* replacement = BCON_NEW(
+		"frame_idx", BCON_INT32(FrameIdx),
+		"timestamp", BCON_DOUBLE(Timestamp));
+	bson_t* opts = BCON_NEW("upsert", BCON_BOOL(true));
+
+	bool bSuccess = true;
+	if (!mongoc_collection_replace_one(progress_collection, selector, replacement, opts, NULL, &error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Err.: %s"),
+			*FString(__func__), __LINE__, *FString(error.message));
+		bSuccess = false;
+	}
+
+	bson_destroy(selector);
+	bson_destroy(replacement);
+	bson_destroy(opts);
+	return bSuccess;
+#else
+	return false;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Get the last frame up to which all the frames are written, return false if there is none
+bool FSLVisionDBHandler::GetLastContiguousWrittenFrame(int32& OutFrameIdx, float& OutTimestamp) const
+{
+	if (LastContiguousFrameIdx == INDEX_NONE)
+	{
+		return false;
+	}
+	OutFrameIdx = LastContiguousFrameIdx;
+	OutTimestamp = LastContiguousTimestamp;
+	return true;
+}
+
+// Remove the frames of the shard written after the given frame (all of them and the checkpoint if INDEX_NONE)
+void FSLVisionDBHandler::RemoveShardEntries(const FString& ShardKey, int32 AfterFrameIdx) const
+{
+#if SL_WITH_LIBMONGO_C
+	bson_error_t error;
+	bson_t reply;
+	bson_t* selector = BCON_NEW(
+		"shard", BCON_UTF8(TCHAR_TO_UTF8(*ShardKey)),
+		"frame_idx", "{", "$gt", BCON_INT32(AfterFrameIdx), "}");
+	if (!mongoc_collection_delete_many(vis_collection, selector, NULL, &reply, &error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Err.: %s"),
+			*FString(__func__), __LINE__, *FString(error.message));
+	}
+	else
+	{
+		bson_iter_t iter;
+		if (bson_iter_init_find(&iter, &reply, "deletedCount") && BSON_ITER_HOLDS_INT(&iter))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d Removed %ld frames of shard %s written after frame %ld.."),
+				*FString(__func__), __LINE__, bson_iter_as_int64(&iter), *ShardKey, AfterFrameIdx);
+		}
+	}
+	bson_destroy(&reply);
+	bson_destroy(selector);
+
+	// Start from scratch
+	if (AfterFrameIdx == INDEX_NONE)
+	{
+		bson_t* progress_selector = BCON_NEW("_id", BCON_UTF8(TCHAR_TO_UTF8(*ShardKey)));
+		if (!mongoc_collection_delete_one(progress_collection, progress_selector, NULL, NULL, &error))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Err.: %s"),
+				*FString(__func__), __LINE__, *FString(error.message));
+		}
+		bson_destroy(progress_selector);
+	}
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Get the written vision frames (of the shard if not empty) in both schemas, the image binaries are not downloaded
+bool FSLVisionDBHandler::GetVisionFrames(TArray<FSLVisionFrameData>& OutFrames, const FString& ShardKey) const
+{
+#if SL_WITH_LIBMONGO_C
+	bson_error_t error;
+	const bson_t* doc;
+	bson_t* filter = ShardKey.IsEmpty() ? bson_new() : BCON_NEW("shard", BCON_UTF8(TCHAR_TO_UTF8(*ShardKey)));
+	bson_t* opts = BCON_NEW("sort", "{", "timestamp", BCON_INT32(1), "}");
+	mongoc_cursor_t* cursor = mongoc_collection_find_with_opts(vis_collection, filter, opts, NULL);
+
+	// Dictionaries of the compact frames, loaded once per shard
+	TMap<FString, TArray<TPair<FString, FString>>> Dicts;
+	while (mongoc_cursor_next(cursor, &doc))
+	{
+		FSLVisionFrameData Frame;
+		if (GetFrameData(doc, Dicts, Frame))
+		{
+			OutFrames.Emplace(MoveTemp(Frame));
+		}
+	}
+
+	bool bSuccess = true;
+	if (mongoc_cursor_error(cursor, &error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Failed to iterate all documents.. Err. %s"),
+			*FString(__func__), __LINE__, *FString(error.message));
+		bSuccess = false;
+	}
+
+	mongoc_cursor_destroy(cursor);
+	bson_destroy(filter);
+	bson_destroy(opts);
+	return bSuccess;
+#else
+	return false;
 #endif //SL_WITH_LIBMONGO_C
 }
 
@@ -804,9 +1172,17 @@ bool FSLVisionDBHandler::GetSkeletalEntitiesData(bson_iter_t* doc,
 	return false;
 }
 
-// Save image to gridfs, get the file oid and return true if succeeded
-bool FSLVisionDBHandler::AddToGridFs(const TArray<uint8>& InData, bson_oid_t* out_oid) const
+// Save image to gridfs (queued if the uploader is running, counted in the frame pending files), get the file oid and return true if succeeded
+bool FSLVisionDBHandler::AddToGridFs(const TArray<uint8>& InData, bson_oid_t* out_oid,
+	const TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe>& NumFramePendingFiles)
 {
+	// The file id is generated locally, the frame document can reference it before the upload finished
+	if (Uploader.IsRunning())
+	{
+		Uploader.Enqueue(InData, out_oid, NumFramePendingFiles);
+		return true;
+	}
+
 	mongoc_gridfs_file_t *file;
 	mongoc_gridfs_file_opt_t file_opt = { 0 };
 	const bson_value_t* file_id_val;
@@ -923,6 +1299,547 @@ bool FSLVisionDBHandler::WriteToVisionColl(bson_t* doc) const
 	return true;
 }
 
+// Write the frames waiting for their image uploads in order, stop at the first frame with unfinished uploads (if only the uploaded are written),
+// skip the ones referencing failed uploads, return false if any frame was skipped
+bool FSLVisionDBHandler::WritePendingFrames(bool bOnlyUploaded)
+{
+	bool bAllWritten = true;
+	int32 NumProcessed = 0;
+	for (auto& PendingFrame : PendingFrameDocs)
+	{
+		FSLGridFsPendingDoc& PendingDoc = PendingFrame.PendingDoc;
+		if (bOnlyUploaded && !PendingDoc.IsUploaded())
+		{
+			break;
+		}
+
+		bool bWritten = false;
+		if (!PendingDoc.Doc)
+		{
+			// Frame was skipped when queued
+		}
+		else if (Uploader.HasFailed(PendingDoc.FileOids))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Frame %d (%f) references images which could not be uploaded, skipping frame.."),
+				*FString(__func__), __LINE__, PendingFrame.FrameIdx, PendingFrame.Timestamp);
+		}
+		else
+		{
+			bWritten = WriteToVisionColl(PendingDoc.Doc);
+		}
+
+		if (PendingDoc.Doc)
+		{
+			bson_destroy(PendingDoc.Doc);
+		}
+		OnFrameWritten(PendingFrame.FrameIdx, PendingFrame.Timestamp, bWritten);
+		bAllWritten &= bWritten;
+		NumProcessed++;
+	}
+	PendingFrameDocs.RemoveAt(0, NumProcessed);
+	return bAllWritten;
+}
+
+// Track the last frame up to which all the frames are written, a missing frame stops the tracking
+void FSLVisionDBHandler::OnFrameWritten(int32 FrameIdx, float Timestamp, bool bWritten)
+{
+	if (bFrameMissing)
+	{
+		return;
+	}
+
+	if (bWritten)
+	{
+		LastContiguousFrameIdx = FrameIdx;
+		LastContiguousTimestamp = Timestamp;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Frame %d is missing, the last frame written without gaps stays %d.."),
+			*FString(__func__), __LINE__, FrameIdx, LastContiguousFrameIdx);
+		bFrameMissing = true;
+	}
+}
+
+// Add the entities, skeletal entities and bones of the view as packed binaries with dictionary indexes
+void FSLVisionDBHandler::AddCompactEntitiesData(const FSLVisionViewData& ViewData, bson_t* doc)
+{
+	auto PackData = [](int32 DictIdx, int32 ParentIdx, float ImgPerc, float OcclPerc,
+		const FIntPoint& MinBB, const FIntPoint& MaxBB, bool bIsClipped)
+	{
+		FSLVisionPackedEntityData Data;
+		Data.DictIdx = DictIdx;
+		Data.ParentIdx = ParentIdx;
+		Data.ImagePercentage = ImgPerc;
+		Data.OcclusionPercentage = OcclPerc;
+		Data.MinX = (uint16)FMath::Clamp(MinBB.X, 0, (int32)MAX_uint16);
+		Data.MinY = (uint16)FMath::Clamp(MinBB.Y, 0, (int32)MAX_uint16);
+		Data.MaxX = (uint16)FMath::Clamp(MaxBB.X, 0, (int32)MAX_uint16);
+		Data.MaxY = (uint16)FMath::Clamp(MaxBB.Y, 0, (int32)MAX_uint16);
+		Data.bIsClipped = bIsClipped ? 1 : 0;
+		return Data;
+	};
+
+	TArray<FSLVisionPackedEntityData> Entities;
+	Entities.Reserve(ViewData.Entities.Num());
+	for (const auto& Entity : ViewData.Entities)
+	{
+		Entities.Add(PackData(GetEntityDictIdx(Entity.Id, Entity.Class), INDEX_NONE,
+			Entity.ImagePercentage, Entity.OcclusionPercentage, Entity.MinBB, Entity.MaxBB, Entity.bIsClipped));
+	}
+
+	TArray<FSLVisionPackedEntityData> SkelEntities;
+	TArray<FSLVisionPackedEntityData> Bones;
+	SkelEntities.Reserve(ViewData.SkelEntities.Num());
+	for (const auto& SkelEntity : ViewData.SkelEntities)
+	{
+		const int32 SkelIdx = SkelEntities.Add(PackData(GetEntityDictIdx(SkelEntity.Id, SkelEntity.Class), INDEX_NONE,
+			SkelEntity.ImagePercentage, SkelEntity.OcclusionPercentage, SkelEntity.MinBB, SkelEntity.MaxBB, SkelEntity.bIsClipped));
+		for (const auto& Bone : SkelEntity.Bones)
+		{
+			Bones.Add(PackData(GetEntityDictIdx(FString(), Bone.Class), SkelIdx,
+				Bone.ImagePercentage, Bone.OcclusionPercentage, Bone.MinBB, Bone.MaxBB, Bone.bIsClipped));
+		}
+	}
+
+	BSON_APPEND_BINARY(doc, "ents", BSON_SUBTYPE_BINARY,
+		(const uint8_t*)Entities.GetData(), Entities.Num() * sizeof(FSLVisionPackedEntityData));
+	BSON_APPEND_BINARY(doc, "skel", BSON_SUBTYPE_BINARY,
+		(const uint8_t*)SkelEntities.GetData(), SkelEntities.Num() * sizeof(FSLVisionPackedEntityData));
+	BSON_APPEND_BINARY(doc, "bones", BSON_SUBTYPE_BINARY,
+		(const uint8_t*)Bones.GetData(), Bones.Num() * sizeof(FSLVisionPackedEntityData));
+}
+
+// Get the dictionary index of the entity (bones have an empty id), new entries are appended
+int32 FSLVisionDBHandler::GetEntityDictIdx(const FString& Id, const FString& Class)
+{
+	const FString Key = Id + TEXT("|") + Class;
+	if (const int32* Idx = EntityDictIndexes.Find(Key))
+	{
+		return *Idx;
+	}
+	const int32 NewIdx = EntityDict.Emplace(Id, Class);
+	EntityDictIndexes.Add(Key, NewIdx);
+	return NewIdx;
+}
+
+// Load the entity dictionary entries (id, class)
+bool FSLVisionDBHandler::LoadEntityDict(const FString& DictId, TArray<TPair<FString, FString>>& OutEntries) const
+{
+	bool bFound = false;
+	bson_t* filter = BCON_NEW("_id", BCON_UTF8(TCHAR_TO_UTF8(*DictId)));
+	mongoc_cursor_t* cursor = mongoc_collection_find_with_opts(dict_collection, filter, NULL, NULL);
+
+	const bson_t* doc;
+	if (mongoc_cursor_next(cursor, &doc))
+	{
+		bson_iter_t ids_iter;
+		bson_iter_t classes_iter;
+		bson_iter_t ids_child;
+		bson_iter_t classes_child;
+		if (bson_iter_init_find(&ids_iter, doc, "ids") && bson_iter_recurse(&ids_iter, &ids_child) &&
+			bson_iter_init_find(&classes_iter, doc, "classes") && bson_iter_recurse(&classes_iter, &classes_child))
+		{
+			while (bson_iter_next(&ids_child) && bson_iter_next(&classes_child))
+			{
+				OutEntries.Emplace(FString(UTF8_TO_TCHAR(bson_iter_utf8(&ids_child, NULL))),
+					FString(UTF8_TO_TCHAR(bson_iter_utf8(&classes_child, NULL))));
+			}
+			bFound = true;
+		}
+	}
+
+	mongoc_cursor_destroy(cursor);
+	bson_destroy(filter);
+	return bFound;
+}
+
+// Save the entity dictionary if new entries were added
+bool FSLVisionDBHandler::WriteEntityDict()
+{
+	if (EntityDict.Num() == NumSavedEntityDictEntries)
+	{
+		return true;
+	}
+
+	bson_t dict_doc;
+	bson_init(&dict_doc);
+	BSON_APPEND_UTF8(&dict_doc, "_id", TCHAR_TO_UTF8(*EntityDictId));
+
+	bson_t ids_arr;
+	bson_t classes_arr;
+	char idx_str[16];
+	const char *idx_key;
+	BSON_APPEND_ARRAY_BEGIN(&dict_doc, "ids", &ids_arr);
+	for (int32 Idx = 0; Idx < EntityDict.Num(); ++Idx)
+	{
+		bson_uint32_to_string(Idx, &idx_key, idx_str, sizeof idx_str);
+		BSON_APPEND_UTF8(&ids_arr, idx_key, TCHAR_TO_UTF8(*EntityDict[Idx].Key));
+	}
+	bson_append_array_end(&dict_doc, &ids_arr);
+	BSON_APPEND_ARRAY_BEGIN(&dict_doc, "classes", &classes_arr);
+	for (int32 Idx = 0; Idx < EntityDict.Num(); ++Idx)
+	{
+		bson_uint32_to_string(Idx, &idx_key, idx_str, sizeof idx_str);
+		BSON_APPEND_UTF8(&classes_arr, idx_key, TCHAR_TO_UTF8(*EntityDict[Idx].Value));
+	}
+	bson_append_array_end(&dict_doc, &classes_arr);
+
+	bson_error_t error;
+	bson_t* selector = BCON_NEW("_id", BCON_UTF8(TCHAR_TO_UTF8(*EntityDictId)));
+	bson_t* opts = BCON_NEW("upsert", BCON_BOOL(true));
+	bool bSuccess = true;
+	if (!mongoc_collection_replace_one(dict_collection, selector, &dict_doc, opts, NULL, &error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Err.: %s"),
+			*FString(__func__), __LINE__, *FString(error.message));
+		bSuccess = false;
+	}
+	else
+	{
+		NumSavedEntityDictEntries = EntityDict.Num();
+	}
+
+	bson_destroy(selector);
+	bson_destroy(opts);
+	bson_destroy(&dict_doc);
+	return bSuccess;
+}
+
+// Decode the frame document (verbose or compact schema)
+bool FSLVisionDBHandler::GetFrameData(const bson_t* doc, TMap<FString, TArray<TPair<FString, FString>>>& InOutDicts,
+	FSLVisionFrameData& OutFrame) const
+{
+	bson_iter_t iter;
+	if (!bson_iter_init(&iter, doc))
+	{
+		return false;
+	}
+
+	bool bIsCompact = false;
+	bool bHasViews = false;
+	FString DictId("default");
+	bson_iter_t views_iter;
+	while (bson_iter_next(&iter))
+	{
+		const char* key = bson_iter_key(&iter);
+		if (strcmp(key, "timestamp") == 0)
+		{
+			OutFrame.Timestamp = bson_iter_double(&iter);
+		}
+		else if (strcmp(key, "frame_idx") == 0)
+		{
+			OutFrame.FrameIdx = bson_iter_int32(&iter);
+		}
+		else if (strcmp(key, "ref_frame_idx") == 0)
+		{
+			OutFrame.RefFrameIdx = bson_iter_int32(&iter);
+		}
+		else if (strcmp(key, "shard") == 0)
+		{
+			DictId = FString(UTF8_TO_TCHAR(bson_iter_utf8(&iter, NULL)));
+		}
+		else if (strcmp(key, "compact") == 0)
+		{
+			bIsCompact = bson_iter_bool(&iter);
+		}
+		else if (strcmp(key, "res") == 0)
+		{
+			bson_iter_t res_iter;
+			if (bson_iter_recurse(&iter, &res_iter) && bson_iter_find(&res_iter, "x"))
+			{
+				OutFrame.Resolution.X = bson_iter_int32(&res_iter);
+				if (bson_iter_find(&res_iter, "y"))
+				{
+					OutFrame.Resolution.Y = bson_iter_int32(&res_iter);
+				}
+			}
+		}
+		else if (strcmp(key, "views") == 0 && BSON_ITER_HOLDS_ARRAY(&iter))
+		{
+			bHasViews = bson_iter_recurse(&iter, &views_iter);
+		}
+	}
+	if (!bHasViews)
+	{
+		return false;
+	}
+
+	// Dictionary of the shard which wrote the frame
+	const TArray<TPair<FString, FString>>* Dict = nullptr;
+	if (bIsCompact)
+	{
+		Dict = InOutDicts.Find(DictId);
+		if (!Dict)
+		{
+			TArray<TPair<FString, FString>>& NewDict = InOutDicts.Add(DictId);
+			LoadEntityDict(DictId, NewDict);
+			Dict = &NewDict;
+		}
+	}
+
+	while (bson_iter_next(&views_iter))
+	{
+		bson_iter_t view_iter;
+		if (!bson_iter_recurse(&views_iter, &view_iter))
+		{
+			continue;
+		}
+
+		FSLVisionViewData& ViewData = OutFrame.Views.AddDefaulted_GetRef();
+		bson_iter_t child;
+		if (bson_iter_find_descendant(&view_iter, "id", &child))
+		{
+			ViewData.Id = FString(UTF8_TO_TCHAR(bson_iter_utf8(&child, NULL)));
+		}
+		bson_iter_recurse(&views_iter, &view_iter);
+		if (bson_iter_find_descendant(&view_iter, "class", &child))
+		{
+			ViewData.Class = FString(UTF8_TO_TCHAR(bson_iter_utf8(&child, NULL)));
+		}
+
+		// Image types and sizes (the binaries are stored in gridfs)
+		bson_iter_recurse(&views_iter, &view_iter);
+		bson_iter_t imgs_iter;
+		if (bson_iter_find_descendant(&view_iter, "images", &child) && bson_iter_recurse(&child, &imgs_iter))
+		{
+			while (bson_iter_next(&imgs_iter))
+			{
+				bson_iter_t img_iter;
+				if (!bson_iter_recurse(&imgs_iter, &img_iter))
+				{
+					continue;
+				}
+
+				FSLVisionImageData& Img = ViewData.Images.AddDefaulted_GetRef();
+				while (bson_iter_next(&img_iter))
+				{
+					const char* img_key = bson_iter_key(&img_iter);
+					bson_iter_t img_child;
+					if (strcmp(img_key, "type") == 0)
+					{
+						Img.Type = FString(UTF8_TO_TCHAR(bson_iter_utf8(&img_iter, NULL)));
+					}
+					else if (strcmp(img_key, "res") == 0 && bson_iter_recurse(&img_iter, &img_child))
+					{
+						while (bson_iter_next(&img_child))
+						{
+							(strcmp(bson_iter_key(&img_child), "x") == 0 ? Img.Size.X : Img.Size.Y) = bson_iter_int32(&img_child);
+						}
+					}
+					else if (strcmp(img_key, "roi") == 0 && bson_iter_recurse(&img_iter, &img_child))
+					{
+						while (bson_iter_next(&img_child))
+						{
+							const char* roi_key = bson_iter_key(&img_child);
+							int32& Value = strcmp(roi_key, "min_x") == 0 ? Img.Region.Min.X :
+								strcmp(roi_key, "min_y") == 0 ? Img.Region.Min.Y :
+								strcmp(roi_key, "max_x") == 0 ? Img.Region.Max.X : Img.Region.Max.Y;
+							Value = bson_iter_int32(&img_child);
+						}
+					}
+				}
+			}
+		}
+
+		bson_iter_recurse(&views_iter, &view_iter);
+		if (bIsCompact)
+		{
+			GetCompactEntitiesData(&view_iter, *Dict, ViewData);
+		}
+		else
+		{
+			GetVerboseEntitiesData(&view_iter, ViewData);
+		}
+	}
+	return true;
+}
+
+// Decode the packed entities of the view
+void FSLVisionDBHandler::GetCompactEntitiesData(bson_iter_t* view_iter, const TArray<TPair<FString, FString>>& Dict,
+	FSLVisionViewData& OutViewData) const
+{
+	TArray<FSLVisionPackedEntityData> Entities;
+	TArray<FSLVisionPackedEntityData> SkelEntities;
+	TArray<FSLVisionPackedEntityData> Bones;
+	while (bson_iter_next(view_iter))
+	{
+		if (!BSON_ITER_HOLDS_BINARY(view_iter))
+		{
+			continue;
+		}
+
+		const char* key = bson_iter_key(view_iter);
+		TArray<FSLVisionPackedEntityData>* OutPacked = strcmp(key, "ents") == 0 ? &Entities :
+			strcmp(key, "skel") == 0 ? &SkelEntities :
+			strcmp(key, "bones") == 0 ? &Bones : nullptr;
+		if (OutPacked)
+		{
+			bson_subtype_t subtype;
+			uint32_t len;
+			const uint8_t* data;
+			bson_iter_binary(view_iter, &subtype, &len, &data);
+			const int32 Num = len / sizeof(FSLVisionPackedEntityData);
+			OutPacked->SetNumUninitialized(Num);
+			FMemory::Memcpy(OutPacked->GetData(), data, Num * sizeof(FSLVisionPackedEntityData));
+		}
+	}
+
+	auto UnpackBB = [](const FSLVisionPackedEntityData& Data, FIntPoint& OutMinBB, FIntPoint& OutMaxBB)
+	{
+		OutMinBB = FIntPoint(Data.MinX, Data.MinY);
+		OutMaxBB = FIntPoint(Data.MaxX, Data.MaxY);
+	};
+
+	for (const auto& Data : Entities)
+	{
+		if (Dict.IsValidIndex(Data.DictIdx))
+		{
+			FSLVisionViewEntityData& Entity = OutViewData.Entities.Emplace_GetRef(Dict[Data.DictIdx].Key, Dict[Data.DictIdx].Value);
+			UnpackBB(Data, Entity.MinBB, Entity.MaxBB);
+			Entity.ImagePercentage = Data.ImagePercentage;
+			Entity.OcclusionPercentage = Data.OcclusionPercentage;
+			Entity.bIsClipped = Data.bIsClipped != 0;
+		}
+	}
+	for (const auto& Data : SkelEntities)
+	{
+		FSLVisionViewSkelData& SkelEntity = Dict.IsValidIndex(Data.DictIdx) ?
+			OutViewData.SkelEntities.Emplace_GetRef(Dict[Data.DictIdx].Key, Dict[Data.DictIdx].Value) :
+			OutViewData.SkelEntities.AddDefaulted_GetRef();
+		UnpackBB(Data, SkelEntity.MinBB, SkelEntity.MaxBB);
+		SkelEntity.ImagePercentage = Data.ImagePercentage;
+		SkelEntity.OcclusionPercentage = Data.OcclusionPercentage;
+		SkelEntity.bIsClipped = Data.bIsClipped != 0;
+	}
+	for (const auto& Data : Bones)
+	{
+		if (Dict.IsValidIndex(Data.DictIdx) && OutViewData.SkelEntities.IsValidIndex(Data.ParentIdx))
+		{
+			FSLVisionViewSkelBoneData& Bone = OutViewData.SkelEntities[Data.ParentIdx].Bones.Emplace_GetRef(Dict[Data.DictIdx].Value);
+			UnpackBB(Data, Bone.MinBB, Bone.MaxBB);
+			Bone.ImagePercentage = Data.ImagePercentage;
+			Bone.OcclusionPercentage = Data.OcclusionPercentage;
+			Bone.bIsClipped = Data.bIsClipped != 0;
+		}
+	}
+}
+
+// Decode the verbose entities of the view
+void FSLVisionDBHandler::GetVerboseEntitiesData(bson_iter_t* view_iter, FSLVisionViewData& OutViewData) const
+{
+	// Read the common values of the entity, skeletal entity or bone sub document
+	auto GetEntityValues = [this](bson_iter_t* doc_iter, FString& OutId, FString& OutClass, float& OutImgPerc,
+		float& OutOcclPerc, bool& bOutIsClipped, FIntPoint& OutMinBB, FIntPoint& OutMaxBB, bson_iter_t* OutBonesIter)
+	{
+		bool bHasBones = false;
+		while (bson_iter_next(doc_iter))
+		{
+			const char* key = bson_iter_key(doc_iter);
+			if (strcmp(key, "id") == 0) { OutId = FString(UTF8_TO_TCHAR(bson_iter_utf8(doc_iter, NULL))); }
+			else if (strcmp(key, "class") == 0) { OutClass = FString(UTF8_TO_TCHAR(bson_iter_utf8(doc_iter, NULL))); }
+			else if (strcmp(key, "img_perc") == 0) { OutImgPerc = bson_iter_double(doc_iter); }
+			else if (strcmp(key, "occl_perc") == 0) { OutOcclPerc = bson_iter_double(doc_iter); }
+			else if (strcmp(key, "clipped") == 0) { bOutIsClipped = bson_iter_bool(doc_iter); }
+			else if (strcmp(key, "img_bb") == 0) { GetBBObj(doc_iter, OutMinBB, OutMaxBB); }
+			else if (OutBonesIter && strcmp(key, "bones") == 0) { bHasBones = bson_iter_recurse(doc_iter, OutBonesIter); }
+		}
+		return bHasBones;
+	};
+
+	while (bson_iter_next(view_iter))
+	{
+		const char* key = bson_iter_key(view_iter);
+		const bool bIsSkel = strcmp(key, "skel_entities") == 0;
+		bson_iter_t arr_iter;
+		if ((!bIsSkel && strcmp(key, "entities") != 0) || !bson_iter_recurse(view_iter, &arr_iter))
+		{
+			continue;
+		}
+
+		while (bson_iter_next(&arr_iter))
+		{
+			bson_iter_t doc_iter;
+			if (!bson_iter_recurse(&arr_iter, &doc_iter))
+			{
+				continue;
+			}
+
+			if (!bIsSkel)
+			{
+				FSLVisionViewEntityData& Entity = OutViewData.Entities.AddDefaulted_GetRef();
+				GetEntityValues(&doc_iter, Entity.Id, Entity.Class, Entity.ImagePercentage,
+					Entity.OcclusionPercentage, Entity.bIsClipped, Entity.MinBB, Entity.MaxBB, nullptr);
+				continue;
+			}
+
+			FSLVisionViewSkelData& SkelEntity = OutViewData.SkelEntities.AddDefaulted_GetRef();
+			bson_iter_t bones_iter;
+			if (GetEntityValues(&doc_iter, SkelEntity.Id, SkelEntity.Class, SkelEntity.ImagePercentage,
+				SkelEntity.OcclusionPercentage, SkelEntity.bIsClipped, SkelEntity.MinBB, SkelEntity.MaxBB, &bones_iter))
+			{
+				while (bson_iter_next(&bones_iter))
+				{
+					bson_iter_t bone_iter;
+					if (bson_iter_recurse(&bones_iter, &bone_iter))
+					{
+						FString UnusedId;
+						FSLVisionViewSkelBoneData& Bone = SkelEntity.Bones.AddDefaulted_GetRef();
+						GetEntityValues(&bone_iter, UnusedId, Bone.Class, Bone.ImagePercentage,
+							Bone.OcclusionPercentage, Bone.bIsClipped, Bone.MinBB, Bone.MaxBB, nullptr);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Get the bounding box from the document
+void FSLVisionDBHandler::GetBBObj(bson_iter_t* iter, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+	bson_iter_t child;
+	bson_iter_t bb_iter;
+	if (bson_iter_recurse(iter, &bb_iter) && bson_iter_find_descendant(&bb_iter, "min.x", &child))
+	{
+		OutMin.X = bson_iter_int32(&child);
+	}
+	if (bson_iter_recurse(iter, &bb_iter) && bson_iter_find_descendant(&bb_iter, "min.y", &child))
+	{
+		OutMin.Y = bson_iter_int32(&child);
+	}
+	if (bson_iter_recurse(iter, &bb_iter) && bson_iter_find_descendant(&bb_iter, "max.x", &child))
+	{
+		OutMax.X = bson_iter_int32(&child);
+	}
+	if (bson_iter_recurse(iter, &bb_iter) && bson_iter_find_descendant(&bb_iter, "max.y", &child))
+	{
+		OutMax.Y = bson_iter_int32(&child);
+	}
+}
+
+// Add the image size and region to the document if they differ from the frame resolution
+void FSLVisionDBHandler::AddImageSizeObj(const FSLVisionImageData& Img, bson_t* doc) const
+{
+	if (Img.Size != FIntPoint::ZeroValue)
+	{
+		bson_t res_sub_doc;
+		BSON_APPEND_DOCUMENT_BEGIN(doc, "res", &res_sub_doc);
+		BSON_APPEND_INT32(&res_sub_doc, "x", Img.Size.X);
+		BSON_APPEND_INT32(&res_sub_doc, "y", Img.Size.Y);
+		bson_append_document_end(doc, &res_sub_doc);
+	}
+	if (Img.Region.Area() > 0)
+	{
+		bson_t roi_sub_doc;
+		BSON_APPEND_DOCUMENT_BEGIN(doc, "roi", &roi_sub_doc);
+		BSON_APPEND_INT32(&roi_sub_doc, "min_x", Img.Region.Min.X);
+		BSON_APPEND_INT32(&roi_sub_doc, "min_y", Img.Region.Min.Y);
+		BSON_APPEND_INT32(&roi_sub_doc, "max_x", Img.Region.Max.X);
+		BSON_APPEND_INT32(&roi_sub_doc, "max_y", Img.Region.Max.Y);
+		bson_append_document_end(doc, &roi_sub_doc);
+	}
+}
+
 // Add image bounding box to document
 void FSLVisionDBHandler::AddBBObj(const FIntPoint& Min, const FIntPoint& Max, bson_t* doc) const
 {
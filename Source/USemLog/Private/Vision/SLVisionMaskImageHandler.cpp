@@ -2,6 +2,18 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Vision/SLVisionMaskImageHandler.h"
+#include "Individuals/SLIndividualManager.h"
+#include "Individuals/Type/SLSkeletalIndividual.h"
+#include "Individuals/Type/SLBoneIndividual.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Mask color cache file header values
+static const uint32 MaskCacheMagic = 0x434D4C53; // "SLMC"
+static const uint32 MaskCacheVersion = 1;
 
 
 // Ctor
@@ -10,51 +22,20 @@ FSLVisionMaskImageHandler::FSLVisionMaskImageHandler()
 	bIsInit = false;
 }
 
-// Load the color to entities mapping
-bool FSLVisionMaskImageHandler::Init()
+// Load the color to entities mapping, reuse the mapping cached in the file if its checksum is valid (rebuilt from the individuals and saved otherwise)
+bool FSLVisionMaskImageHandler::Init(ASLIndividualManager* IndividualManager, const FString& CacheFilePath)
 {
 	if(!bIsInit)
 	{
-		//// Setup NON-skeletal entity mapping
-		//for (const auto& Pair : FSLEntitiesManager::GetInstance()->GetObjectsSemanticData())
-		//{
-		//	if (Pair.Value.HasVisualMask() && Pair.Value.HasRenderedVisualMask())
-		//	{
-		//		const FColor RenderedMaskColor = FColor::FromHex(Pair.Value.RenderedVisualMask);
-		//		RenderedColorToEntityInfo.Emplace(RenderedMaskColor, 
-		//			FSLVisionMaskEntityInfo(Pair.Value.Class, Pair.Value.Id, Pair.Value.VisualMask));
-		//	}
-		//	else
-		//	{
-		//		if (AStaticMeshActor* SMA = Cast<AStaticMeshActor>(Pair.Key))
-		//		{
-		//			UE_LOG(LogTemp, Warning, TEXT("%s::%d %s has no visual or rendered (calibrated) visual mask.."),
-		//				*FString(__func__), __LINE__, *SMA->GetName());
-		//		}
-		//	}
-		//}
+		if (CacheFilePath.IsEmpty() || !LoadColorMappings(CacheFilePath))
+		{
+			BuildColorMappings(IndividualManager);
 
-		//// Setup skeletal entity mapping
-		//for (const auto& Pair : FSLEntitiesManager::GetInstance()->GetObjectsSkeletalSemanticData())
-		//{
-		//	const FString SkelClass = Pair.Value->OwnerSemanticData.Class;
-		//	const FString SkelId = Pair.Value->OwnerSemanticData.Id;
-
-		//	for (const auto& BonePair : Pair.Value->SemanticBonesData)
-		//	{
-		//		if (BonePair.Value.HasVisualMask() && BonePair.Value.HasCalibratedVisualMask())
-		//		{
-		//			const FColor RenderedMaskColor = FColor::FromHex(BonePair.Value.CalibratedVisualMask);
-		//			RenderedColorToSkelInfo.Emplace(RenderedMaskColor, 
-		//				FSLVisionMaskSkelInfo(SkelClass, SkelId, BonePair.Value.Class, BonePair.Value.VisualMask));
-		//		}
-		//		else
-		//		{
-		//			UE_LOG(LogTemp, Warning, TEXT("%s::%d %s - %s has no visual or rendered (calibrated) visual mask.."),
-		//				*FString(__func__), __LINE__, *Pair.Key->GetName(), *BonePair.Key.ToString());
-		//		}
-		//	}
-		//}
+			if (!CacheFilePath.IsEmpty() && (RenderedColorToEntityInfo.Num() > 0 || RenderedColorToSkelInfo.Num() > 0))
+			{
+				SaveColorMappings(CacheFilePath);
+			}
+		}
 
 		if (RenderedColorToEntityInfo.Num() == 0 && RenderedColorToSkelInfo.Num() == 0)
 		{
@@ -76,6 +57,8 @@ bool FSLVisionMaskImageHandler::Init()
 		//		*FColor::FromHex(Pair.Value.OrigMaskColor).ToString());
 		//}
 
+		BuildColorLUT();
+
 		bIsInit = true;
 		return true;
 	}
@@ -88,160 +71,151 @@ void FSLVisionMaskImageHandler::Reset()
 	bIsInit = false;
 	RenderedColorToEntityInfo.Empty();
 	RenderedColorToSkelInfo.Empty();
+	ColorLUT.Empty();
+	LUTNextInBucket.Empty();
+	LUTRenderedColors.Empty();
+	LUTOriginalColors.Empty();
+	LUTEntityInfos.Empty();
+	LUTSkelInfos.Empty();
 }
 
 // Restore image (the screenshot image pixel colors are a bit offseted from the supposed mask value) and get the entities from mask image
 void FSLVisionMaskImageHandler::GetDataAndRestoreImage(TArray<FColor>& MaskBitmapToRestore, int32 ImgWidth, int32 ImgHeight,
 	FSLVisionViewData& OutViewData) const
 {
+	if (!bIsInit || ImgWidth <= 0 || ImgHeight <= 0 || MaskBitmapToRestore.Num() < ImgWidth * ImgHeight)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Handler not init or image size mismatch.."), *FString(__func__), __LINE__);
+		return;
+	}
+
 	// Used to calculate the percentage of an entity in the image
 	const int64 ImgTotalPixels = ImgWidth * ImgHeight;
 
-	// Index position of the image matrix in rows and columns (used for storing the bounding box of the entities)
-	int32 RowIdx = 0;
-	int32 ColIdx = 0;
+	// Number of colors in the lookup table, every chunk keeps its own partial data of all the colors
+	const int32 NumColors = LUTRenderedColors.Num();
 
-	// Store the occurance of every color in the image to its data
-	TMap<FColor, FSLVisionImageColorInfo> TempRenderedColorsData;
+	// Split the image into chunks of rows, each processed by a separate worker
+	const int32 NumChunks = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1, ImgHeight);
+	const int32 RowsPerChunk = FMath::DivideAndRoundUp(ImgHeight, NumChunks);
 
-	// Array of rendered colors without a semantic match (store in array to avoid smapping the logger everytime the color appears)
-	TSet<FColor> UnknownColors;
+	// Per chunk color data (indexed by the lookup table color index) and rendered colors without a semantic match
+	TArray<TArray<FSLVisionImageColorInfo>> ChunksColorsData;
+	ChunksColorsData.SetNum(NumChunks);
+	TArray<TSet<FColor>> ChunksUnknownColors;
+	ChunksUnknownColors.SetNum(NumChunks);
 
-	// Restore image colors and create a mapping of all the rendered pixel colors to its data
-	for (auto& PixelColor : MaskBitmapToRestore)
+	// Restore image colors and collect the data of all the rendered pixel colors
+	FColor* Pixels = MaskBitmapToRestore.GetData();
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
 	{
-		// Ignore color black (represents semantically unknown areas, normally there should not be any
-		if (PixelColor != FColor::Black)
+		TArray<FSLVisionImageColorInfo>& ColorsData = ChunksColorsData[ChunkIdx];
+		ColorsData.Init(FSLVisionImageColorInfo(0, FIntPoint(ImgWidth, ImgHeight), FIntPoint(0, 0)), NumColors);
+		TSet<FColor>& UnknownColors = ChunksUnknownColors[ChunkIdx];
+
+		const int32 FirstRow = ChunkIdx * RowsPerChunk;
+		const int32 LastRow = FMath::Min(FirstRow + RowsPerChunk, ImgHeight);
+		for (int32 RowIdx = FirstRow; RowIdx < LastRow; ++RowIdx)
 		{
-			// Check if the color is new
-			if (FSLVisionImageColorInfo* ColorData = TempRenderedColorsData.Find(PixelColor))
+			FColor* RowPixels = Pixels + RowIdx * ImgWidth;
+			for (int32 ColIdx = 0; ColIdx < ImgWidth; ++ColIdx)
 			{
-				// Color already stored, update its data
-				(*ColorData).Num++;
+				FColor& PixelColor = RowPixels[ColIdx];
 
-				// Update the bounding box in the image
-				if (RowIdx < (*ColorData).MinBB.Y)
-				{
-					(*ColorData).MinBB.Y = RowIdx;
-				}
-				if (RowIdx > (*ColorData).MaxBB.Y)
-				{
-					(*ColorData).MaxBB.Y = RowIdx;
-				}
-				if (ColIdx < (*ColorData).MinBB.X)
-				{
-					(*ColorData).MinBB.X = ColIdx;
-				}
-				if (ColIdx > (*ColorData).MaxBB.X)
+				// Ignore color black (represents semantically unknown areas, normally there should not be any
+				if (PixelColor == FColor::Black)
 				{
-					(*ColorData).MaxBB.X = ColIdx;
+					continue;
 				}
 
-				// Fix image by changing the rendered color to the original value
-				PixelColor = (*ColorData).OriginalMaskColor;
-			}
-			else
-			{
-				// Cache rendered color, since the pixel color will be restored to the original mask (if found)
-				const FColor RenderedColor = PixelColor;
-
-				// New color, cache its info
-				FSLVisionImageColorInfo ColorInfo(1, FIntPoint(ImgWidth, ImgHeight), FIntPoint(0, 0));
-
-				// Get the original mask color value
-				if (const FSLVisionMaskEntityInfo* EntityInfo = RenderedColorToEntityInfo.Find(RenderedColor))
-				{
-					// Color found as an entity visual mask
-					ColorInfo.OriginalMaskColor = FColor::FromHex((*EntityInfo).OrigMaskColor);
-
-					// Cache the color info in the local map
-					TempRenderedColorsData.Emplace(RenderedColor, ColorInfo);
-
-					// Fix image by changing the rendered color to the original value
-					PixelColor = ColorInfo.OriginalMaskColor;
-				}
-				else if (const FSLVisionMaskSkelInfo* SkelInfo = RenderedColorToSkelInfo.Find(RenderedColor))
+				const int32 ColorIdx = FindColorLUTIndex(PixelColor);
+				if (ColorIdx != INDEX_NONE)
 				{
-					// Color found as a skeletal visual mask
-					ColorInfo.OriginalMaskColor = FColor::FromHex((*SkelInfo).OrigMaskColor);
+					FSLVisionImageColorInfo& ColorData = ColorsData[ColorIdx];
+					ColorData.Num++;
 
-					// Cache the color info in the local map
-					TempRenderedColorsData.Emplace(RenderedColor, ColorInfo);
+					// Update the bounding box in the image
+					ColorData.MinBB.X = FMath::Min(ColorData.MinBB.X, ColIdx);
+					ColorData.MinBB.Y = FMath::Min(ColorData.MinBB.Y, RowIdx);
+					ColorData.MaxBB.X = FMath::Max(ColorData.MaxBB.X, ColIdx);
+					ColorData.MaxBB.Y = FMath::Max(ColorData.MaxBB.Y, RowIdx);
 
 					// Fix image by changing the rendered color to the original value
-					PixelColor = ColorInfo.OriginalMaskColor;
+					PixelColor = LUTOriginalColors[ColorIdx];
 				}
-				else if(!UnknownColors.Contains(PixelColor))
+				else
 				{
 					UnknownColors.Add(PixelColor);
-					UE_LOG(LogTemp, Error, TEXT("%s::%d Rendered color %s - %s has no mapping to any entity.. this should not happen.."),
-						*FString(__func__), __LINE__, *RenderedColor.ToString(), *RenderedColor.ToHex());
 				}
 			}
 		}
+	});
 
-		// Update current pixel index position
-		ColIdx++;
-
-		// Check for row change
-		if (ColIdx > ImgWidth - 1)
+	// Merge the chunks data into the first chunk
+	TArray<FSLVisionImageColorInfo>& ColorsData = ChunksColorsData[0];
+	TSet<FColor>& UnknownColors = ChunksUnknownColors[0];
+	for (int32 ChunkIdx = 1; ChunkIdx < NumChunks; ++ChunkIdx)
+	{
+		const TArray<FSLVisionImageColorInfo>& ChunkColorsData = ChunksColorsData[ChunkIdx];
+		for (int32 ColorIdx = 0; ColorIdx < NumColors; ++ColorIdx)
 		{
-			ColIdx = 0;
-			RowIdx++;
+			const FSLVisionImageColorInfo& ChunkColorData = ChunkColorsData[ColorIdx];
+			if (ChunkColorData.Num > 0)
+			{
+				FSLVisionImageColorInfo& ColorData = ColorsData[ColorIdx];
+				ColorData.Num += ChunkColorData.Num;
+				ColorData.MinBB = ColorData.MinBB.ComponentMin(ChunkColorData.MinBB);
+				ColorData.MaxBB = ColorData.MaxBB.ComponentMax(ChunkColorData.MaxBB);
+			}
 		}
+		UnknownColors.Append(ChunksUnknownColors[ChunkIdx]);
+	}
+
+	// Log the rendered colors without a semantic match only once
+	for (const auto& RenderedColor : UnknownColors)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Rendered color %s - %s has no mapping to any entity.. this should not happen.."),
+			*FString(__func__), __LINE__, *RenderedColor.ToString(), *RenderedColor.ToHex());
 	}
 
 	// Store skeletal related data in a temp map, this will need an extra processing to calculcate the data as a whole skeleton (from bones)
 	TMap<FString, FSLVisionViewSkelData> TempIdToSkelData;
 
 	// Iterate the collected data from the image
-	for (const auto& Pair : TempRenderedColorsData)
+	const int32 NumEntityColors = LUTEntityInfos.Num();
+	for (int32 ColorIdx = 0; ColorIdx < NumColors; ++ColorIdx)
 	{
-		const FColor RenderedColor = Pair.Key;
-		
-		// Check semantically annotated entity that belongs to the mask color
-		if (const FSLVisionMaskEntityInfo* EntityInfo = RenderedColorToEntityInfo.Find(RenderedColor))
+		const FSLVisionImageColorInfo& ColorData = ColorsData[ColorIdx];
+		if (ColorData.Num == 0)
 		{
-			FSLVisionViewEntityData EntityData(EntityInfo->Id, EntityInfo->Class, Pair.Value.MinBB, Pair.Value.MaxBB);
-			EntityData.ImagePercentage = (float) Pair.Value.Num / ImgTotalPixels;
-			OutViewData.Entities.Emplace(EntityData);
+			continue;
+		}
 
-			//// DEBUG
-			//UE_LOG(LogTemp, Warning, TEXT("%s::%d Color: [%s] -> %s : %s -> %d -> %f"),
-			//	*FString(__func__), __LINE__,
-			//	*RenderedColor.ToString(),
-			//	*EntityData.Class,
-			//	*EntityData.Id,
-			//	Pair.Value.Num,
-			//	EntityData.ImagePercentage);
+		if (ColorIdx < NumEntityColors)
+		{
+			const FSLVisionMaskEntityInfo& EntityInfo = LUTEntityInfos[ColorIdx];
+			FSLVisionViewEntityData EntityData(EntityInfo.Id, EntityInfo.Class, ColorData.MinBB, ColorData.MaxBB);
+			EntityData.ImagePercentage = (float) ColorData.Num / ImgTotalPixels;
+			OutViewData.Entities.Emplace(EntityData);
 		}
-		else if(const FSLVisionMaskSkelInfo* SkelInfo = RenderedColorToSkelInfo.Find(RenderedColor))
+		else
 		{
 			// Collect bone data
-			FSLVisionViewSkelBoneData BoneData(SkelInfo->BoneClass, Pair.Value.MinBB, Pair.Value.MaxBB);
-			BoneData.ImagePercentage = (float) Pair.Value.Num / ImgTotalPixels;
+			const FSLVisionMaskSkelInfo& SkelInfo = LUTSkelInfos[ColorIdx - NumEntityColors];
+			FSLVisionViewSkelBoneData BoneData(SkelInfo.BoneClass, ColorData.MinBB, ColorData.MaxBB);
+			BoneData.ImagePercentage = (float) ColorData.Num / ImgTotalPixels;
 
 			// Update existing or create a new skeletal data
-			if(FSLVisionViewSkelData* SkelData = TempIdToSkelData.Find(SkelInfo->Id))
+			if(FSLVisionViewSkelData* SkelData = TempIdToSkelData.Find(SkelInfo.Id))
 			{
 				SkelData->Bones.Emplace(BoneData);
 			}
 			else
 			{
-				FSLVisionViewSkelData NewSkelData(SkelInfo->Id, SkelInfo->Class);
+				FSLVisionViewSkelData NewSkelData(SkelInfo.Id, SkelInfo.Class);
 				NewSkelData.Bones.Emplace(BoneData);
-				TempIdToSkelData.Emplace(SkelInfo->Id, NewSkelData);
+				TempIdToSkelData.Emplace(SkelInfo.Id, NewSkelData);
 			}
-
-			// DEBUG
-			//UE_LOG(LogTemp, Warning, TEXT("%s::%d Color: %s -> %s : %s : %s -> %d"),
-			//	*FString(__func__), __LINE__, *Pair.Key.ToString(),
-			//	*SkelInfo->Class, *SkelInfo->Id, *SkelInfo->BoneClass, Pair.Value.Num);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Error, TEXT("%s::%d Rendered color %s - %s has no mapping to any entity.. this should not happen.."),
-				*FString(__func__), __LINE__, *RenderedColor.ToString(), *RenderedColor.ToHex());
 		}
 	}
 
@@ -254,6 +228,203 @@ void FSLVisionMaskImageHandler::GetDataAndRestoreImage(TArray<FColor>& MaskBitma
 	}
 }
 
+// Build the rendered (calibrated) color to individual and bone mappings from the visible individuals
+void FSLVisionMaskImageHandler::BuildColorMappings(ASLIndividualManager* IndividualManager)
+{
+	if (!IndividualManager || (!IndividualManager->IsLoaded() && !IndividualManager->Load(false)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Individual manager is not available or could not be loaded.."), *FString(__func__), __LINE__);
+		return;
+	}
+
+	// Setup NON-skeletal individuals mapping (the skeletal individuals are masked through their bones)
+	for (const auto& Individual : IndividualManager->GetIndividuals())
+	{
+		USLVisibleIndividual* VI = Cast<USLVisibleIndividual>(Individual);
+		if (!VI || VI->IsA(USLSkeletalIndividual::StaticClass()) || VI->IsA(USLBoneIndividual::StaticClass()))
+		{
+			continue;
+		}
+
+		if (VI->IsVisualMaskValueSet() && VI->IsCalibratedVisualMaskValueSet())
+		{
+			const FColor RenderedMaskColor = FColor::FromHex(VI->GetCalibratedVisualMaskValue());
+			RenderedColorToEntityInfo.Emplace(RenderedMaskColor,
+				FSLVisionMaskEntityInfo(VI->GetClassValue(), VI->GetIdValue(), VI->GetVisualMaskValue()));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d %s has no visual or rendered (calibrated) visual mask.."),
+				*FString(__func__), __LINE__, *VI->GetFullName());
+		}
+	}
+
+	// Setup skeletal individuals mapping
+	for (const auto& SkI : IndividualManager->GetSkeletalIndividuals())
+	{
+		for (const auto& BI : SkI->GetBoneIndividuals())
+		{
+			if (BI->IsVisualMaskValueSet() && BI->IsCalibratedVisualMaskValueSet())
+			{
+				const FColor RenderedMaskColor = FColor::FromHex(BI->GetCalibratedVisualMaskValue());
+				RenderedColorToSkelInfo.Emplace(RenderedMaskColor,
+					FSLVisionMaskSkelInfo(SkI->GetClassValue(), SkI->GetIdValue(), BI->GetClassValue(), BI->GetVisualMaskValue()));
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s::%d %s - %s has no visual or rendered (calibrated) visual mask.."),
+					*FString(__func__), __LINE__, *SkI->GetFullName(), *BI->GetClassValue());
+			}
+		}
+	}
+}
+
+// Load the rendered color mappings from the cache file, returns false if missing, outdated or corrupt
+bool FSLVisionMaskImageHandler::LoadColorMappings(const FString& CacheFilePath)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *CacheFilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	// Header: magic, version, payload crc
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 PayloadCrc = 0;
+	const int32 HeaderSize = 3 * sizeof(uint32);
+	if (FileData.Num() < HeaderSize)
+	{
+		return false;
+	}
+	FMemory::Memcpy(&Magic, FileData.GetData(), sizeof(uint32));
+	FMemory::Memcpy(&Version, FileData.GetData() + sizeof(uint32), sizeof(uint32));
+	FMemory::Memcpy(&PayloadCrc, FileData.GetData() + 2 * sizeof(uint32), sizeof(uint32));
+	if (Magic != MaskCacheMagic || Version != MaskCacheVersion ||
+		FCrc::MemCrc32(FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize) != PayloadCrc)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Mask color cache %s is outdated or corrupt, rebuilding.."),
+			*FString(__func__), __LINE__, *CacheFilePath);
+		return false;
+	}
+
+	FMemoryReader Ar(FileData);
+	Ar.Seek(HeaderSize);
+
+	int32 NumEntities = 0;
+	Ar << NumEntities;
+	for (int32 Idx = 0; Idx < NumEntities && !Ar.IsError(); ++Idx)
+	{
+		FColor RenderedColor;
+		FSLVisionMaskEntityInfo Info;
+		Ar << RenderedColor << Info.Class << Info.Id << Info.OrigMaskColor;
+		RenderedColorToEntityInfo.Emplace(RenderedColor, Info);
+	}
+
+	int32 NumSkelBones = 0;
+	Ar << NumSkelBones;
+	for (int32 Idx = 0; Idx < NumSkelBones && !Ar.IsError(); ++Idx)
+	{
+		FColor RenderedColor;
+		FSLVisionMaskSkelInfo Info;
+		Ar << RenderedColor << Info.Class << Info.Id << Info.BoneClass << Info.OrigMaskColor;
+		RenderedColorToSkelInfo.Emplace(RenderedColor, Info);
+	}
+
+	if (Ar.IsError())
+	{
+		RenderedColorToEntityInfo.Empty();
+		RenderedColorToSkelInfo.Empty();
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%s::%d Loaded %ld entity and %ld bone mask colors from %s.."),
+		*FString(__func__), __LINE__, RenderedColorToEntityInfo.Num(), RenderedColorToSkelInfo.Num(), *CacheFilePath);
+	return true;
+}
+
+// Save the rendered color mappings to the cache file
+bool FSLVisionMaskImageHandler::SaveColorMappings(const FString& CacheFilePath) const
+{
+	// Header is written after the payload checksum is known
+	const int32 HeaderSize = 3 * sizeof(uint32);
+	TArray<uint8> FileData;
+	FileData.AddZeroed(HeaderSize);
+
+	FMemoryWriter Ar(FileData);
+	Ar.Seek(HeaderSize);
+
+	int32 NumEntities = RenderedColorToEntityInfo.Num();
+	Ar << NumEntities;
+	for (const auto& Pair : RenderedColorToEntityInfo)
+	{
+		FColor RenderedColor = Pair.Key;
+		FSLVisionMaskEntityInfo Info = Pair.Value;
+		Ar << RenderedColor << Info.Class << Info.Id << Info.OrigMaskColor;
+	}
+
+	int32 NumSkelBones = RenderedColorToSkelInfo.Num();
+	Ar << NumSkelBones;
+	for (const auto& Pair : RenderedColorToSkelInfo)
+	{
+		FColor RenderedColor = Pair.Key;
+		FSLVisionMaskSkelInfo Info = Pair.Value;
+		Ar << RenderedColor << Info.Class << Info.Id << Info.BoneClass << Info.OrigMaskColor;
+	}
+
+	const uint32 Magic = MaskCacheMagic;
+	const uint32 Version = MaskCacheVersion;
+	const uint32 PayloadCrc = FCrc::MemCrc32(FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize);
+	FMemory::Memcpy(FileData.GetData(), &Magic, sizeof(uint32));
+	FMemory::Memcpy(FileData.GetData() + sizeof(uint32), &Version, sizeof(uint32));
+	FMemory::Memcpy(FileData.GetData() + 2 * sizeof(uint32), &PayloadCrc, sizeof(uint32));
+
+	if (!FFileHelper::SaveArrayToFile(FileData, *CacheFilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Could not save the mask color cache %s.."),
+			*FString(__func__), __LINE__, *CacheFilePath);
+		return false;
+	}
+	return true;
+}
+
+// Build the flat color lookup table from the rendered color mappings
+void FSLVisionMaskImageHandler::BuildColorLUT()
+{
+	ColorLUT.Init(INDEX_NONE, ColorLUTSize);
+	LUTNextInBucket.Reset(RenderedColorToEntityInfo.Num() + RenderedColorToSkelInfo.Num());
+	LUTRenderedColors.Reset(RenderedColorToEntityInfo.Num() + RenderedColorToSkelInfo.Num());
+	LUTOriginalColors.Reset(RenderedColorToEntityInfo.Num() + RenderedColorToSkelInfo.Num());
+	LUTEntityInfos.Reset(RenderedColorToEntityInfo.Num());
+	LUTSkelInfos.Reset(RenderedColorToSkelInfo.Num());
+
+	// Prepend the color to its quantized key bucket
+	auto AddColor = [this](const FColor& RenderedColor, const FString& OrigMaskColorHex)
+	{
+		const int32 Key = GetQuantizedColorKey(RenderedColor);
+		LUTNextInBucket.Add(ColorLUT[Key]);
+		ColorLUT[Key] = LUTRenderedColors.Add(RenderedColor);
+		LUTOriginalColors.Add(FColor::FromHex(OrigMaskColorHex));
+	};
+
+	// Entities first, their indexes are followed by the skeletal ones
+	for (const auto& Pair : RenderedColorToEntityInfo)
+	{
+		AddColor(Pair.Key, Pair.Value.OrigMaskColor);
+		LUTEntityInfos.Add(Pair.Value);
+	}
+	for (const auto& Pair : RenderedColorToSkelInfo)
+	{
+		// Entity mapping has priority if the same color is used by both
+		if (RenderedColorToEntityInfo.Contains(Pair.Key))
+		{
+			continue;
+		}
+		AddColor(Pair.Key, Pair.Value.OrigMaskColor);
+		LUTSkelInfos.Add(Pair.Value);
+	}
+}
+
 // Restore the color of the pixel to its original mask value (offseted by screenshot rendering artifacts), returns true if restoration happened
 bool FSLVisionMaskImageHandler::RestoreColorValueFromArray(FColor& RenderedPixelColor, const TArray<FColor>& InOriginalMaskColors, uint8 Tolerance) const
 {
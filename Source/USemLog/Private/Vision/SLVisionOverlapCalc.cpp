@@ -6,17 +6,24 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/PoseableMeshComponent.h"
 #include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "Rendering/SkeletalMeshLODRenderData.h"
+#include "Engine/LocalPlayer.h"
+#include "SceneView.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/GameViewportClient.h"
 #include "HighResScreenshot.h"
 #include "ImageUtils.h"
 #include "Async.h"
+#include "Async/ParallelFor.h"
 #include "FileHelper.h"
 
 #include "Vision/SLVisionStructs.h"
 //#include "Skeletal/SLSkeletalDataComponent.h"
 #include "SLVisionLogger.h"
+#include "Vision/SLVisionPoseableMeshActor.h"
 
 
 // Constructor
@@ -31,6 +38,10 @@ USLVisionOverlapCalc::USLVisionOverlapCalc() : bIsInit(false), bIsStarted(false)
 	CurrPMAClone = nullptr;
 	bSkelArrayActive = false;
 	bSkelBoneActive = false;
+	bAnalytic = false;
+	bCompare = false;
+	SumComparedDeltas = 0.f;
+	NumComparedItems = 0;
 }
 
 // Destructor
@@ -39,7 +50,7 @@ USLVisionOverlapCalc::~USLVisionOverlapCalc()
 }
 
 // Give control to the overlap calc to pause and start its parent (vision logger)
-void USLVisionOverlapCalc::Init(USLVisionLogger* InParent, FIntPoint InResolution, const FString& InSaveLocallyPath)
+void USLVisionOverlapCalc::Init(USLVisionLogger* InParent, FIntPoint InResolution, const FString& InSaveLocallyPath, bool bInAnalytic, bool bInCompare)
 {
 	if (!bIsInit)
 	{
@@ -48,6 +59,18 @@ void USLVisionOverlapCalc::Init(USLVisionLogger* InParent, FIntPoint InResolutio
 		ViewportClient = GetWorld()->GetGameViewport();
 		Resolution = InResolution;
 		SaveLocallyFolderName = InSaveLocallyPath;
+		bAnalytic = bInAnalytic;
+		bCompare = bInCompare;
+
+		// No extra renders are required (unless the analytic results are compared with the screenshot ones)
+		if (bAnalytic && !bCompare)
+		{
+			if (Parent && ViewportClient)
+			{
+				bIsInit = true;
+			}
+			return;
+		}
 
 		// Load the default mask material
 		// this will be used as a template to create the non-occluding mask materials to add to the clones
@@ -74,6 +97,18 @@ void USLVisionOverlapCalc::Start(FSLVisionViewData* CurrViewData, float Timestam
 {
 	if (!bIsStarted && bIsInit)
 	{
+		// Calculated right away, the parent does not need to be paused
+		if (bAnalytic || bCompare)
+		{
+			CalculateOverlapsAnalytic(CurrViewData);
+			if (!bCompare)
+			{
+				return;
+			}
+			// The screenshot overlaps of the same frame overwrite the analytic ones, which are kept for the comparison
+			StoreAnalyticOverlaps(CurrViewData);
+		}
+
 		CurrTs = Timestamp;
 		CurrFrameIdx = FrameIdx;
 		SubFolderName.Empty();
@@ -129,6 +164,15 @@ void USLVisionOverlapCalc::Finish()
 		CurrSMAClone = nullptr;
 		CurrPMAClone = nullptr;
 
+		if (bCompare && NumComparedItems > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d [%.2f] Analytic vs screenshot overlaps: Items=%d; MeanAbsOccPercDelta=%.2f%%;"),
+				*FString(__func__), __LINE__, CurrTs, NumComparedItems, SumComparedDeltas / NumComparedItems * 100.f);
+		}
+		AnalyticOcclusionPercentages.Empty();
+		SumComparedDeltas = 0.f;
+		NumComparedItems = 0;
+
 		// Switch callback functions, and re-start parent
 		ViewportClient->OnScreenshotCaptured().Remove(ScreenshotCallbackHandle);
 		Parent->Pause(false);
@@ -587,13 +631,16 @@ void USLVisionOverlapCalc::CalculateOverlap(const TArray<FColor>& NonOccludedIma
 	if (!bSkelArrayActive)
 	{
 		// Set percentage  (non occ image perc - occ image perc / non occ image perc)
-		const float ImgPercDiff = (NonOccImgPerc - (*Entities)[EntityIndex].ImagePercentage);
-		const float OccPerc = ImgPercDiff / NonOccImgPerc;
-		(*Entities)[EntityIndex].OcclusionPercentage = OccPerc < 0.01f ? 0.f : OccPerc;
+		(*Entities)[EntityIndex].OcclusionPercentage = GetOcclusionPercentage(NonOccImgPerc, (*Entities)[EntityIndex].ImagePercentage);
 
 		// Set flag showing if the entity is clipped (touches the edge of the image)
 		(*Entities)[EntityIndex].bIsClipped = bIsClipped;
 
+		if (bCompare)
+		{
+			CompareWithAnalyticOverlap((*Entities)[EntityIndex].Id, (*Entities)[EntityIndex].OcclusionPercentage);
+		}
+
 		//// DEBUG
 		//UE_LOG(LogTemp, Error, TEXT("%s::%d [%s-%s] \t\t ImgPerc=%.8f; NonOccImgPerc=%.8f; OccPerc=%.8f; bIsClipped=%d;"),
 		//	*FString(__func__), __LINE__, *(*Entities)[EntityIndex].Class, *(*Entities)[EntityIndex].Id,
@@ -605,13 +652,16 @@ void USLVisionOverlapCalc::CalculateOverlap(const TArray<FColor>& NonOccludedIma
 		if (!bSkelBoneActive)
 		{
 			// Set percentage  (non occ image perc - occ image perc / non occ image perc)
-			const float ImgPercDiff = NonOccImgPerc - (*SkelEntities)[SkelIndex].ImagePercentage;
-			const float OccPerc = ImgPercDiff / NonOccImgPerc;
-			(*SkelEntities)[SkelIndex].OcclusionPercentage = OccPerc < 0.01f ? 0.f : OccPerc;
+			(*SkelEntities)[SkelIndex].OcclusionPercentage = GetOcclusionPercentage(NonOccImgPerc, (*SkelEntities)[SkelIndex].ImagePercentage);
 
 			// Set flag showing if the entity is clipped (touches the edge of the image)
 			(*SkelEntities)[SkelIndex].bIsClipped = bIsClipped;
 
+			if (bCompare)
+			{
+				CompareWithAnalyticOverlap((*SkelEntities)[SkelIndex].Id, (*SkelEntities)[SkelIndex].OcclusionPercentage);
+			}
+
 			//// DEBUG
 			//UE_LOG(LogTemp, Error, TEXT("%s::%d [%s-%s] \t\t ImgPerc=%.8f; NonOccImgPerc=%.8f; OccPerc=%.8f; bIsClipped=%d;"),
 			//	*FString(__func__), __LINE__, *(*SkelEntities)[SkelIndex].Class, *(*SkelEntities)[SkelIndex].Id,
@@ -621,13 +671,18 @@ void USLVisionOverlapCalc::CalculateOverlap(const TArray<FColor>& NonOccludedIma
 		else
 		{
 			// Set percentage  (non occ image perc - occ image perc / non occ image perc)
-			const float ImgPercDiff = NonOccImgPerc - (*SkelEntities)[SkelIndex].Bones[BoneIndex].ImagePercentage;
-			const float OccPerc = ImgPercDiff / NonOccImgPerc;
-			(*SkelEntities)[SkelIndex].Bones[BoneIndex].OcclusionPercentage = OccPerc < 0.01f ? 0.f : OccPerc;
+			(*SkelEntities)[SkelIndex].Bones[BoneIndex].OcclusionPercentage =
+				GetOcclusionPercentage(NonOccImgPerc, (*SkelEntities)[SkelIndex].Bones[BoneIndex].ImagePercentage);
 
 			// Set flag showing if the entity is clipped (touches the edge of the image)
 			(*SkelEntities)[SkelIndex].Bones[BoneIndex].bIsClipped = bIsClipped;
 
+			if (bCompare)
+			{
+				CompareWithAnalyticOverlap((*SkelEntities)[SkelIndex].Id + TEXT("/") + (*SkelEntities)[SkelIndex].Bones[BoneIndex].Class,
+					(*SkelEntities)[SkelIndex].Bones[BoneIndex].OcclusionPercentage);
+			}
+
 			//// DEBUG
 			//UE_LOG(LogTemp, Error, TEXT("%s::%d [%s-%s-%s] \t\t ImgPerc=%.8f; NonOccImgPerc=%.8f; OccPerc=%.8f; bIsClipped=%d;"),
 			//	*FString(__func__), __LINE__, *(*SkelEntities)[SkelIndex].Class, *(*SkelEntities)[SkelIndex].Id, *(*SkelEntities)[SkelIndex].Bones[BoneIndex].Class,
@@ -637,6 +692,379 @@ void USLVisionOverlapCalc::CalculateOverlap(const TArray<FColor>& NonOccludedIma
 	}	
 }
 
+/* Overlaps comparison */
+// Store the analytic overlaps of the view before they are overwritten by the screenshot ones
+void USLVisionOverlapCalc::StoreAnalyticOverlaps(const FSLVisionViewData* CurrViewData)
+{
+	AnalyticOcclusionPercentages.Empty();
+	SumComparedDeltas = 0.f;
+	NumComparedItems = 0;
+	for (const auto& Entity : CurrViewData->Entities)
+	{
+		AnalyticOcclusionPercentages.Add(Entity.Id, Entity.OcclusionPercentage);
+	}
+	for (const auto& SkelEntity : CurrViewData->SkelEntities)
+	{
+		AnalyticOcclusionPercentages.Add(SkelEntity.Id, SkelEntity.OcclusionPercentage);
+		for (const auto& Bone : SkelEntity.Bones)
+		{
+			AnalyticOcclusionPercentages.Add(SkelEntity.Id + TEXT("/") + Bone.Class, Bone.OcclusionPercentage);
+		}
+	}
+}
+
+// Log the difference between the screenshot and the analytic occlusion percentage of the item
+void USLVisionOverlapCalc::CompareWithAnalyticOverlap(const FString& ItemKey, float OcclusionPercentage)
+{
+	if (const float* AnalyticOcclusionPercentage = AnalyticOcclusionPercentages.Find(ItemKey))
+	{
+		const float Delta = *AnalyticOcclusionPercentage - OcclusionPercentage;
+		SumComparedDeltas += FMath::Abs(Delta);
+		NumComparedItems++;
+		UE_LOG(LogTemp, Log, TEXT("%s::%d [%.2f] %s \t Screenshot OccPerc=%.2f%%; Analytic OccPerc=%.2f%%; Delta=%.2f%%;"),
+			*FString(__func__), __LINE__, CurrTs, *ItemKey, OcclusionPercentage * 100.f, *AnalyticOcclusionPercentage * 100.f, Delta * 100.f);
+	}
+}
+
+/* Analytic overlaps */
+// Calculate the overlaps of all the items in the view from their rasterized silhouettes (no extra renders)
+void USLVisionOverlapCalc::CalculateOverlapsAnalytic(FSLVisionViewData* CurrViewData)
+{
+	FMatrix ViewProjectionMatrix;
+	if (!GetViewProjectionMatrix(ViewProjectionMatrix))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not get the camera view projection.."), *FString(__func__), __LINE__);
+		return;
+	}
+
+	// Gather the items on the game thread (mesh and component access, skinning)
+	RasterItems.Reset();
+	for (auto& Entity : CurrViewData->Entities)
+	{
+		AStaticMeshActor* SMAClone = Parent->GetStaticMeshMaskCloneFromId(Entity.Id);
+		UStaticMeshComponent* SMC = SMAClone ? SMAClone->GetStaticMeshComponent() : nullptr;
+		const FSLVisionMeshGeometry* Geometry = SMC ? GetStaticMeshGeometry(SMC->GetStaticMesh()) : nullptr;
+		if (!Geometry)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not find the mesh of entity %s - %s, continuing.."),
+				*FString(__func__), __LINE__, *Entity.Class, *Entity.Id);
+			continue;
+		}
+
+		FSLVisionRasterItem& Item = RasterItems.AddDefaulted_GetRef();
+		Item.Geometry = Geometry;
+		Item.LocalToClip = SMC->GetComponentTransform().ToMatrixWithScale() * ViewProjectionMatrix;
+		Item.Entity = &Entity;
+	}
+
+	// Sized upfront, the items point into it
+	SkelEntities = &CurrViewData->SkelEntities;
+	SkinnedGeometries.SetNum(SkelEntities->Num());
+	for (SkelIndex = 0; SkelIndex < SkelEntities->Num(); ++SkelIndex)
+	{
+		FSLVisionViewSkelData& SkelEntity = (*SkelEntities)[SkelIndex];
+		ASLVisionPoseableMeshActor* PMAClone = Parent->GetPoseableSkeletalMaskCloneFromId(SkelEntity.Id);
+		UPoseableMeshComponent* PMC = PMAClone ? PMAClone->GetPoseableMeshComponent() : nullptr;
+		const FSkeletalMeshLODRenderData* LODData = PMC ? GetSkinnedGeometry(PMC, SkinnedGeometries[SkelIndex]) : nullptr;
+		if (!LODData)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not find the mesh of skel entity %s - %s, continuing.."),
+				*FString(__func__), __LINE__, *SkelEntity.Class, *SkelEntity.Id);
+			continue;
+		}
+
+		FSLVisionRasterItem& Item = RasterItems.AddDefaulted_GetRef();
+		Item.Geometry = &SkinnedGeometries[SkelIndex];
+		Item.LocalToClip = PMC->GetComponentTransform().ToMatrixWithScale() * ViewProjectionMatrix;
+		Item.SkelEntity = &SkelEntity;
+		Item.LODData = LODData;
+
+		// Bones are rasterized from the render sections using their material
+		Item.BoneMaterialIndexes.Reserve(SkelEntity.Bones.Num());
+		for (BoneIndex = 0; BoneIndex < SkelEntity.Bones.Num(); ++BoneIndex)
+		{
+			Item.BoneMaterialIndexes.Add(GetMaterialIndexOfCurrentlySelectedBone());
+		}
+	}
+	SkelIndex = INDEX_NONE;
+	BoneIndex = INDEX_NONE;
+	SkelEntities = nullptr;
+
+	if (RasterItems.Num() == 0)
+	{
+		return;
+	}
+
+	// One buffer per task, the coverage buffers are only cleared when the resolution changes
+	const int32 NumTasks = FMath::Min(RasterItems.Num(), MaxNumRasterTasks);
+	const int32 NumPixels = Resolution.X * Resolution.Y;
+	if (RasterBuffers.Num() < NumTasks)
+	{
+		RasterBuffers.SetNum(NumTasks);
+	}
+	for (int32 TaskIdx = 0; TaskIdx < NumTasks; ++TaskIdx)
+	{
+		if (RasterBuffers[TaskIdx].CoverageStamps.Num() != NumPixels)
+		{
+			RasterBuffers[TaskIdx].CoverageStamps.Init(0, NumPixels);
+			RasterBuffers[TaskIdx].CurrCoverageStamp = 0;
+		}
+	}
+
+	// Every task picks the next unprocessed item (the skeletal meshes are usually more expensive)
+	FThreadSafeCounter NextItemIdx;
+	ParallelFor(NumTasks, [&](int32 TaskIdx)
+	{
+		int32 ItemIdx = NextItemIdx.Increment() - 1;
+		while (ItemIdx < RasterItems.Num())
+		{
+			RasterizeItem(RasterItems[ItemIdx], RasterBuffers[TaskIdx]);
+			ItemIdx = NextItemIdx.Increment() - 1;
+		}
+	});
+}
+
+// Get the view projection matrix of the scene view rendered by the viewport
+bool USLVisionOverlapCalc::GetViewProjectionMatrix(FMatrix& OutViewProjectionMatrix) const
+{
+	ULocalPlayer* LocalPlayer = GetWorld() ? GetWorld()->GetFirstLocalPlayerFromController() : nullptr;
+	if (!LocalPlayer || !ViewportClient || !ViewportClient->Viewport || Resolution.X <= 0 || Resolution.Y <= 0)
+	{
+		return false;
+	}
+
+	// Same view and projection (fov, aspect ratio constraints, clip planes) as the one the renderer uses for the viewport
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(ViewportClient->Viewport, eSSP_FULL, ProjectionData))
+	{
+		return false;
+	}
+
+	// The clip space is mapped to the overlap resolution, which should keep the aspect ratio of the view
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	if (ViewRect.Height() > 0 && !FMath::IsNearlyEqual((float)ViewRect.Width() / ViewRect.Height(),
+		(float)Resolution.X / Resolution.Y, 0.01f))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d The view aspect ratio (%dx%d) differs from the overlap resolution (%dx%d), the overlaps will be skewed.."),
+			*FString(__func__), __LINE__, ViewRect.Width(), ViewRect.Height(), Resolution.X, Resolution.Y);
+	}
+
+	OutViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	return true;
+}
+
+// Get the (cached) LOD0 geometry of the static mesh
+const FSLVisionMeshGeometry* USLVisionOverlapCalc::GetStaticMeshGeometry(UStaticMesh* StaticMesh)
+{
+	if (!StaticMesh)
+	{
+		return nullptr;
+	}
+	if (const FSLVisionMeshGeometry* CachedGeometry = StaticMeshGeometryCache.Find(StaticMesh))
+	{
+		return CachedGeometry;
+	}
+	if (!StaticMesh->RenderData || StaticMesh->RenderData->LODResources.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const FStaticMeshLODResources& LOD = StaticMesh->RenderData->LODResources[0];
+	FSLVisionMeshGeometry& Geometry = StaticMeshGeometryCache.Add(StaticMesh);
+	const uint32 NumVertices = LOD.VertexBuffers.PositionVertexBuffer.GetNumVertices();
+	Geometry.Positions.Reserve(NumVertices);
+	for (uint32 VertIdx = 0; VertIdx < NumVertices; ++VertIdx)
+	{
+		Geometry.Positions.Add(LOD.VertexBuffers.PositionVertexBuffer.VertexPosition(VertIdx));
+	}
+	LOD.IndexBuffer.GetCopy(Geometry.Indices);
+	return &Geometry;
+}
+
+// Get the currently skinned LOD0 geometry of the poseable mesh, returns the render data for the section lookup
+const FSkeletalMeshLODRenderData* USLVisionOverlapCalc::GetSkinnedGeometry(UPoseableMeshComponent* PMC, FSLVisionMeshGeometry& OutGeometry)
+{
+	FSkeletalMeshRenderData* RenderData = PMC->GetSkeletalMeshRenderData();
+	if (!RenderData || RenderData->LODRenderData.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const FSkeletalMeshLODRenderData& LODData = RenderData->LODRenderData[0];
+	PMC->CacheRefToLocalMatrices(CachedRefToLocals);
+	USkinnedMeshComponent::ComputeSkinnedPositions(PMC, OutGeometry.Positions, CachedRefToLocals, LODData, LODData.SkinWeightVertexBuffer);
+	LODData.MultiSizeIndexContainer.GetIndexBuffer(OutGeometry.Indices);
+	return &LODData;
+}
+
+// Rasterize the item and write its overlap results (thread safe, the buffer is owned by the calling task)
+void USLVisionOverlapCalc::RasterizeItem(const FSLVisionRasterItem& Item, FSLVisionRasterBuffer& Buffer) const
+{
+	const float ImgTotalPixels = Resolution.X * Resolution.Y;
+	const TArray<uint32>& Indices = Item.Geometry->Indices;
+	ProjectVertices(Item.Geometry->Positions, Item.LocalToClip, Buffer);
+
+	Buffer.CurrCoverageStamp++;
+	bool bIsClipped = false;
+	const int64 NumCovered = RasterizeTriangles(Indices, 0, Indices.Num(), Buffer, bIsClipped);
+	if (Item.Entity)
+	{
+		Item.Entity->OcclusionPercentage = GetOcclusionPercentage(NumCovered / ImgTotalPixels, Item.Entity->ImagePercentage);
+		Item.Entity->bIsClipped = bIsClipped;
+		return;
+	}
+
+	FSLVisionViewSkelData& SkelEntity = *Item.SkelEntity;
+	SkelEntity.OcclusionPercentage = GetOcclusionPercentage(NumCovered / ImgTotalPixels, SkelEntity.ImagePercentage);
+	SkelEntity.bIsClipped = bIsClipped;
+
+	// Bones are rasterized from the render sections using their material
+	for (int32 BoneIdx = 0; BoneIdx < SkelEntity.Bones.Num(); ++BoneIdx)
+	{
+		const int32 MaterialIndex = Item.BoneMaterialIndexes[BoneIdx];
+		if (MaterialIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		Buffer.CurrCoverageStamp++;
+		bool bIsBoneClipped = false;
+		int64 NumBoneCovered = 0;
+		for (const auto& Section : Item.LODData->RenderSections)
+		{
+			if (Section.MaterialIndex == MaterialIndex)
+			{
+				NumBoneCovered += RasterizeTriangles(Indices, Section.BaseIndex, Section.NumTriangles * 3, Buffer, bIsBoneClipped);
+			}
+		}
+		FSLVisionViewSkelBoneData& Bone = SkelEntity.Bones[BoneIdx];
+		Bone.OcclusionPercentage = GetOcclusionPercentage(NumBoneCovered / ImgTotalPixels, Bone.ImagePercentage);
+		Bone.bIsClipped = bIsBoneClipped;
+	}
+}
+
+// Project the vertex positions to clip space into the projection buffer
+void USLVisionOverlapCalc::ProjectVertices(const TArray<FVector>& Positions, const FMatrix& LocalToClip, FSLVisionRasterBuffer& Buffer)
+{
+	Buffer.ClipVertices.SetNumUninitialized(Positions.Num(), false);
+	for (int32 VertIdx = 0; VertIdx < Positions.Num(); ++VertIdx)
+	{
+		Buffer.ClipVertices[VertIdx] = LocalToClip.TransformFVector4(FVector4(Positions[VertIdx], 1.f));
+	}
+}
+
+// Rasterize the triangles of the projected vertices with the current coverage stamp, returns the number of newly covered pixels
+int64 USLVisionOverlapCalc::RasterizeTriangles(const TArray<uint32>& Indices, int32 FirstIndex, int32 NumIndices, FSLVisionRasterBuffer& Buffer, bool& bOutIsClipped) const
+{
+	int64 NumCovered = 0;
+	const int32 LastIndex = FMath::Min(FirstIndex + NumIndices, Indices.Num());
+	for (int32 Idx = FirstIndex; Idx + 2 < LastIndex; Idx += 3)
+	{
+		const FVector4 Triangle[3] = { Buffer.ClipVertices[Indices[Idx]], Buffer.ClipVertices[Indices[Idx + 1]], Buffer.ClipVertices[Indices[Idx + 2]] };
+
+		// Clip against the near plane (w > 0), results in a polygon of at most 4 vertices
+		FVector4 Polygon[4];
+		int32 NumPolygonVertices = 0;
+		for (int32 VertIdx = 0; VertIdx < 3; ++VertIdx)
+		{
+			const FVector4& Curr = Triangle[VertIdx];
+			const FVector4& Next = Triangle[(VertIdx + 1) % 3];
+			const float CurrDist = Curr.W - KINDA_SMALL_NUMBER;
+			const float NextDist = Next.W - KINDA_SMALL_NUMBER;
+			if (CurrDist >= 0.f)
+			{
+				Polygon[NumPolygonVertices++] = Curr;
+			}
+			if ((CurrDist >= 0.f) != (NextDist >= 0.f))
+			{
+				Polygon[NumPolygonVertices++] = Curr + (Next - Curr) * (CurrDist / (CurrDist - NextDist));
+			}
+		}
+		if (NumPolygonVertices < 3)
+		{
+			continue;
+		}
+
+		// Clip space to image space
+		FVector2D ScreenVertices[4];
+		for (int32 VertIdx = 0; VertIdx < NumPolygonVertices; ++VertIdx)
+		{
+			const float InvW = 1.f / Polygon[VertIdx].W;
+			ScreenVertices[VertIdx].X = (Polygon[VertIdx].X * InvW * 0.5f + 0.5f) * Resolution.X;
+			ScreenVertices[VertIdx].Y = (0.5f - Polygon[VertIdx].Y * InvW * 0.5f) * Resolution.Y;
+		}
+
+		// Triangle fan of the clipped polygon
+		for (int32 VertIdx = 1; VertIdx + 1 < NumPolygonVertices; ++VertIdx)
+		{
+			NumCovered += RasterizeTriangle(ScreenVertices[0], ScreenVertices[VertIdx], ScreenVertices[VertIdx + 1], Buffer, bOutIsClipped);
+		}
+	}
+	return NumCovered;
+}
+
+// Rasterize the screen space triangle with the current coverage stamp, returns the number of newly covered pixels
+int64 USLVisionOverlapCalc::RasterizeTriangle(const FVector2D& A, const FVector2D& B, const FVector2D& C, FSLVisionRasterBuffer& Buffer, bool& bOutIsClipped) const
+{
+	auto Edge = [](const FVector2D& P0, const FVector2D& P1, const FVector2D& P)
+	{
+		return (P1.X - P0.X) * (P.Y - P0.Y) - (P1.Y - P0.Y) * (P.X - P0.X);
+	};
+
+	// Ignore degenerate triangles, make the edge tests independent of the winding
+	const float Area = Edge(A, B, C);
+	if (FMath::IsNearlyZero(Area))
+	{
+		return 0;
+	}
+	const float Sign = Area > 0.f ? 1.f : -1.f;
+
+	// Bounding box of the triangle inside the image
+	const int32 MinX = FMath::Max(FMath::FloorToInt(FMath::Min3(A.X, B.X, C.X)), 0);
+	const int32 MaxX = FMath::Min(FMath::CeilToInt(FMath::Max3(A.X, B.X, C.X)), Resolution.X - 1);
+	const int32 MinY = FMath::Max(FMath::FloorToInt(FMath::Min3(A.Y, B.Y, C.Y)), 0);
+	const int32 MaxY = FMath::Min(FMath::CeilToInt(FMath::Max3(A.Y, B.Y, C.Y)), Resolution.Y - 1);
+
+	int64 NumCovered = 0;
+	for (int32 RowIdx = MinY; RowIdx <= MaxY; ++RowIdx)
+	{
+		for (int32 ColIdx = MinX; ColIdx <= MaxX; ++ColIdx)
+		{
+			// Sample at the pixel center
+			const FVector2D P(ColIdx + 0.5f, RowIdx + 0.5f);
+			if (Sign * Edge(B, C, P) >= 0.f && Sign * Edge(C, A, P) >= 0.f && Sign * Edge(A, B, P) >= 0.f)
+			{
+				int32& PixelStamp = Buffer.CoverageStamps[RowIdx * Resolution.X + ColIdx];
+				if (PixelStamp != Buffer.CurrCoverageStamp)
+				{
+					PixelStamp = Buffer.CurrCoverageStamp;
+					NumCovered++;
+
+					// Touches the edge of the image
+					if (ColIdx == 0 || ColIdx == Resolution.X - 1 || RowIdx == 0 || RowIdx == Resolution.Y - 1)
+					{
+						bOutIsClipped = true;
+					}
+				}
+			}
+		}
+	}
+	return NumCovered;
+}
+
+// Occlusion percentage from the non occluded and the visible image percentages
+float USLVisionOverlapCalc::GetOcclusionPercentage(float NonOccImgPerc, float ImgPerc)
+{
+	if (NonOccImgPerc <= 0.f)
+	{
+		return 0.f;
+	}
+
+	// (non occ image perc - occ image perc) / non occ image perc
+	const float OccPerc = (NonOccImgPerc - ImgPerc) / NonOccImgPerc;
+	return OccPerc < 0.01f ? 0.f : OccPerc;
+}
+
 // Output progress to terminal
 void USLVisionOverlapCalc::PrintProgress() const
 {
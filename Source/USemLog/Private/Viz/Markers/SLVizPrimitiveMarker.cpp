@@ -63,10 +63,24 @@ bool USLVizPrimitiveMarker::UpdateInstanceTransform(int32 Index, const FTransfor
 // Virtual add instances function
 void USLVizPrimitiveMarker::AddInstancesChecked(const TArray<FTransform>& Poses)
 {
-	for (auto P : Poses)
+	SetScaledPoses(Poses);
+	ISMC->AddInstances(ScaledPoses, false);
+}
+
+// Virtual batch update instances transforms
+bool USLVizPrimitiveMarker::BatchUpdateInstancesTransformsChecked(int32 StartIndex, const TArray<FTransform>& Poses, bool bMarkRenderStateDirty)
+{
+	SetScaledPoses(Poses);
+	return ISMC->BatchUpdateInstancesTransforms(StartIndex, ScaledPoses, true, bMarkRenderStateDirty, true);
+}
+
+// Copy the poses with the marker scale into the scaled poses buffer
+void USLVizPrimitiveMarker::SetScaledPoses(const TArray<FTransform>& Poses)
+{
+	ScaledPoses.Reset(Poses.Num());
+	for (const auto& P : Poses)
 	{
-		P.SetScale3D(MarkerScale);
-		ISMC->AddInstance(P);
+		ScaledPoses.Emplace(P.GetRotation(), P.GetLocation(), MarkerScale);
 	}
 }
 
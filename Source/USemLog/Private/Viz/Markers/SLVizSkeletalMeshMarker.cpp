@@ -5,6 +5,7 @@
 #include "Viz/SLVizAssets.h"
 #include "Components/PoseableMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
 #include "Materials/MaterialInstanceDynamic.h"
 
 // Constructor
@@ -14,6 +15,9 @@ USLVizSkeletalMeshMarker::USLVizSkeletalMeshMarker()
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 	PMCRef = nullptr;
+	bUseInstancePool = false;
+	TimelineMaxNumUpdatesPerTick = INDEX_NONE;
+	TimelineNumPendingUpdates = 0;
 }
 
 // Called every frame, used for timeline visualizations, activated and deactivated on request
@@ -25,26 +29,43 @@ void USLVizSkeletalMeshMarker::TickComponent(float DeltaTime, ELevelTick TickTyp
 	TimelineDeltaTime += DeltaTime;
 
 	// Calculate the number of instances to draw depending on the passed time
-	int32 NumInstancesToDraw = (TimelineDeltaTime * TimelinePoses.Num()) / TimelineDuration;
+	const int32 NumTimelinePoses = bUseInstancePool ? ResolvedTimelinePoses.Num() : TimelinePoses.Num();
+	int32 NumInstancesToDraw = (TimelineDeltaTime * NumTimelinePoses) / TimelineDuration;
+	if (NumInstancesToDraw > 0)
+	{
+		TimelineNumPendingUpdates += NumInstancesToDraw;
+
+		// Reset the elapsed time
+		TimelineDeltaTime = 0;
+	}
 
 	// Wait if not enough time has passed
-	if (NumInstancesToDraw == 0)
+	if (TimelineNumPendingUpdates == 0)
 	{
 		return;
 	}
 
+	// Limit the updates to the given budget, the remaining ones are deferred to the following ticks
+	int32 NumUpdates = TimelineNumPendingUpdates;
+	if (TimelineMaxNumUpdatesPerTick > 0 && NumUpdates > TimelineMaxNumUpdatesPerTick)
+	{
+		NumUpdates = TimelineMaxNumUpdatesPerTick;
+	}
+	TimelineNumPendingUpdates -= NumUpdates;
+
 	// Draw all instances, or use a limit
-	if (TimelineMaxNumInstances <= 0)
+	if (bUseInstancePool)
 	{
-		UpdateTimeline(NumInstancesToDraw);
+		UpdatePooledTimeline(NumUpdates);
+	}
+	else if (TimelineMaxNumInstances <= 0)
+	{
+		UpdateTimeline(NumUpdates);
 	}
 	else
 	{
-		UpdateTimelineWithMaxNumInstances(NumInstancesToDraw);
+		UpdateTimelineWithMaxNumInstances(NumUpdates);
 	}
-
-	// Reset the elapsed time
-	TimelineDeltaTime = 0;
 }
 
 // Set the visual properties of the skeletal mesh (use original materials)
@@ -204,9 +225,25 @@ void USLVizSkeletalMeshMarker::AddInstances(const TArray<TPair<FTransform, TMap<
 	}
 
 	// Set the timeline data
-	TimelinePoses = SkeletalPoses;
+	bUseInstancePool = TimelineParams.bUseInstancePool;
+	if (bUseInstancePool)
+	{
+		// The pooled instances are indexed as a ring, recycle any previous instances
+		ResetPoses();
+		ResolvedTimelinePoses.Reserve(SkeletalPoses.Num());
+		for (const auto& SkelPosePair : SkeletalPoses)
+		{
+			ResolvedTimelinePoses.Emplace(SkelPosePair);
+		}
+	}
+	else
+	{
+		TimelinePoses = SkeletalPoses;
+	}
 	TimelineDuration = TimelineParams.Duration;
 	TimelineMaxNumInstances = TimelineParams.MaxNumInstances;
+	TimelineMaxNumUpdatesPerTick = TimelineParams.MaxNumUpdatesPerTick;
+	TimelineNumPendingUpdates = 0;
 	bLoopTimeline = TimelineParams.bLoop;
 	TimelineIndex = 0;
 
@@ -229,6 +266,14 @@ void USLVizSkeletalMeshMarker::DestroyComponent(bool bPromoteChildren)
 		}
 	}
 
+	for (const auto& PMCInst : PMCPool)
+	{
+		if (PMCInst && PMCInst->IsValidLowLevel() && !PMCInst->IsPendingKillOrUnreachable())
+		{
+			PMCInst->DestroyComponent();
+		}
+	}
+
 	if (PMCRef && PMCRef->IsValidLowLevel() && !PMCRef->IsPendingKillOrUnreachable())
 	{
 		PMCRef->DestroyComponent();
@@ -264,7 +309,16 @@ void USLVizSkeletalMeshMarker::ResetPoses()
 	{
 		if (!PMC->IsPendingKillOrUnreachable())
 		{
-			PMC->DestroyComponent();
+			if (bUseInstancePool)
+			{
+				// Keep the instance for recycling
+				PMC->SetVisibility(false);
+				PMCPool.Add(PMC);
+			}
+			else
+			{
+				PMC->DestroyComponent();
+			}
 		}
 	}
 	PMCInstances.Empty();
@@ -378,8 +432,12 @@ void USLVizSkeletalMeshMarker::ClearAndStopTimeline()
 		SetComponentTickInterval(-1.f); // Tick every frame by default (If less than or equal to 0 then it will tick every frame)
 	}
 	TimelineMaxNumInstances = INDEX_NONE;
+	TimelineMaxNumUpdatesPerTick = INDEX_NONE;
+	TimelineNumPendingUpdates = 0;
 	TimelineIndex = INDEX_NONE;
 	TimelinePoses.Empty();
+	ResolvedTimelinePoses.Empty();
+	bUseInstancePool = false;
 }
 
 // Update timeline with the given number of new instances
@@ -480,6 +538,112 @@ void USLVizSkeletalMeshMarker::UpdateTimelineWithMaxNumInstances(int32 NumNewIns
 	}
 }
 
+// Update timeline by recycling the pooled instances
+void USLVizSkeletalMeshMarker::UpdatePooledTimeline(int32 NumNewInstances)
+{
+	// Number of simultaneously visible instances, the components are reused as a ring buffer
+	const int32 NumSlots = TimelineMaxNumInstances > 0 
+		? FMath::Min(TimelineMaxNumInstances, ResolvedTimelinePoses.Num()) : ResolvedTimelinePoses.Num();
+	const bool bInstancesCoverTimeline = NumSlots == ResolvedTimelinePoses.Num();
+
+	while (NumNewInstances > 0 && ResolvedTimelinePoses.IsValidIndex(TimelineIndex))
+	{
+		const int32 SlotIdx = TimelineIndex % NumSlots;
+		const bool bIsNewInstance = !PMCInstances.IsValidIndex(SlotIdx);
+		if (bIsNewInstance)
+		{
+			PMCInstances.Add(CreateNewPoseableMeshInstance());
+		}
+
+		// If there is an instance for every pose, these are already posed from the previous loops
+		UPoseableMeshComponent* PMC = PMCInstances[SlotIdx];
+		if (bIsNewInstance || !bInstancesCoverTimeline)
+		{
+			ApplyResolvedPose(PMC, ResolvedTimelinePoses[TimelineIndex]);
+		}
+		PMC->SetVisibility(true);
+
+		TimelineIndex++;
+		NumNewInstances--;
+	}
+
+	// Reached end of the poses array
+	if (!ResolvedTimelinePoses.IsValidIndex(TimelineIndex))
+	{
+		if (bLoopTimeline)
+		{
+			// Avoid destroying the instances
+			HideInstances();
+			TimelineIndex = 0;
+		}
+		else
+		{
+			ClearAndStopTimeline();
+		}
+	}
+}
+
+// Apply the resolved pose in a single pass over the bone hierarchy
+void USLVizSkeletalMeshMarker::ApplyResolvedPose(UPoseableMeshComponent* PMC, const FSLVizResolvedSkeletalPose& ResolvedPose)
+{
+	PMC->SetWorldTransform(ResolvedPose.Pose);
+	if (ResolvedPose.BonePoses.Num() == 0)
+	{
+		return;
+	}
+
+	// The resolved bone poses are sorted as well, the next one is the only candidate
+	int32 NextBonePoseIdx = 0;
+	ApplyWorldBonePoses(PMC, [&ResolvedPose, &NextBonePoseIdx](int32 BoneIdx, FTransform& OutWorldPose)
+	{
+		if (ResolvedPose.BonePoses.IsValidIndex(NextBonePoseIdx) && ResolvedPose.BonePoses[NextBonePoseIdx].Key == BoneIdx)
+		{
+			OutWorldPose = ResolvedPose.BonePoses[NextBonePoseIdx++].Value;
+			return true;
+		}
+		return false;
+	}, ComponentSpaceBonePoses);
+}
+
+// Convert the world bone poses to local poses in a single pass over the bone hierarchy (parents are sorted before their children),
+// bones without a world pose keep their local pose, the component space poses are written to the scratch buffer
+void USLVizSkeletalMeshMarker::ApplyWorldBonePoses(UPoseableMeshComponent* PMC, TFunctionRef<bool(int32 BoneIdx, FTransform& OutWorldPose)> GetWorldBonePose,
+	TArray<FTransform>& ComponentSpaceBonePosesScratch)
+{
+	if (!PMC->SkeletalMesh)
+	{
+		return;
+	}
+
+	const FReferenceSkeleton& RefSkeleton = PMC->SkeletalMesh->RefSkeleton;
+	TArray<FTransform>& LocalPoses = PMC->BoneSpaceTransforms;
+	const int32 NumBones = FMath::Min(LocalPoses.Num(), RefSkeleton.GetNum());
+	const FTransform& ComponentToWorld = PMC->GetComponentTransform();
+	ComponentSpaceBonePosesScratch.SetNumUninitialized(NumBones, false);
+
+	FTransform WorldPose;
+	for (int32 BoneIdx = 0; BoneIdx < NumBones; ++BoneIdx)
+	{
+		const int32 ParentIdx = RefSkeleton.GetParentIndex(BoneIdx);
+		if (GetWorldBonePose(BoneIdx, WorldPose))
+		{
+			ComponentSpaceBonePosesScratch[BoneIdx] = WorldPose.GetRelativeTransform(ComponentToWorld);
+			LocalPoses[BoneIdx] = ParentIdx != INDEX_NONE
+				? ComponentSpaceBonePosesScratch[BoneIdx].GetRelativeTransform(ComponentSpaceBonePosesScratch[ParentIdx])
+				: ComponentSpaceBonePosesScratch[BoneIdx];
+		}
+		else
+		{
+			ComponentSpaceBonePosesScratch[BoneIdx] = ParentIdx != INDEX_NONE
+				? LocalPoses[BoneIdx] * ComponentSpaceBonePosesScratch[ParentIdx]
+				: LocalPoses[BoneIdx];
+		}
+	}
+
+	// Send the new state to the render thread
+	PMC->MarkRefreshTransformDirty();
+}
+
 //   Set visual without the materials (avoid boilerplate code)
 void USLVizSkeletalMeshMarker::SetPoseableMeshComponentVisual(USkeletalMesh* SkelMesh)
 {
@@ -505,6 +669,25 @@ void USLVizSkeletalMeshMarker::SetPoseableMeshComponentVisual(USkeletalMesh* Ske
 // Create poseable mesh component instance attached and registered to this marker
 UPoseableMeshComponent* USLVizSkeletalMeshMarker::CreateNewPoseableMeshInstance()
 {
+	// Recycle a pooled instance if available
+	while (PMCPool.Num() > 0)
+	{
+		UPoseableMeshComponent* PooledPMC = PMCPool.Pop(false);
+		if (PooledPMC && PooledPMC->IsValidLowLevel() && !PooledPMC->IsPendingKillOrUnreachable())
+		{
+			if (PooledPMC->SkeletalMesh != PMCRef->SkeletalMesh)
+			{
+				PooledPMC->SetSkeletalMesh(PMCRef->SkeletalMesh);
+			}
+			for (int32 MatIdx = 0; MatIdx < PMCRef->GetNumMaterials(); ++MatIdx)
+			{
+				PooledPMC->SetMaterial(MatIdx, PMCRef->GetMaterial(MatIdx));
+			}
+			PooledPMC->SetVisibility(true);
+			return PooledPMC;
+		}
+	}
+
 	UPoseableMeshComponent* NewPMC = DuplicateObject<UPoseableMeshComponent>(PMCRef, this);
 	NewPMC->SetVisibility(true);
 	//NewPMC->AttachToComponent(this, FAttachmentTransformRules::KeepWorldTransform);
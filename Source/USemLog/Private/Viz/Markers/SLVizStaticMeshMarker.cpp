@@ -177,6 +177,23 @@ void USLVizStaticMeshMarker::AddInstances(const TArray<FTransform>& Poses,
 	SetComponentTickEnabled(true);
 }
 
+// Update the transforms of the consecutive instances starting from the given index
+bool USLVizStaticMeshMarker::BatchUpdateInstancesTransforms(int32 StartIndex, const TArray<FTransform>& Poses)
+{
+	if (!ISMC || !ISMC->IsValidLowLevel() || ISMC->IsPendingKillOrUnreachable())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Visual is not set.."), *FString(__FUNCTION__), __LINE__);
+		return false;
+	}
+	if (StartIndex < 0 || StartIndex + Poses.Num() > ISMC->GetInstanceCount())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d StartIndex=%d with %d poses is out of bounds (NumInstances=%d).."),
+			*FString(__FUNCTION__), __LINE__, StartIndex, Poses.Num(), ISMC->GetInstanceCount());
+		return false;
+	}
+	return BatchUpdateInstancesTransformsChecked(StartIndex, Poses);
+}
+
 /* Begin VizMarker interface */
 // Reset visuals and poses
 void USLVizStaticMeshMarker::Reset()
@@ -236,10 +253,14 @@ bool USLVizStaticMeshMarker::UpdateInstanceTransform(int32 Index, const FTransfo
 // Virtual add instances function
 void USLVizStaticMeshMarker::AddInstancesChecked(const TArray<FTransform>& Poses)
 {
-	for (const auto& P : Poses)
-	{
-		ISMC->AddInstance(P);
-	}
+	// Single render state update for all the instances
+	ISMC->AddInstances(Poses, false);
+}
+
+// Virtual batch update instances transforms
+bool USLVizStaticMeshMarker::BatchUpdateInstancesTransformsChecked(int32 StartIndex, const TArray<FTransform>& Poses, bool bMarkRenderStateDirty)
+{
+	return ISMC->BatchUpdateInstancesTransforms(StartIndex, Poses, true, bMarkRenderStateDirty, true);
 }
 
 // Reset the timeline related members
@@ -258,27 +279,19 @@ void USLVizStaticMeshMarker::ClearAndStopTimeline()
 // Update timeline with the given number of new instances
 void USLVizStaticMeshMarker::UpdateTimeline(int32 NumNewInstances)
 {
-	// Check if it is safe to draw all new instances
-	if (TimelineIndex + NumNewInstances < TimelinePoses.Num())
+	// Add the new instances in one batch (avoid overflowing the poses array)
+	const int32 NumToAdd = FMath::Min(NumNewInstances, TimelinePoses.Num() - TimelineIndex);
+	if (NumToAdd > 0)
 	{
-		// Safe to draw all new instances
-		while (NumNewInstances > 0)
-		{
-			AddInstanceChecked(TimelinePoses[TimelineIndex]);
-			TimelineIndex++;
-			NumNewInstances--;
-		}
+		TimelineBatchPoses.Reset();
+		TimelineBatchPoses.Append(TimelinePoses.GetData() + TimelineIndex, NumToAdd);
+		AddInstancesChecked(TimelineBatchPoses);
+		TimelineIndex += NumToAdd;
 	}
-	else
-	{
-		// Reached end of the poses array, add only remaining values
-		while (TimelinePoses.IsValidIndex(TimelineIndex))
-		{
-			AddInstanceChecked(TimelinePoses[TimelineIndex]);
-			TimelineIndex++;
-		}
 
-		// Check if the timeline should be repeated or stopped
+	// Reached end of the poses array, check if the timeline should be repeated or stopped
+	if (!TimelinePoses.IsValidIndex(TimelineIndex))
+	{
 		if (bLoopTimeline)
 		{
 			ISMC->ClearInstances();
@@ -294,43 +307,39 @@ void USLVizStaticMeshMarker::UpdateTimeline(int32 NumNewInstances)
 // Update timeline with max number of instances
 void USLVizStaticMeshMarker::UpdateTimelineWithMaxNumInstances(int32 NumNewInstances)
 {
-	// Check if it is safe to draw all new instances
-	if (TimelineIndex + NumNewInstances < TimelinePoses.Num())
+	// Avoid overflowing the poses array
+	const int32 EndIndex = FMath::Min(TimelineIndex + NumNewInstances, TimelinePoses.Num());
+
+	// Add new instances until the max number is reached
+	if (TimelineIndex < TimelineMaxNumInstances && TimelineIndex < EndIndex)
 	{
-		// Safe to draw all new instances
-		while (NumNewInstances > 0)
-		{
-			if (TimelineIndex < TimelineMaxNumInstances)
-			{
-				AddInstanceChecked(TimelinePoses[TimelineIndex]);
-			}
-			else
-			{
-				int32 UpdateIndex = TimelineIndex % TimelineMaxNumInstances;
-				UpdateInstanceTransform(UpdateIndex, TimelinePoses[TimelineIndex]);
-			}
-			TimelineIndex++;
-			NumNewInstances--;
-		}
+		const int32 NumToAdd = FMath::Min(EndIndex, TimelineMaxNumInstances) - TimelineIndex;
+		TimelineBatchPoses.Reset();
+		TimelineBatchPoses.Append(TimelinePoses.GetData() + TimelineIndex, NumToAdd);
+		AddInstancesChecked(TimelineBatchPoses);
+		TimelineIndex += NumToAdd;
 	}
-	else
+
+	// Recycle the oldest instances, batched in contiguous ranges (the range is split when wrapping around)
+	bool bInstancesUpdated = false;
+	while (TimelineIndex < EndIndex)
 	{
-		// Reached end of the poses array, add only remaining values
-		while (TimelinePoses.IsValidIndex(TimelineIndex))
-		{
-			if (TimelineIndex < TimelineMaxNumInstances)
-			{
-				AddInstanceChecked(TimelinePoses[TimelineIndex]);
-			}
-			else
-			{
-				int32 UpdateIndex = TimelineIndex % TimelineMaxNumInstances;
-				UpdateInstanceTransform(UpdateIndex, TimelinePoses[TimelineIndex]);
-			}
-			TimelineIndex++;
-		}
+		const int32 UpdateIndex = TimelineIndex % TimelineMaxNumInstances;
+		const int32 NumToUpdate = FMath::Min(EndIndex - TimelineIndex, TimelineMaxNumInstances - UpdateIndex);
+		TimelineBatchPoses.Reset();
+		TimelineBatchPoses.Append(TimelinePoses.GetData() + TimelineIndex, NumToUpdate);
+		BatchUpdateInstancesTransformsChecked(UpdateIndex, TimelineBatchPoses, false);
+		TimelineIndex += NumToUpdate;
+		bInstancesUpdated = true;
+	}
+	if (bInstancesUpdated)
+	{
+		ISMC->MarkRenderStateDirty();
+	}
 
-		// Check if the timeline should be repeated or stopped
+	// Reached end of the poses array, check if the timeline should be repeated or stopped
+	if (!TimelinePoses.IsValidIndex(TimelineIndex))
+	{
 		if (bLoopTimeline)
 		{
 			ISMC->ClearInstances();
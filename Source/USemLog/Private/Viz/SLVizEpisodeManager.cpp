@@ -4,6 +4,7 @@
 #include "Viz/SLVizEpisodeManager.h"
 #include "Viz/SLVizEpisodeUtils.h"
 #include "Components/PoseableMeshComponent.h"
+#include "Viz/Markers/SLVizSkeletalMeshMarker.h"
 
 // Sets default values
 ASLVizEpisodeManager::ASLVizEpisodeManager()
@@ -16,8 +17,12 @@ ASLVizEpisodeManager::ASLVizEpisodeManager()
 	bEpisodeLoaded = false;
 	bLoopReplay = false;
 	bReplayRunning = false;
+	bInterpolateReplay = false;
+	bActiveFrameBlended = false;
 
 	EpisodeDefaultUpdateRate = 0.f;
+	ReplayUpdateRate = 0.f;
+	ReplayTime = 0.f;
 	ActiveFrameIndex = INDEX_NONE;
 	ReplayFirstFrameIndex = INDEX_NONE;
 	ReplayLastFrameIndex = INDEX_NONE;
@@ -34,7 +39,8 @@ void ASLVizEpisodeManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (!ApplyNextFrameChanges())
+	const bool bHasMoreFrames = bInterpolateReplay ? ApplyInterpolatedFrameChanges(DeltaTime) : ApplyNextFrameChanges();
+	if (!bHasMoreFrames)
 	{
 		if (bLoopReplay)
 		{
@@ -109,6 +115,7 @@ void ASLVizEpisodeManager::ClearEpisode()
 	ActiveFrameIndex = INDEX_NONE;
 	ReplayFirstFrameIndex = INDEX_NONE;
 	ReplayLastFrameIndex = INDEX_NONE;
+	ReplayTime = 0.f;
 	bEpisodeLoaded = false;
 	bReplayRunning = false;
 	SetActorTickEnabled(false);
@@ -135,8 +142,21 @@ bool ASLVizEpisodeManager::GotoFrame(int32 FrameIndex)
 		return false;
 	}
 
+	// Small jumps only apply the changes from the active frame, otherwise the full frame
+	if (!bActiveFrameBlended
+		&& EpisodeData.CompactFrames.Num() == EpisodeData.FullFrames.Num()
+		&& EpisodeData.FullFrames.IsValidIndex(ActiveFrameIndex)
+		&& FMath::Abs(FrameIndex - ActiveFrameIndex) <= MaxIncrementalSeekNumFrames)
+	{
+		ApplyFrameChanges(ActiveFrameIndex, FrameIndex);
+	}
+	else
+	{
+		ApplyPoses(EpisodeData.FullFrames[FrameIndex]);
+	}
 	ActiveFrameIndex = FrameIndex;
-	ApplyPoses(EpisodeData.FullFrames[FrameIndex]);
+	ReplayTime = EpisodeData.Timestamps[FrameIndex];
+	bActiveFrameBlended = false;
 
 	//UE_LOG(LogTemp, Log, TEXT("%s::%d Applied poses from frame %d.."), *FString(__FUNCTION__), __LINE__, ActiveFrameIndex);
 	return true;
@@ -145,7 +165,7 @@ bool ASLVizEpisodeManager::GotoFrame(int32 FrameIndex)
 // Set visual world as in the given timestamp (binary search for nearest index)
 bool ASLVizEpisodeManager::GotoFrame(float Timestamp)
 {
-	return GotoFrame(FSLVizEpisodeUtils::BinarySearchLessEqual(EpisodeData.Timestamps, Timestamp));
+	return GotoFrame(FindFrameIndexFromActiveFrame(Timestamp));
 }
 
 // Play episode with the given parameters
@@ -178,6 +198,9 @@ bool ASLVizEpisodeManager::Play(const FSLVizEpisodePlayParams& PlayParams)
 	// Should the replay be looped
 	bLoopReplay = PlayParams.bLoop;
 
+	// Should the poses be interpolated between the frames
+	bInterpolateReplay = PlayParams.bInterpolate;
+
 	// Goto first frame
 	GotoFrame(ReplayFirstFrameIndex);
 
@@ -209,9 +232,8 @@ bool ASLVizEpisodeManager::PlayEpisode()
 	// Goto first frame
 	GotoFrame(ReplayFirstFrameIndex);
 
-	// Enable tick with the given update rate
-	SetActorTickEnabled(true);
-	bReplayRunning = true;
+	// Start playing the frames
+	StartReplay();
 
 	return true;
 }
@@ -231,9 +253,8 @@ bool ASLVizEpisodeManager::PlayFrames(int32 FirstFrame, int32 LastFrame)
 	// Goto first frame
 	GotoFrame(ReplayFirstFrameIndex);
 
-	// Enable tick with the preconfigured update rate	
-	SetActorTickEnabled(true);
-	bReplayRunning = true;
+	// Start playing the frames
+	StartReplay();
 
 	return true;
 }
@@ -252,9 +273,11 @@ bool ASLVizEpisodeManager::PlayTimeline(float StartTime, float EndTime)
 }
 
 // Set replay parameters
-void ASLVizEpisodeManager::SetReplayParams(bool bLoop, float UpdateRate, int32 StepSize)
+void ASLVizEpisodeManager::SetReplayParams(bool bLoop, float UpdateRate, int32 StepSize, bool bInterpolate)
 {
 	bLoopReplay = bLoop;
+	bInterpolateReplay = bInterpolate;
+	ReplayUpdateRate = UpdateRate;
 	UpdateRate > 0.f ? SetActorTickInterval(UpdateRate) : SetActorTickInterval(EpisodeDefaultUpdateRate);
 }
 
@@ -481,7 +504,14 @@ bool ASLVizEpisodeManager::ApplyNextFrameChanges()
 		if (EpisodeData.FullFrames.IsValidIndex(ActiveFrameIndex))
 		{
 			//ApplyPoses(EpisodeData.CompactFrames[ActiveFrameIndex]);
-			ApplyPoses(EpisodeData.FullFrames[ActiveFrameIndex]);
+			if (EpisodeData.CompactFrames.IsValidIndex(ActiveFrameIndex))
+			{
+				ApplyFrameChanges(ActiveFrameIndex - 1, ActiveFrameIndex);
+			}
+			else
+			{
+				ApplyPoses(EpisodeData.FullFrames[ActiveFrameIndex]);
+			}
 			return true;
 		}
 		else
@@ -496,12 +526,56 @@ bool ASLVizEpisodeManager::ApplyNextFrameChanges()
 	return false;	
 }
 
+// Advance the replay time and apply the interpolated poses
+bool ASLVizEpisodeManager::ApplyInterpolatedFrameChanges(float DeltaTime)
+{
+	const int32 LastFrameIndex = FMath::Min(ReplayLastFrameIndex, EpisodeData.Timestamps.Num() - 1);
+	if (ActiveFrameIndex < 0 || ActiveFrameIndex >= LastFrameIndex)
+	{
+		return false;
+	}
+
+	// Move the active frame to the one bracketing the replay time from below
+	ReplayTime += DeltaTime;
+	while (ActiveFrameIndex < LastFrameIndex && EpisodeData.Timestamps[ActiveFrameIndex + 1] <= ReplayTime)
+	{
+		ActiveFrameIndex++;
+	}
+
+	// Reached the end of the replay, apply the last frame as it is
+	if (ActiveFrameIndex >= LastFrameIndex)
+	{
+		ApplyPoses(EpisodeData.FullFrames[LastFrameIndex]);
+		bActiveFrameBlended = false;
+		return false;
+	}
+
+	const float FrameStartTime = EpisodeData.Timestamps[ActiveFrameIndex];
+	const float FrameDuration = EpisodeData.Timestamps[ActiveFrameIndex + 1] - FrameStartTime;
+	const float Alpha = FrameDuration > KINDA_SMALL_NUMBER ? (ReplayTime - FrameStartTime) / FrameDuration : 0.f;
+	ApplyInterpolatedPoses(EpisodeData.FullFrames[ActiveFrameIndex], EpisodeData.FullFrames[ActiveFrameIndex + 1],
+		FMath::Clamp(Alpha, 0.f, 1.f));
+	bActiveFrameBlended = true;
+	return true;
+}
+
 // Start replay
 void ASLVizEpisodeManager::StartReplay()
 {
+	// Interpolated replays are evaluated every render tick, otherwise restore the replay update rate
+	if (bInterpolateReplay)
+	{
+		SetActorTickInterval(0.f);
+	}
+	else
+	{
+		SetActorTickInterval(ReplayUpdateRate > 0.f ? ReplayUpdateRate : EpisodeDefaultUpdateRate);
+	}
+
 	// Enable tick with the given update rate
 	SetActorTickEnabled(true);
-	bReplayRunning = true;}
+	bReplayRunning = true;
+}
 
 // Apply frame poses
 void ASLVizEpisodeManager::ApplyPoses(const FSLVizEpisodeFrameData& Frame)
@@ -525,6 +599,147 @@ void ASLVizEpisodeManager::ApplyPoses(const FSLVizEpisodeFrameData& Frame)
 	}
 }
 
+// Apply only the poses which changed between the two frames (works in both directions)
+void ASLVizEpisodeManager::ApplyFrameChanges(int32 FromFrameIndex, int32 ToFrameIndex)
+{
+	// Every entry changed in the compact frames between the two indexes needs to be set to its target frame value
+	ChangedActors.Reset();
+	ChangedPMCs.Reset();
+	const int32 FirstChangedFrameIndex = FMath::Min(FromFrameIndex, ToFrameIndex) + 1;
+	const int32 LastChangedFrameIndex = FMath::Max(FromFrameIndex, ToFrameIndex);
+	for (int32 FrameIdx = FirstChangedFrameIndex; FrameIdx <= LastChangedFrameIndex; ++FrameIdx)
+	{
+		const FSLVizEpisodeFrameData& CompactFrame = EpisodeData.CompactFrames[FrameIdx];
+		for (const auto& ActorPosePair : CompactFrame.ActorPoses)
+		{
+			ChangedActors.Add(ActorPosePair.Key);
+		}
+		for (const auto& PMCBonePosesPair : CompactFrame.BonePoses)
+		{
+			ChangedPMCs.Add(PMCBonePosesPair.Key);
+		}
+	}
+
+	const FSLVizEpisodeFrameData& TargetFrame = EpisodeData.FullFrames[ToFrameIndex];
+	for (const auto& Actor : ChangedActors)
+	{
+		if (const FTransform* Pose = TargetFrame.ActorPoses.Find(Actor))
+		{
+			Actor->SetActorTransform(*Pose);
+		}
+	}
+
+	// Bone poses are in world space, they need to be re-applied if the owner moved as well
+	for (const auto& PMCBonePosesPair : TargetFrame.BonePoses)
+	{
+		UPoseableMeshComponent* PMC = PMCBonePosesPair.Key;
+		if (ChangedPMCs.Contains(PMC) || ChangedActors.Contains(PMC->GetOwner()))
+		{
+			ApplyBonePoses(PMC, PMCBonePosesPair.Value);
+		}
+	}
+}
+
+// Apply the bone poses of the poseable mesh component
+void ASLVizEpisodeManager::ApplyBonePoses(UPoseableMeshComponent* PMC, const TMap<int32, FTransform>& BonePoses)
+{
+	// Repeat to make sure the child bones are set after their parents
+	for (int32 Idx = 0; Idx < 5; Idx++)
+	{
+		for (const auto& BoneIndexPosePair : BonePoses)
+		{
+			const FName BoneName = PMC->GetBoneName(BoneIndexPosePair.Key);
+			PMC->SetBoneTransformByName(BoneName, BoneIndexPosePair.Value, EBoneSpaces::WorldSpace);
+		}
+	}
+}
+
+// Find the frame index of the timestamp by stepping from the active frame (binary search for large jumps)
+int32 ASLVizEpisodeManager::FindFrameIndexFromActiveFrame(float Timestamp) const
+{
+	const TArray<float>& Timestamps = EpisodeData.Timestamps;
+	if (!Timestamps.IsValidIndex(ActiveFrameIndex))
+	{
+		return FSLVizEpisodeUtils::BinarySearchLessEqual(Timestamps, Timestamp);
+	}
+
+	int32 FrameIndex = ActiveFrameIndex;
+	int32 NumSteps = 0;
+	if (Timestamps[FrameIndex] <= Timestamp)
+	{
+		// Step forward until the next frame is past the timestamp
+		while (FrameIndex < Timestamps.Num() - 1 && Timestamps[FrameIndex + 1] <= Timestamp)
+		{
+			FrameIndex++;
+			if (++NumSteps > MaxIncrementalSeekNumFrames)
+			{
+				return FSLVizEpisodeUtils::BinarySearchLessEqual(Timestamps, Timestamp);
+			}
+		}
+	}
+	else
+	{
+		// Step backward until the frame is not past the timestamp
+		while (FrameIndex > 0 && Timestamps[FrameIndex] > Timestamp)
+		{
+			FrameIndex--;
+			if (++NumSteps > MaxIncrementalSeekNumFrames)
+			{
+				return FSLVizEpisodeUtils::BinarySearchLessEqual(Timestamps, Timestamp);
+			}
+		}
+	}
+	return FrameIndex;
+}
+
+// Apply the blended poses between the two frames
+void ASLVizEpisodeManager::ApplyInterpolatedPoses(const FSLVizEpisodeFrameData& FrameA, const FSLVizEpisodeFrameData& FrameB, float Alpha)
+{
+	FTransform BlendedPose;
+	for (const auto& ActorPosePair : FrameA.ActorPoses)
+	{
+		AActor* Actor = ActorPosePair.Key;
+		const FTransform* NextPose = FrameB.ActorPoses.Find(Actor);
+		if (NextPose && !ActorPosePair.Value.Equals(*NextPose))
+		{
+			// Lerp for location and scale, slerp for rotation
+			BlendedPose.Blend(ActorPosePair.Value, *NextPose, Alpha);
+			Actor->SetActorTransform(BlendedPose);
+		}
+		else if (!Actor->GetActorTransform().Equals(ActorPosePair.Value))
+		{
+			// Static between the two frames, only set once if it is still at a blended pose of the previous frames
+			Actor->SetActorTransform(ActorPosePair.Value);
+		}
+	}
+
+	// The blended world poses are converted to local poses in one pass over the bone hierarchy
+	for (const auto& PMCBonePosesPair : FrameA.BonePoses)
+	{
+		const TMap<int32, FTransform>& BonePoses = PMCBonePosesPair.Value;
+		const TMap<int32, FTransform>* NextBonePoses = FrameB.BonePoses.Find(PMCBonePosesPair.Key);
+		USLVizSkeletalMeshMarker::ApplyWorldBonePoses(PMCBonePosesPair.Key,
+			[&BonePoses, NextBonePoses, Alpha](int32 BoneIdx, FTransform& OutWorldPose)
+		{
+			const FTransform* Pose = BonePoses.Find(BoneIdx);
+			if (!Pose)
+			{
+				return false;
+			}
+			const FTransform* NextPose = NextBonePoses ? NextBonePoses->Find(BoneIdx) : nullptr;
+			if (NextPose)
+			{
+				OutWorldPose.Blend(*Pose, *NextPose, Alpha);
+			}
+			else
+			{
+				OutWorldPose = *Pose;
+			}
+			return true;
+		}, ComponentSpaceBonePoses);
+	}
+}
+
 // Calculate an approximation of the update rate value to coincide with realtime
 void ASLVizEpisodeManager::CalcRealtimeAproxUpdateRateValue(int32 MaxNumSteps)
 {
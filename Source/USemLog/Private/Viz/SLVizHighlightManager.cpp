@@ -94,6 +94,7 @@ void ASLVizHighlightManager::OnWorldCleanup(UWorld* World, bool bSessionEnded, b
 void ASLVizHighlightManager::RestoreOriginalMaterials()
 {
 	ClearAllHighlights();
+	ClearMIDPool();
 	RemoveDelegates();
 }
 
@@ -101,25 +102,34 @@ void ASLVizHighlightManager::RestoreOriginalMaterials()
 // Highlight a static mesh
 void ASLVizHighlightManager::Highlight(UMeshComponent* MC, const FSLVizVisualParams& VisualParams)
 {
-	// Cache the original materials
-	HighlightedStaticMeshes.Add(MC, FSLVizHighlightData(MC->GetMaterials(), VisualParams.MaterialSlots));
-
-	UMaterialInstanceDynamic* DynMat = CreateTransientMID(VisualParams.MaterialType);
-	DynMat->SetVectorParameterValue(FName("Color"), VisualParams.Color);
-	
-	if (VisualParams.MaterialSlots.Num() > 0)
+	// Release the material of a previous highlight
+	if (FSLVizHighlightData* PrevHighlightData = HighlightedStaticMeshes.Find(MC))
 	{
-		for (int32 MatIdx : VisualParams.MaterialSlots)
-		{
-			MC->SetMaterial(MatIdx, DynMat);
-		}
+		ReleasePooledMID(PrevHighlightData->MID);
 	}
-	else
+
+	// Cache the original materials
+	UMaterialInstanceDynamic* DynMat = AcquirePooledMID(VisualParams.MaterialType, VisualParams.Color);
+	HighlightedStaticMeshes.Add(MC, FSLVizHighlightData(MC->GetMaterials(), VisualParams.MaterialSlots, DynMat));
+	ApplyMaterial(MC, DynMat, VisualParams.MaterialSlots);
+}
+
+// Highlight the given mesh components with the same visual parameters
+void ASLVizHighlightManager::Highlight(const TArray<UMeshComponent*>& MCs, const FSLVizVisualParams& VisualParams)
+{
+	UMaterialInstanceDynamic* DynMat = AcquirePooledMID(VisualParams.MaterialType, VisualParams.Color, MCs.Num());
+	HighlightedStaticMeshes.Reserve(HighlightedStaticMeshes.Num() + MCs.Num());
+	for (const auto& MC : MCs)
 	{
-		for (int32 MatIdx = 0; MatIdx < MC->GetNumMaterials(); ++MatIdx)
+		// Release the material of a previous highlight
+		if (FSLVizHighlightData* PrevHighlightData = HighlightedStaticMeshes.Find(MC))
 		{
-			MC->SetMaterial(MatIdx, DynMat);
+			ReleasePooledMID(PrevHighlightData->MID);
 		}
+
+		// Cache the original materials
+		HighlightedStaticMeshes.Add(MC, FSLVizHighlightData(MC->GetMaterials(), VisualParams.MaterialSlots, DynMat));
+		ApplyMaterial(MC, DynMat, VisualParams.MaterialSlots);
 	}
 }
 
@@ -128,23 +138,10 @@ void ASLVizHighlightManager::UpdateHighlight(UMeshComponent* MC, const FSLVizVis
 {
 	if (auto HighlightData = HighlightedStaticMeshes.Find(MC))
 	{
-		UMaterialInstanceDynamic* DynMat = CreateTransientMID(VisualParams.MaterialType);
-		DynMat->SetVectorParameterValue(FName("Color"), VisualParams.Color);
-
-		if (HighlightData->MaterialSlots.Num() > 0)
-		{
-			for (int32 MatIdx : HighlightData->MaterialSlots)
-			{
-				MC->SetMaterial(MatIdx, DynMat);
-			}
-		}
-		else
-		{
-			for (int32 MatIdx = 0; MatIdx < MC->GetNumMaterials(); ++MatIdx)
-			{
-				MC->SetMaterial(MatIdx, DynMat);
-			}
-		}
+		UMaterialInstanceDynamic* DynMat = AcquirePooledMID(VisualParams.MaterialType, VisualParams.Color);
+		ReleasePooledMID(HighlightData->MID);
+		HighlightData->MID = DynMat;
+		ApplyMaterial(MC, DynMat, HighlightData->MaterialSlots);
 	}
 }
 
@@ -154,6 +151,7 @@ void ASLVizHighlightManager::ClearHighlight(UMeshComponent* MC)
 	FSLVizHighlightData HighlightData;
 	if (HighlightedStaticMeshes.RemoveAndCopyValue(MC, HighlightData))
 	{
+		ReleasePooledMID(HighlightData.MID);
 		if (HighlightData.MaterialSlots.Num() > 0)
 		{
 			for (int32 MatIdx : HighlightData.MaterialSlots)
@@ -182,6 +180,9 @@ void ASLVizHighlightManager::ClearAllHighlights()
 		}
 	}
 	HighlightedStaticMeshes.Empty();
+
+	// No highlights are using the pooled materials anymore
+	ClearMIDPool();
 }
 
 // Bind delegates
@@ -209,21 +210,93 @@ void ASLVizHighlightManager::RemoveDelegates()
 }
 
 
-// Create a dynamic material instance
-UMaterialInstanceDynamic* ASLVizHighlightManager::CreateTransientMID(ESLVizMaterialType InMaterialType)
+// Get the base material of the given material type
+UMaterialInterface* ASLVizHighlightManager::GetBaseMaterial(ESLVizMaterialType InMaterialType) const
 {
 	switch (InMaterialType)
 	{
 	case(ESLVizMaterialType::Additive):
-		return UMaterialInstanceDynamic::Create(VizAssetsContainer->MaterialHighlightAdditive, nullptr);
+		return VizAssetsContainer->MaterialHighlightAdditive;
 	case(ESLVizMaterialType::Translucent):
-		return UMaterialInstanceDynamic::Create(VizAssetsContainer->MaterialHighlightTranslucent, nullptr);
+		return VizAssetsContainer->MaterialHighlightTranslucent;
 	case(ESLVizMaterialType::Lit):
-		return UMaterialInstanceDynamic::Create(VizAssetsContainer->MaterialLit, nullptr);
+		return VizAssetsContainer->MaterialLit;
 	case(ESLVizMaterialType::Unlit):
-		return UMaterialInstanceDynamic::Create(VizAssetsContainer->MaterialUnlit, nullptr);
+		return VizAssetsContainer->MaterialUnlit;
 	default:
-		return UMaterialInstanceDynamic::Create(VizAssetsContainer->MaterialHighlightAdditive, nullptr);
+		return VizAssetsContainer->MaterialHighlightAdditive;
 	}
 	return nullptr;
-}
\ No newline at end of file
+}
+
+// Get a pooled dynamic material instance with the given type and color (create it if not available), adds the users to it
+UMaterialInstanceDynamic* ASLVizHighlightManager::AcquirePooledMID(ESLVizMaterialType InMaterialType, const FLinearColor& InColor, int32 NumUsers)
+{
+	UMaterialInterface* BaseMaterial = GetBaseMaterial(InMaterialType);
+	const FSLVizHighlightMIDKey Key(BaseMaterial, InColor);
+	if (FSLVizPooledMID* PooledMID = MIDPool.Find(Key))
+	{
+		if (PooledMID->MID && PooledMID->MID->IsValidLowLevel() && !PooledMID->MID->IsPendingKillOrUnreachable())
+		{
+			PooledMID->NumUsers += NumUsers;
+			return PooledMID->MID;
+		}
+		PooledMIDs.RemoveSingleSwap(PooledMID->MID);
+	}
+
+	// The instances are shared between meshes, their parameters should not be changed after creation
+	UMaterialInstanceDynamic* DynMat = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+	DynMat->SetVectorParameterValue(FName("Color"), InColor);
+	MIDPool.Add(Key, FSLVizPooledMID(DynMat)).NumUsers = NumUsers;
+	PooledMIDs.Add(DynMat);
+	return DynMat;
+}
+
+// Remove a user from the pooled dynamic material instance, the instance leaves the pool once it has no users
+void ASLVizHighlightManager::ReleasePooledMID(UMaterialInstanceDynamic* MID)
+{
+	if (!MID)
+	{
+		return;
+	}
+
+	// The pool only holds the distinct highlight colors in use
+	for (auto PoolItr = MIDPool.CreateIterator(); PoolItr; ++PoolItr)
+	{
+		if (PoolItr->Value.MID == MID)
+		{
+			if (--PoolItr->Value.NumUsers <= 0)
+			{
+				PooledMIDs.RemoveSingleSwap(MID);
+				PoolItr.RemoveCurrent();
+			}
+			return;
+		}
+	}
+}
+
+// Apply the material to the given slots of the mesh (if empty, apply to all slots)
+void ASLVizHighlightManager::ApplyMaterial(UMeshComponent* MC, UMaterialInterface* Material, const TArray<int32>& MaterialSlots)
+{
+	if (MaterialSlots.Num() > 0)
+	{
+		for (int32 MatIdx : MaterialSlots)
+		{
+			MC->SetMaterial(MatIdx, Material);
+		}
+	}
+	else
+	{
+		for (int32 MatIdx = 0; MatIdx < MC->GetNumMaterials(); ++MatIdx)
+		{
+			MC->SetMaterial(MatIdx, Material);
+		}
+	}
+}
+
+// Remove the pooled dynamic materials
+void ASLVizHighlightManager::ClearMIDPool()
+{
+	MIDPool.Empty();
+	PooledMIDs.Empty();
+}
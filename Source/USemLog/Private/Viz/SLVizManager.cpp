@@ -194,6 +194,53 @@ bool ASLVizManager::HighlightIndividual(const FString& Id, const FLinearColor& C
 	return false;
 }
 
+// Highlight the individuals in one batch (returns false if any of the individuals could not be highlighted)
+bool ASLVizManager::HighlightIndividuals(const TArray<FString>& Ids, const FLinearColor& Color, ESLVizMaterialType MaterialType)
+{
+	if (!bIsInit)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d %s is not initialized, call init first.."), *FString(__FUNCTION__), __LINE__, *GetName());
+		return false;
+	}
+
+	// Whole meshes are highlighted in one call, bones (material slots) and already highlighted ones are handled individually
+	TArray<UMeshComponent*> MeshesToHighlight;
+	MeshesToHighlight.Reserve(Ids.Num());
+	bool bAllHighlighted = true;
+	for (const auto& Id : Ids)
+	{
+		if (HighlightedIndividuals.Contains(Id))
+		{
+			bAllHighlighted &= HighlightIndividual(Id, Color, MaterialType);
+			continue;
+		}
+
+		USLBaseIndividual* Individual = IndividualManager->GetIndividual(Id);
+		if (auto RI = Cast<USLRigidIndividual>(Individual))
+		{
+			UMeshComponent* MC = RI->GetStaticMeshComponent();
+			MeshesToHighlight.Add(MC);
+			HighlightedIndividuals.Add(Id, FSLVizIndividualHighlightData(MC));
+		}
+		else if (auto SkI = Cast<USLSkeletalIndividual>(Individual))
+		{
+			UMeshComponent* MC = SkI->GetVisibleMeshComponent();
+			MeshesToHighlight.Add(MC);
+			HighlightedIndividuals.Add(Id, FSLVizIndividualHighlightData(MC));
+		}
+		else
+		{
+			bAllHighlighted &= HighlightIndividual(Id, Color, MaterialType);
+		}
+	}
+
+	if (MeshesToHighlight.Num() > 0)
+	{
+		HighlightManager->Highlight(MeshesToHighlight, FSLVizVisualParams(Color, MaterialType));
+	}
+	return bAllHighlighted;
+}
+
 // Change the visual values of the highligted individual
 bool ASLVizManager::UpdateIndividualHighlight(const FString& Id, const FLinearColor& Color, ESLVizMaterialType MaterialType)
 {
@@ -238,6 +285,23 @@ bool ASLVizManager::RemoveIndividualHighlight(const FString& Id)
 	}
 }
 
+// Remove highlights from the individuals (returns false if any of the individuals is not highlighted)
+bool ASLVizManager::RemoveIndividualHighlights(const TArray<FString>& Ids)
+{
+	if (!bIsInit)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d %s is not initialized, call init first.."), *FString(__FUNCTION__), __LINE__, *GetName());
+		return false;
+	}
+
+	bool bAllRemoved = true;
+	for (const auto& Id : Ids)
+	{
+		bAllRemoved &= RemoveIndividualHighlight(Id);
+	}
+	return bAllRemoved;
+}
+
 // Remove all individual highlights
 void ASLVizManager::RemoveAllIndividualHighlights()
 {
@@ -996,7 +1060,7 @@ bool ASLVizManager::PlayEpisode(FSLVizEpisodePlayParams PlayParams)
 		UE_LOG(LogTemp, Warning, TEXT("%s::%d %s is not initialized, call init first.."), *FString(__FUNCTION__), __LINE__, *GetName());
 		return false;
 	}
-	EpisodeManager->SetReplayParams(PlayParams.bLoop, PlayParams.UpdateRate, PlayParams.StepSize);
+	EpisodeManager->SetReplayParams(PlayParams.bLoop, PlayParams.UpdateRate, PlayParams.StepSize, PlayParams.bInterpolate);
 	if (PlayParams.StartTime < 0.f && PlayParams.EndTime < 0.f)
 	{
 		return EpisodeManager->PlayEpisode();
@@ -1015,7 +1079,7 @@ bool ASLVizManager::PlayEpisodeTimeline(float StartTime, float EndTime, FSLVizEp
 		UE_LOG(LogTemp, Warning, TEXT("%s::%d %s is not initialized, call init first.."), *FString(__FUNCTION__), __LINE__, *GetName());
 		return false;
 	}
-	EpisodeManager->SetReplayParams(PlayParams.bLoop, PlayParams.UpdateRate, PlayParams.StepSize);
+	EpisodeManager->SetReplayParams(PlayParams.bLoop, PlayParams.UpdateRate, PlayParams.StepSize, PlayParams.bInterpolate);
 	return EpisodeManager->PlayTimeline(StartTime, EndTime);
 }
 
@@ -90,16 +90,10 @@ void USLVizQHighlight::ExecuteImpl(ASLKnowrobManager* KRManager)
 	}
 	else if (bRemoveSelected)
 	{
-		for (const auto& Id : Ids)
-		{
-			VizManager->RemoveIndividualHighlight(Id);
-		}
+		VizManager->RemoveIndividualHighlights(Ids);
 	}
 	else
 	{
-		for (const auto& Id : Ids)
-		{
-			VizManager->HighlightIndividual(Id, Color, MaterialType);
-		}
+		VizManager->HighlightIndividuals(Ids, Color, MaterialType);
 	}
 }
@@ -67,6 +67,7 @@ void USLVizQReplay::ExecuteImpl(ASLKnowrobManager* KRManager)
 		Params.bLoop = bLoop;
 		Params.UpdateRate = UpdateRate;
 		Params.StepSize = StepSize;
+		Params.bInterpolate = bInterpolate;
 		VizManager->ReplayCachedEpisode(Episode, Params);
 	}
 }